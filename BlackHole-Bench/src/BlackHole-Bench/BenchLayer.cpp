@@ -0,0 +1,191 @@
+#include "BlackHole-Bench/BenchLayer.h"
+
+// Path time advances by a fixed step per frame, so every run renders the same views whatever the frame rate
+static constexpr float s_PathTimeStep = 1.0f / 60.0f;
+
+namespace Utils
+{
+    static void WriteDistribution(std::ostream& stream, std::string_view name, const FrameMetricSummary& distribution)
+    {
+        stream << "    \"" << name << "\": { "
+            << "\"min\": " << distribution.Min << ", "
+            << "\"mean\": " << distribution.Mean << ", "
+            << "\"p50\": " << distribution.P50 << ", "
+            << "\"p90\": " << distribution.P90 << ", "
+            << "\"p95\": " << distribution.P95 << ", "
+            << "\"p99\": " << distribution.P99 << ", "
+            << "\"max\": " << distribution.Max << " }";
+    }
+
+    static std::string EscapeJson(std::string_view str)
+    {
+        std::string result;
+        result.reserve(str.size());
+        for (const char c : str)
+        {
+            if (c == '"' || c == '\\')
+                result += '\\';
+            if (static_cast<unsigned char>(c) >= 0x20)
+                result += c;
+        }
+        return result;
+    }
+}
+
+BenchLayer::BenchLayer(const BenchSpecification& specification)
+    : Layer("BenchLayer")
+    , m_Specification(specification)
+    , m_Camera(45.0f, static_cast<float>(specification.Width) / static_cast<float>(specification.Height), 0.1f, 100.0f)
+{
+}
+
+void BenchLayer::OnAttach()
+{
+    BH_PROFILE_FUNCTION();
+
+    // Frames must not wait for a display that nobody is looking at
+    Application::Get().GetWindow().SetVSync(false);
+
+    m_Model = CreateRef<Model>(Filesystem::GetModelsPath() / m_Specification.ModelPath);
+
+    if (m_Specification.CameraPath.empty() || !m_CameraPath.Load(m_Specification.CameraPath))
+    {
+        if (!m_Specification.CameraPath.empty())
+            BH_LOG_WARN("Falling back to an orbit camera path");
+        m_CameraPath = CameraPath::CreateOrbit(glm::vec3(0.0f), 3.0f, 1.0f, 10.0f);
+    }
+
+    FramebufferSpecification framebufferSpec;
+    framebufferSpec.Width = m_Specification.Width;
+    framebufferSpec.Height = m_Specification.Height;
+    framebufferSpec.Samples = m_Specification.Samples;
+    m_Framebuffer = CreateRef<Framebuffer>(framebufferSpec);
+
+    if (!m_Specification.CapturePath.empty())
+    {
+        framebufferSpec.Samples = 1;
+        m_CaptureFramebuffer = CreateRef<Framebuffer>(framebufferSpec);
+
+        FrameCaptureSpecification captureSpec;
+        captureSpec.OutputPath = m_Specification.CapturePath;
+        m_FrameCapture = CreateScope<FrameCapture>(captureSpec);
+    }
+
+    m_Samples.reserve(m_Specification.Frames);
+
+    BH_LOG_INFO("Benchmarking '{0}': {1} frames after {2} warmup frames at {3}x{4}", m_Specification.Label,
+        m_Specification.Frames, m_Specification.WarmupFrames, m_Specification.Width, m_Specification.Height);
+}
+
+void BenchLayer::OnDetach()
+{
+    // Waits for the captured frames to be written
+    m_FrameCapture.reset();
+}
+
+void BenchLayer::OnUpdate(Timestep ts)
+{
+    BH_PROFILE_FUNCTION();
+
+    const Timer cpuTimer;
+
+    // Loops over the path when more frames are asked for than it lasts
+    const float duration = m_CameraPath.GetDuration();
+    const float pathTime = static_cast<float>(m_FrameIndex) * s_PathTimeStep;
+    m_CameraPath.Apply(m_Camera, duration > 0.0f ? std::fmod(pathTime, duration) : 0.0f);
+
+    const glm::mat4 model = glm::rotate(glm::mat4(1.0f), glm::radians(-90.0f), glm::vec3(1.0f, 0.0f, 0.0f));
+
+    Renderer::ResetStats();
+    {
+        BH_GPU_PROFILE_SCOPE("Bench Frame");
+
+        m_Framebuffer->Bind();
+        m_Framebuffer->ClearColorAttachment({ 0.2f, 0.2f, 0.2f, 1.0f });
+        m_Framebuffer->ClearDepthAttachment();
+
+        Renderer::BeginScene(m_Camera, m_Framebuffer);
+        Renderer::Submit(m_Model, model, SubmitFlagStatic);
+        Renderer::DrawSkybox();
+        Renderer::EndScene();
+
+        Framebuffer::Unbind();
+    }
+    const float cpuTime = cpuTimer.ElapsedMillis();
+
+    // GPU results arrive a few frames late, the warmup frames hide that
+    if (m_FrameIndex >= m_Specification.WarmupFrames)
+    {
+        const Renderer::Statistics stats = Renderer::GetStats();
+
+        FrameSample sample;
+        sample.FrameTime = ts.GetMilliseconds();
+        sample.CPUTime = cpuTime;
+        sample.GPUTime = GPUProfiler::GetMilliseconds("Bench Frame");
+        sample.DrawCalls = stats.DrawCalls;
+        sample.Triangles = stats.TriangleCount;
+        m_Samples.push_back(sample);
+
+        // Outside the measured scopes, the resolve and copy only cost time in later frames
+        if (m_FrameCapture)
+        {
+            m_CaptureFramebuffer->BlitFramebuffer(m_Framebuffer);
+            m_FrameCapture->Capture(m_CaptureFramebuffer);
+        }
+    }
+
+    ++m_FrameIndex;
+    if (m_Samples.size() >= m_Specification.Frames)
+    {
+        WriteResults();
+        Application::Get().Close();
+    }
+}
+
+void BenchLayer::WriteResults() const
+{
+    BH_PROFILE_FUNCTION();
+
+    std::vector<float> frameTimes, cpuTimes, gpuTimes, drawCalls, triangles;
+    for (const FrameSample& sample : m_Samples)
+    {
+        frameTimes.push_back(sample.FrameTime);
+        cpuTimes.push_back(sample.CPUTime);
+        gpuTimes.push_back(sample.GPUTime);
+        drawCalls.push_back(static_cast<float>(sample.DrawCalls));
+        triangles.push_back(static_cast<float>(sample.Triangles));
+    }
+
+    std::ofstream file(m_Specification.OutputPath);
+    if (!file.is_open())
+    {
+        BH_LOG_ERROR("Could not write benchmark results to '{0}'", m_Specification.OutputPath.string());
+        return;
+    }
+
+    const ContextInfo& context = Application::Get().GetWindow().GetContext().GetInfo();
+    const FrameMetricSummary frameTime = FrameMetrics::SummarizeValues(frameTimes);
+
+    file << "{\n";
+    file << "    \"label\": \"" << Utils::EscapeJson(m_Specification.Label) << "\",\n";
+    file << "    \"renderer\": \"" << Utils::EscapeJson(context.Renderer) << "\",\n";
+    file << "    \"version\": \"" << Utils::EscapeJson(context.Version) << "\",\n";
+    file << "    \"width\": " << m_Specification.Width << ",\n";
+    file << "    \"height\": " << m_Specification.Height << ",\n";
+    file << "    \"samples\": " << static_cast<uint32_t>(m_Specification.Samples) << ",\n";
+    file << "    \"frames\": " << m_Samples.size() << ",\n";
+    file << "    \"warmup_frames\": " << m_Specification.WarmupFrames << ",\n";
+    Utils::WriteDistribution(file, "frame_ms", frameTime);
+    file << ",\n";
+    Utils::WriteDistribution(file, "cpu_ms", FrameMetrics::SummarizeValues(cpuTimes));
+    file << ",\n";
+    Utils::WriteDistribution(file, "gpu_ms", FrameMetrics::SummarizeValues(gpuTimes));
+    file << ",\n";
+    Utils::WriteDistribution(file, "draw_calls", FrameMetrics::SummarizeValues(drawCalls));
+    file << ",\n";
+    Utils::WriteDistribution(file, "triangles", FrameMetrics::SummarizeValues(triangles));
+    file << "\n}\n";
+
+    BH_LOG_INFO("Benchmark '{0}': frame p50 {1:.3f} ms, p99 {2:.3f} ms, results written to '{3}'",
+        m_Specification.Label, frameTime.P50, frameTime.P99, m_Specification.OutputPath.string());
+}
\ No newline at end of file
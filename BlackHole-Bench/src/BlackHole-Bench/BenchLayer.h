@@ -0,0 +1,56 @@
+#pragma once
+#include "BlackHole.h"
+
+struct BenchSpecification
+{
+    uint32_t Width = 1920, Height = 1080;
+    uint32_t WarmupFrames = 60;
+    uint32_t Frames = 600;
+    uint8_t Samples = 4;
+
+    // Relative to the models directory
+    std::filesystem::path ModelPath = "BarberShopChair_01_8k/BarberShopChair_01_8k.fbx";
+    // An orbit around the model is replayed when empty
+    std::filesystem::path CameraPath;
+    std::filesystem::path OutputPath = "bench.json";
+    std::string Label = "default";
+    // PNGs of every measured frame go here when set, for comparing images between runs
+    std::filesystem::path CapturePath;
+};
+
+// Replays a camera path into an offscreen framebuffer, one fixed step of path time per frame,
+// then writes frame time percentiles and renderer counters as JSON and closes the application
+class BenchLayer : public Layer
+{
+public:
+    explicit BenchLayer(const BenchSpecification& specification);
+    ~BenchLayer() override = default;
+
+    void OnAttach() override;
+    void OnDetach() override;
+    void OnUpdate(Timestep ts) override;
+private:
+    void WriteResults() const;
+private:
+    struct FrameSample
+    {
+        float FrameTime = 0.0f;
+        float CPUTime = 0.0f;
+        float GPUTime = 0.0f;
+        uint32_t DrawCalls = 0;
+        uint32_t Triangles = 0;
+    };
+private:
+    BenchSpecification m_Specification;
+
+    PerspectiveCamera m_Camera;
+    CameraPath m_CameraPath;
+    Ref<Model> m_Model;
+    Ref<Framebuffer> m_Framebuffer;
+
+    Ref<Framebuffer> m_CaptureFramebuffer;
+    Scope<FrameCapture> m_FrameCapture;
+
+    uint32_t m_FrameIndex = 0;
+    std::vector<FrameSample> m_Samples;
+};
\ No newline at end of file
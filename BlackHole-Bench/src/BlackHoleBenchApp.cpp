@@ -0,0 +1,92 @@
+#include "BlackHole/Core/EntryPoint.h"
+
+#include "BlackHole-Bench/BenchLayer.h"
+
+#include <charconv>
+
+namespace Utils
+{
+    // Leaves the result as it was unless the whole value is a number
+    static bool ParseUInt(std::string_view value, uint32_t& result)
+    {
+        uint32_t parsed = 0;
+        const auto [ptr, ec] = std::from_chars(value.data(), value.data() + value.size(), parsed);
+        if (ec != std::errc() || ptr != value.data() + value.size())
+            return false;
+
+        result = parsed;
+        return true;
+    }
+
+    static BenchSpecification ParseCommandLine(const ApplicationCommandLineArgs& args)
+    {
+        BenchSpecification spec;
+        for (int i = 1; i + 1 < args.Count; i += 2)
+        {
+            const std::string_view option = args[i];
+            const std::string_view value = args[i + 1];
+
+            uint32_t number = 0;
+            bool valid = true;
+            if (option == "--frames")
+                valid = ParseUInt(value, spec.Frames);
+            else if (option == "--warmup")
+                valid = ParseUInt(value, spec.WarmupFrames);
+            else if (option == "--width")
+                valid = ParseUInt(value, spec.Width);
+            else if (option == "--height")
+                valid = ParseUInt(value, spec.Height);
+            else if (option == "--samples")
+            {
+                valid = ParseUInt(value, number) && number >= 1 && number <= 16;
+                if (valid)
+                    spec.Samples = static_cast<uint8_t>(number);
+            }
+            else if (option == "--model")
+                spec.ModelPath = value;
+            else if (option == "--path")
+                spec.CameraPath = value;
+            else if (option == "--output")
+                spec.OutputPath = value;
+            else if (option == "--label")
+                spec.Label = value;
+            else if (option == "--capture")
+                spec.CapturePath = value;
+            else
+                BH_LOG_WARN("Unknown option '{0}'", option);
+
+            if (!valid)
+                BH_LOG_WARN("Invalid value '{0}' for '{1}', keeping the default", value, option);
+        }
+
+        if (args.Count % 2 == 0)
+            BH_LOG_WARN("Option '{0}' has no value", args[args.Count - 1]);
+
+        spec.Frames = std::max(spec.Frames, 1u);
+        spec.Width = std::max(spec.Width, 1u);
+        spec.Height = std::max(spec.Height, 1u);
+        return spec;
+    }
+}
+
+class BlackHoleBench : public Application
+{
+public:
+    BlackHoleBench(const ApplicationSpecification& spec, const BenchSpecification& benchSpec)
+        : Application(spec)
+    {
+        PushLayer(new BenchLayer(benchSpec));
+    }
+};
+
+// Usage: BlackHole-Bench [--frames N] [--warmup N] [--width W] [--height H] [--samples N]
+//                        [--model file] [--path file.bhcam] [--output file.json] [--label name]
+//                        [--capture directory]
+Application* CreateApplication(ApplicationCommandLineArgs args)
+{
+    ApplicationSpecification spec;
+    spec.Name = "Black Hole Bench";
+    spec.CommandLineArgs = args;
+    spec.Headless = true;
+    return new BlackHoleBench(spec, Utils::ParseCommandLine(args));
+}
\ No newline at end of file
@@ -3,6 +3,17 @@
 #include <imgui.h>
 #include <glm/gtc/type_ptr.hpp>
 
+// Keyframes per second when recording a camera path, playback interpolates between them
+static constexpr float s_CameraPathSampleRate = 10.0f;
+
+// Frame counts the stats summarize over, zero is the whole history
+static constexpr std::array<uint32_t, 4> s_MetricsWindows = { 60, 300, 1000, 0 };
+static constexpr const char* s_MetricsWindowNames[] = { "60 frames", "300 frames", "1000 frames", "History" };
+
+static constexpr const char* s_VSyncModeNames[] = { "Off", "On", "Adaptive" };
+static constexpr uint32_t s_MinFramesInFlight = 1;
+static constexpr uint32_t s_MaxFramesInFlight = 4;
+
 EditorLayer::EditorLayer()
     : Layer("EditorLayer")
     , m_CameraController(PerspectiveCamera(45.0f,
@@ -13,16 +24,11 @@ EditorLayer::EditorLayer()
 
 void EditorLayer::OnAttach()
 {
-    m_Model = CreateRef<Model>(Filesystem::GetModelsPath() / "BarberShopChair_01_8k/BarberShopChair_01_8k.fbx");
+    BH_PROFILE_FUNCTION();
 
-    FramebufferSpecification fbSpec;
-    fbSpec.Width = Application::Get().GetWindow().GetWidth();
-    fbSpec.Height = Application::Get().GetWindow().GetHeight();
-    fbSpec.Samples = 4;
-    m_FramebufferMSAA = CreateRef<Framebuffer>(fbSpec);
+    m_Model = CreateRef<Model>(Filesystem::GetModelsPath() / "BarberShopChair_01_8k/BarberShopChair_01_8k.fbx");
 
-	fbSpec.Samples = 1;
-	m_Framebuffer = CreateRef<Framebuffer>(fbSpec);
+    m_ViewportSize = { static_cast<float>(Application::Get().GetWindow().GetWidth()), static_cast<float>(Application::Get().GetWindow().GetHeight()) };
 }
 
 void EditorLayer::OnDetach()
@@ -31,19 +37,35 @@ void EditorLayer::OnDetach()
 
 void EditorLayer::OnUpdate(Timestep ts)
 {
-    m_FPS = 1.0f / ts;
+    BH_PROFILE_FUNCTION();
+
+    // Edited shaders compile in the background, the old ones keep rendering meanwhile
+    ShaderWatcher::Update();
 
     if (m_ViewportFocused)
 		m_CameraController.OnUpdate(ts);
 
-    // Resize
-    const FramebufferSpecification& spec = m_FramebufferMSAA->GetSpecification();
-	if (m_ViewportSize.x > 0.0f && m_ViewportSize.y > 0.0f
-		&& (spec.Width != static_cast<uint32_t>(m_ViewportSize.x) || spec.Height != static_cast<uint32_t>(m_ViewportSize.y)))
+	if (m_RecordingCameraPath)
 	{
-		m_FramebufferMSAA->Resize(static_cast<uint32_t>(m_ViewportSize.x), static_cast<uint32_t>(m_ViewportSize.y));
-		m_Framebuffer->Resize(static_cast<uint32_t>(m_ViewportSize.x), static_cast<uint32_t>(m_ViewportSize.y));
-		m_CameraController.OnResize(static_cast<uint32_t>(m_ViewportSize.x), static_cast<uint32_t>(m_ViewportSize.y));
+		const float keyframeInterval = 1.0f / s_CameraPathSampleRate;
+		if (m_RecordedCameraPath.IsEmpty() || m_RecordingTime - m_RecordedCameraPath.GetDuration() >= keyframeInterval)
+		{
+			const PerspectiveCamera& camera = m_CameraController.GetCamera();
+			m_RecordedCameraPath.AddKeyframe({ m_RecordingTime, camera.GetPosition(), camera.GetOrientation() });
+		}
+		m_RecordingTime += ts;
+	}
+
+    // Resize, the render graph allocates attachments for whatever size is asked for in a frame
+    const uint32_t viewportWidth = static_cast<uint32_t>(m_ViewportSize.x);
+    const uint32_t viewportHeight = static_cast<uint32_t>(m_ViewportSize.y);
+	if (viewportWidth == 0 || viewportHeight == 0)
+		return;
+
+	if (viewportWidth != m_RenderSize.x || viewportHeight != m_RenderSize.y)
+	{
+		m_RenderSize = { viewportWidth, viewportHeight };
+		m_CameraController.OnResize(viewportWidth, viewportHeight);
 	}
 
     glm::mat4 model = glm::scale(glm::mat4(1.0f), m_ModelScale);
@@ -52,24 +74,127 @@ void EditorLayer::OnUpdate(Timestep ts)
 	model = glm::rotate(model, glm::radians(m_ModelRotation.z), glm::vec3(0.0f, 0.0f, 1.0f));
 	model = glm::translate(model, m_ModelTranslation);
 
-    m_FramebufferMSAA->Bind();
-    m_FramebufferMSAA->ClearColorAttachment({ 0.2f, 0.2f, 0.2f, 1.0f });
-    m_FramebufferMSAA->ClearDepthAttachment();
-
 	Renderer::ResetStats();
 
-    Renderer::BeginScene(m_CameraController.GetCamera());
-    Renderer::Submit(m_Model, model);
-    Renderer::DrawSkybox();
-    Renderer::EndScene();
+	// The scene renders to part of full-size attachments, so the scale can change every frame without reallocating
+	if (m_DynamicResolutionEnabled)
+		m_DynamicResolution.Update(GPUProfiler::GetMilliseconds("Scene"));
+	else
+		m_DynamicResolution.Reset();
+	const glm::uvec2 renderSize = m_DynamicResolution.GetRenderSize(viewportWidth, viewportHeight);
+	const bool isUpscaled = renderSize.x != viewportWidth || renderSize.y != viewportHeight;
+
+	m_RenderGraph.Reset();
+
+	TransientTextureSpecification sceneSpec;
+	sceneSpec.Width = viewportWidth;
+	sceneSpec.Height = viewportHeight;
+	sceneSpec.Samples = 4;
+
+	RenderGraphResource sceneColor;
+	m_RenderGraph.AddPass("Scene", [&](RenderGraphBuilder& builder)
+	{
+		builder.SetRenderArea(renderSize.x, renderSize.y);
+		sceneColor = builder.Write(builder.CreateTexture("SceneColorMSAA", sceneSpec));
+
+		TransientTextureSpecification depthSpec = sceneSpec;
+		depthSpec.Format = AttachmentFormat::Depth24Stencil8;
+		builder.Write(builder.CreateTexture("SceneDepthMSAA", depthSpec));
+	},
+	[this, model](const RenderGraphContext& context)
+	{
+		BH_GPU_PROFILE_SCOPE("Scene");
+
+		const Ref<Framebuffer>& framebuffer = context.GetFramebuffer();
+		framebuffer->ClearColorAttachment({ 0.2f, 0.2f, 0.2f, 1.0f });
+		framebuffer->ClearDepthAttachment();
 
-    m_FramebufferMSAA->Unbind();
+		// Mouse look that arrives while the scene is recorded still makes it into this frame
+		Renderer::CameraLatchFn cameraLatch;
+		if (m_ViewportFocused)
+		{
+			cameraLatch = [this]() -> const PerspectiveCamera&
+			{
+				m_CameraController.OnLateUpdate();
+				return m_CameraController.GetCamera();
+			};
+		}
+
+		Renderer::BeginScene(m_CameraController.GetCamera(), framebuffer, std::move(cameraLatch));
+		Renderer::Submit(m_Model, model, SubmitFlagStatic);
+
+		// Test lights laid out on a spiral around the model
+		for (int32_t i = 0; i < m_PointLightCount; ++i)
+		{
+			const float t = static_cast<float>(i) / static_cast<float>(std::max(m_PointLightCount, 1));
+			const float angle = static_cast<float>(i) * 2.39996f;
+
+			PointLight light;
+			light.Position = glm::vec3(std::cos(angle), 0.0f, std::sin(angle)) * (1.0f + 6.0f * std::sqrt(t)) + glm::vec3(0.0f, -0.5f + t, 0.0f);
+			light.Color = glm::vec3(0.5f) + 0.5f * glm::cos(glm::vec3(0.0f, 2.0f, 4.0f) + angle);
+			light.Radius = m_PointLightRadius;
+			Renderer::SubmitLight(light);
+		}
+		Renderer::DrawSkybox();
+		Renderer::EndScene();
+	});
+
+	TransientTextureSpecification resolvedSpec = sceneSpec;
+	resolvedSpec.Samples = 1;
+
+	RenderGraphResource resolvedColor;
+	m_RenderGraph.AddPass("Resolve", [&](RenderGraphBuilder& builder)
+	{
+		builder.SetRenderArea(renderSize.x, renderSize.y);
+		builder.Read(sceneColor);
+		resolvedColor = builder.Write(builder.CreateTexture("SceneColor", resolvedSpec));
+	},
+	[sceneColor](const RenderGraphContext& context)
+	{
+		BH_GPU_PROFILE_SCOPE("MSAA Resolve");
+		context.GetFramebuffer()->BlitFramebuffer(context.GetReadFramebuffer(sceneColor));
+	});
+	m_ViewportTexture = resolvedColor;
 
-	m_Framebuffer->BlitFramebuffer(m_FramebufferMSAA);
+	if (isUpscaled)
+	{
+		m_RenderGraph.AddPass("Upscale", [&](RenderGraphBuilder& builder)
+		{
+			builder.Read(resolvedColor);
+			m_ViewportTexture = builder.Write(builder.CreateTexture("ViewportColor", resolvedSpec));
+		},
+		[this, resolvedColor](const RenderGraphContext& context)
+		{
+			Renderer::Upscale(context.GetReadFramebuffer(resolvedColor), m_UpscaleSharpness);
+		});
+	}
+
+	m_RenderGraph.MarkOutput(m_ViewportTexture);
+	m_RenderGraph.Compile();
+	m_RenderGraph.Execute();
+
+	if (m_FrameCapture)
+		m_FrameCapture->Capture(m_RenderGraph.GetTextureRendererID(m_ViewportTexture), viewportWidth, viewportHeight);
+
+	const auto stats = Renderer::GetStats();
+	FrameSample sample;
+	sample.FrameIndex = GPUProfiler::GetFrameIndex();
+	sample.CPUTime = ts.GetMilliseconds();
+	sample.DrawCalls = stats.DrawCalls;
+	sample.TriangleCount = stats.TriangleCount;
+	m_FrameMetrics.Record(sample);
+
+	// Measured a few frames ago, so it goes to the frame it belongs to rather than this one
+	float gpuTime = 0.0f;
+	uint64_t gpuFrameIndex = 0;
+	if (GPUProfiler::GetLatestResult("Scene", gpuTime, gpuFrameIndex))
+		m_FrameMetrics.RecordGPUTime(gpuFrameIndex, gpuTime);
 }
 
 void EditorLayer::OnImGuiRender()
 {
+	BH_PROFILE_FUNCTION();
+
 	static bool dockspaceOpen = true;
 	static constexpr ImGuiDockNodeFlags dockspaceFlags = ImGuiDockNodeFlags_PassthruCentralNode;
 	static constexpr ImGuiWindowFlags windowFlags =
@@ -129,25 +254,195 @@ void EditorLayer::OnImGuiRender()
 
     Application::Get().GetImGuiLayer()->BlockEvents(!viewportIsReadyForInteraction);
 
-	const uint64_t textureID = m_Framebuffer->GetColorAttachmentRendererID();
+	const uint64_t textureID = m_RenderGraph.GetTextureRendererID(m_ViewportTexture);
 	ImGui::Image(reinterpret_cast<void*>(textureID), ImVec2( m_ViewportSize.x, m_ViewportSize.y ), ImVec2(0.0f, 1.0f), ImVec2(1.0f, 0.0f));
     ImGui::End();
 
 	ImGui::Begin("Stats");
     const auto stats = Renderer::GetStats();
-    ImGui::Text("FPS: %f", m_FPS);
+	ImGui::Combo("Window", &m_MetricsWindow, s_MetricsWindowNames, static_cast<int32_t>(s_MetricsWindows.size()));
+	const uint32_t metricsWindow = s_MetricsWindows[m_MetricsWindow] != 0 ? s_MetricsWindows[m_MetricsWindow] : m_FrameMetrics.GetCapacity();
+
+	const FrameMetricSummary cpuTime = m_FrameMetrics.Summarize(FrameMetric::CPUTime, metricsWindow);
+	const FrameMetricSummary gpuTime = m_FrameMetrics.Summarize(FrameMetric::GPUTime, metricsWindow);
+	ImGui::Text("FPS: %.1f", cpuTime.Mean > 0.0f ? 1000.0f / cpuTime.Mean : 0.0f);
+	ImGui::Text("CPU p50/p95/p99/max: %.2f/%.2f/%.2f/%.2f ms", cpuTime.P50, cpuTime.P95, cpuTime.P99, cpuTime.Max);
+	ImGui::Text("GPU p50/p95/p99/max: %.2f/%.2f/%.2f/%.2f ms", gpuTime.P50, gpuTime.P95, gpuTime.P99, gpuTime.Max);
+
+	m_FrameMetrics.GetValues(FrameMetric::CPUTime, metricsWindow, m_FrameTimePlot);
+	ImGui::PlotLines("##FrameTimes", m_FrameTimePlot.data(), static_cast<int32_t>(m_FrameTimePlot.size()), 0, "CPU frame time",
+		0.0f, std::max(cpuTime.Max, 1.0f), ImVec2(ImGui::GetContentRegionAvail().x, 60.0f));
+
+	if (ImGui::TreeNode("Budgets"))
+	{
+		auto& budget = m_FrameMetrics.GetBudget();
+		ImGui::DragFloat("CPU Time", &budget.CPUTime, 0.1f, 0.0f, 100.0f, "%.1f ms");
+		ImGui::DragFloat("GPU Time", &budget.GPUTime, 0.1f, 0.0f, 100.0f, "%.1f ms");
+		ImGui::DragScalar("Draw Calls", ImGuiDataType_U32, &budget.DrawCalls, 10.0f);
+		ImGui::DragScalar("Triangles", ImGuiDataType_U32, &budget.TriangleCount, 1000.0f);
+		ImGui::Text("Frames over budget: %llu", static_cast<unsigned long long>(m_FrameMetrics.GetOverBudgetCount()));
+		ImGui::TreePop();
+	}
+	if (ImGui::Button("Export CSV"))
+		m_FrameMetrics.ExportCSV("frame_metrics.csv");
+
+	ImGui::Separator();
+	Window& window = Application::Get().GetWindow();
+	int32_t vsyncMode = static_cast<int32_t>(window.GetVSyncMode());
+	if (ImGui::Combo("VSync", &vsyncMode, s_VSyncModeNames, static_cast<int32_t>(std::size(s_VSyncModeNames))))
+		window.SetVSyncMode(static_cast<VSyncMode>(vsyncMode));
+
+	FramePacer& framePacer = Application::Get().GetFramePacer();
+	auto& pacerSpec = framePacer.GetSpecification();
+	ImGui::DragFloat("Frame Cap", &pacerSpec.MaxFrameRate, 1.0f, 0.0f, 1000.0f, pacerSpec.MaxFrameRate > 0.0f ? "%.0f FPS" : "Off");
+	ImGui::SliderScalar("Frames In Flight", ImGuiDataType_U32, &pacerSpec.MaxFramesInFlight, &s_MinFramesInFlight, &s_MaxFramesInFlight);
+	const auto& pacerStats = framePacer.GetStats();
+	ImGui::Text("Input Latency: %.2f ms", pacerStats.InputLatency);
+	ImGui::Text("Waited: %.2f ms cap, %.2f ms GPU", pacerStats.FrameCapWaitTime, pacerStats.GPUWaitTime);
+
+	ImGui::Separator();
 	ImGui::Text("Draw Calls: %d", stats.DrawCalls);
 	ImGui::Text("Triangles: %d", stats.TriangleCount);
 	ImGui::Text("Lines: %d", stats.LinesCount);
 	ImGui::Text("Points: %d", stats.PointsCount);
 	ImGui::Text("Vertices: %d", stats.GetTotalVertexCount());
 	ImGui::Text("Indices: %d", stats.GetTotalIndexCount());
+	ImGui::Text("Render Passes: %d (%d culled)", m_RenderGraph.GetPassCount(), m_RenderGraph.GetCulledPassCount());
+	ImGui::Text("Pooled Textures: %d", m_RenderGraph.GetPooledTextureCount());
+
+	ImGui::Separator();
+	ImGui::Checkbox("Dynamic Resolution", &m_DynamicResolutionEnabled);
+	ImGui::Text("Render Scale: %.0f%%", m_DynamicResolution.GetScale() * 100.0f);
+	if (m_DynamicResolutionEnabled)
+	{
+		auto& resolutionSpec = m_DynamicResolution.GetSpecification();
+		ImGui::DragFloat("Target GPU Time", &resolutionSpec.TargetFrameTime, 0.1f, 1.0f, 100.0f, "%.1f ms");
+		ImGui::SliderFloat("Min Scale", &resolutionSpec.MinScale, 0.25f, 1.0f);
+		ImGui::SliderFloat("Sharpness", &m_UpscaleSharpness, 0.0f, 1.0f);
+	}
+
+	ImGui::Separator();
+	ImGui::Text("GPU Time (average)");
+	for (const auto& result : GPUProfiler::GetResults())
+	{
+		ImGui::Indent(static_cast<float>(result.Depth + 1) * 8.0f);
+		ImGui::Text("%s: %.3f ms", result.Name.c_str(), result.AverageMilliseconds);
+		ImGui::Unindent(static_cast<float>(result.Depth + 1) * 8.0f);
+	}
+
+	ImGui::Separator();
+	bool depthPrePass = Renderer::IsDepthPrePassEnabled();
+	if (ImGui::Checkbox("Depth Pre-Pass", &depthPrePass))
+		Renderer::SetDepthPrePassEnabled(depthPrePass);
+	if (depthPrePass)
+		ImGui::Text("Depth Pre-Pass: %.3f ms", stats.DepthPrePassTime);
+	ImGui::Text("Opaque Pass: %.3f ms", stats.OpaquePassTime);
+
+	ImGui::Separator();
+	bool occlusionCulling = Renderer::IsOcclusionCullingEnabled();
+	if (ImGui::Checkbox("Occlusion Culling", &occlusionCulling))
+		Renderer::SetOcclusionCullingEnabled(occlusionCulling);
+	if (occlusionCulling)
+	{
+		ImGui::Text("Occluded: %d", stats.OccludedObjects);
+		ImGui::Text("Frustum Culled: %d", stats.FrustumCulledObjects);
+	}
+	ImGui::Text("Lights: %d (clustered in %.3f ms)", stats.LightCount, stats.LightClusteringTime);
+
+	bool shadows = Renderer::AreShadowsEnabled();
+	if (ImGui::Checkbox("Shadows", &shadows))
+		Renderer::SetShadowsEnabled(shadows);
+	if (shadows)
+		ImGui::Text("Shadow Pass: %.3f ms (%d cascades redrawn)", stats.ShadowPassTime, stats.ShadowCascadesRendered);
+
+	bool softwareOcclusionCulling = Renderer::IsSoftwareOcclusionCullingEnabled();
+	if (ImGui::Checkbox("Software Occlusion Culling", &softwareOcclusionCulling))
+		Renderer::SetSoftwareOcclusionCullingEnabled(softwareOcclusionCulling);
+	if (softwareOcclusionCulling)
+	{
+		ImGui::Text("Software Culled: %d", stats.SoftwareCulledObjects);
+		ImGui::Text("Software Occlusion: %.3f ms", stats.SoftwareOcclusionTime);
+	}
     ImGui::End();
 
 	ImGui::Begin("Properties");
 	ImGui::DragFloat3("Translation", glm::value_ptr(m_ModelTranslation), 0.1f);
 	ImGui::DragFloat3("Rotation", glm::value_ptr(m_ModelRotation), 1.0f, -180.0f, 180.0f);
 	ImGui::DragFloat3("Scale", glm::value_ptr(m_ModelScale), 0.01f, 0.1f, 10.0f);
+
+	ImGui::Separator();
+	DirectionalLight sunLight = Renderer::GetDirectionalLight();
+	if (ImGui::DragFloat3("Light Direction", glm::value_ptr(sunLight.Direction), 0.01f, -1.0f, 1.0f) && glm::length(sunLight.Direction) > 0.0f)
+		Renderer::SetDirectionalLight(sunLight);
+	ImGui::SliderInt("Point Lights", &m_PointLightCount, 0, 512);
+	ImGui::DragFloat("Light Radius", &m_PointLightRadius, 0.05f, 0.1f, 20.0f);
+
+	ImGui::Separator();
+	if (!m_RecordingCameraPath)
+	{
+		if (ImGui::Button("Record Camera Path"))
+		{
+			m_RecordedCameraPath.Clear();
+			m_RecordingTime = 0.0f;
+			m_RecordingCameraPath = true;
+		}
+	}
+	else if (ImGui::Button("Stop Recording"))
+	{
+		m_RecordingCameraPath = false;
+
+		const std::filesystem::path filepath = Filesystem::GetAssetsPath() / "camera_paths" / "recorded.bhcam";
+		std::filesystem::create_directories(filepath.parent_path());
+		if (m_RecordedCameraPath.Save(filepath))
+			BH_LOG_INFO("Saved camera path with {0} keyframes to '{1}'", m_RecordedCameraPath.GetKeyframes().size(), filepath.string());
+	}
+	if (m_RecordingCameraPath)
+	{
+		ImGui::SameLine();
+		ImGui::Text("%.1f s", m_RecordingTime);
+	}
+
+	if (!m_FrameCapture)
+	{
+		if (ImGui::Button("Capture Viewport"))
+		{
+			FrameCaptureSpecification captureSpec;
+			captureSpec.Format = m_CaptureRawVideo ? CaptureFormat::RawVideo : CaptureFormat::PNGSequence;
+			captureSpec.OutputPath = m_CaptureRawVideo ? "captures/viewport.rgba" : "captures/viewport";
+			if (m_CaptureRawVideo)
+				std::filesystem::create_directories(captureSpec.OutputPath.parent_path());
+			m_FrameCapture = CreateScope<FrameCapture>(captureSpec);
+		}
+		ImGui::SameLine();
+		ImGui::Checkbox("Raw Video", &m_CaptureRawVideo);
+	}
+	else
+	{
+		// Finishes writing the queued frames
+		if (ImGui::Button("Stop Capture"))
+			m_FrameCapture.reset();
+	}
+	if (m_FrameCapture)
+	{
+		ImGui::SameLine();
+		ImGui::Text("%llu frames (%llu dropped)", static_cast<unsigned long long>(m_FrameCapture->GetEncodedFrameCount()),
+			static_cast<unsigned long long>(m_FrameCapture->GetDroppedFrameCount()));
+	}
+
+	// The mounted pack is released so the new one can be moved over it, loads meanwhile read the loose files
+	if (ImGui::Button("Pack Assets"))
+	{
+		VirtualFilesystem::UnmountAll();
+
+		ThreadPool threadPool;
+		PakArchive::Build(Filesystem::GetAssetsPath(), Filesystem::GetPackPath(), threadPool);
+
+		std::error_code error;
+		if (std::filesystem::is_regular_file(Filesystem::GetPackPath(), error))
+			VirtualFilesystem::Mount(Filesystem::GetPackPath(), Filesystem::GetAssetsPath());
+	}
+	ImGui::SameLine();
+	ImGui::Text("%u packs mounted", VirtualFilesystem::GetMountCount());
 	ImGui::End();
 
 	ImGui::End();
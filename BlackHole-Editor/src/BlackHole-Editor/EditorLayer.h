@@ -14,16 +14,36 @@ public:
     void OnEvent(Event& e) override;
 private:
     PerspectiveCameraController m_CameraController;
-    Ref<Framebuffer> m_FramebufferMSAA;
-    Ref<Framebuffer> m_Framebuffer;
+    RenderGraph m_RenderGraph;
+    RenderGraphResource m_ViewportTexture;
+
+    // Camera poses sampled while recording, saved for benchmarks to replay
+    CameraPath m_RecordedCameraPath;
+    bool m_RecordingCameraPath = false;
+    float m_RecordingTime = 0.0f;
+
+    // Viewport output, written out in the background while recording
+    Scope<FrameCapture> m_FrameCapture;
+    bool m_CaptureRawVideo = false;
+
+    DynamicResolution m_DynamicResolution;
+    bool m_DynamicResolutionEnabled = false;
+    float m_UpscaleSharpness = 0.5f;
     Ref<Model> m_Model;
     glm::vec3 m_ModelTranslation = glm::vec3(0.0f);
     glm::vec3 m_ModelRotation = glm::vec3(-90.0f, 0.0f, 0.0f);
     glm::vec3 m_ModelScale = glm::vec3(1.0f);
 
-    float m_FPS;
+    int32_t m_PointLightCount = 0;
+    float m_PointLightRadius = 1.5f;
+
+    FrameMetrics m_FrameMetrics;
+    // Index into the selectable summary windows
+    int32_t m_MetricsWindow = 1;
+    std::vector<float> m_FrameTimePlot;
 
     bool m_ViewportFocused = false;
     bool m_ViewportHovered = false;
     glm::vec2 m_ViewportSize;
+    glm::uvec2 m_RenderSize = { 0, 0 };
 };
@@ -12,9 +12,13 @@ public:
     }
 };
 
-Application* CreateApplication()
+Application* CreateApplication(ApplicationCommandLineArgs args)
 {
+    // Assets are edited and hot reloaded with a pack mounted, before the renderer loads its shaders
+    VirtualFilesystem::SetPreferNewerLooseFiles(true);
+
     ApplicationSpecification spec;
     spec.Name = "Black Hole Editor";
+    spec.CommandLineArgs = args;
     return new BlackHoleEditor(spec);
 }
\ No newline at end of file
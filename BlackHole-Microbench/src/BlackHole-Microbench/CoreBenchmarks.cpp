@@ -0,0 +1,189 @@
+#include "BlackHole-Microbench/SyntheticData.h"
+
+#include "BlackHole/Core/AsyncLogSink.h"
+#include "BlackHole/Core/LZ4.h"
+#include "BlackHole/Core/PakArchive.h"
+#include "BlackHole/Events/EventQueue.h"
+
+#include <benchmark/benchmark.h>
+#include <spdlog/sinks/null_sink.h>
+
+namespace
+{
+    // Handles the same events as the application and the camera controller do
+    class EventSink
+    {
+    public:
+        void OnEvent(Event& e)
+        {
+            EventDispatcher dispatcher(e);
+            dispatcher.Dispatch<MouseMovedEvent>(BH_BIND_EVENT_FN(OnMouseMoved));
+            dispatcher.Dispatch<MouseButtonPressedEvent>(BH_BIND_EVENT_FN(OnMouseButtonPressed));
+            dispatcher.Dispatch<MouseButtonReleasedEvent>(BH_BIND_EVENT_FN(OnMouseButtonReleased));
+            dispatcher.Dispatch<MouseScrolledEvent>(BH_BIND_EVENT_FN(OnMouseScrolled));
+            dispatcher.Dispatch<WindowResizeEvent>(BH_BIND_EVENT_FN(OnWindowResize));
+            dispatcher.Dispatch<KeyPressedEvent>(BH_BIND_EVENT_FN(OnKeyPressed));
+        }
+
+        float Sum = 0.0f;
+    private:
+        bool OnMouseMoved(MouseMovedEvent& e) { Sum += e.GetX() + e.GetY(); return false; }
+        bool OnMouseButtonPressed(MouseButtonPressedEvent& e) { Sum += 1.0f; return false; }
+        bool OnMouseButtonReleased(MouseButtonReleasedEvent& e) { Sum -= 1.0f; return false; }
+        bool OnMouseScrolled(MouseScrolledEvent& e) { Sum += e.GetYOffset(); return false; }
+        bool OnWindowResize(WindowResizeEvent& e) { Sum += static_cast<float>(e.GetWidth()); return false; }
+        bool OnKeyPressed(KeyPressedEvent& e) { Sum += static_cast<float>(e.GetKeyCode()); return false; }
+    };
+
+    class CountingLayer : public Layer
+    {
+    public:
+        explicit CountingLayer(uint64_t& counter) : m_Counter(counter) {}
+
+        void OnUpdate(Timestep ts) override { m_Counter += static_cast<uint64_t>(ts.GetMilliseconds()); }
+        void OnEvent(Event& e) override { ++m_Counter; }
+    private:
+        uint64_t& m_Counter;
+    };
+}
+
+static void BM_EventDispatch(benchmark::State& state)
+{
+    const std::vector<glm::vec2> deltas = SyntheticData::CreateMouseDeltas(4096);
+    EventSink sink;
+
+    size_t index = 0;
+    for (auto _ : state)
+    {
+        const glm::vec2& delta = deltas[index++ & (deltas.size() - 1)];
+        MouseMovedEvent e(delta.x, delta.y);
+        sink.OnEvent(e);
+    }
+
+    benchmark::DoNotOptimize(sink.Sum);
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_EventDispatch);
+
+// A frame of a high rate mouse: range(0) moves per frame with a click in the middle
+static void BM_EventQueueFrame(benchmark::State& state)
+{
+    const std::vector<glm::vec2> deltas = SyntheticData::CreateMouseDeltas(4096);
+    EventSink sink;
+    EventQueue queue;
+
+    size_t index = 0;
+    for (auto _ : state)
+    {
+        for (int64_t i = 0; i < state.range(0); ++i)
+        {
+            const glm::vec2& delta = deltas[index++ & (deltas.size() - 1)];
+            queue.Push(MouseMovedEvent(delta.x, delta.y));
+            if (i == state.range(0) / 2)
+                queue.Push(MouseButtonPressedEvent(0));
+        }
+        queue.Dispatch([&sink](Event& e) { sink.OnEvent(e); });
+    }
+
+    benchmark::DoNotOptimize(sink.Sum);
+    state.counters["CoalescedPerFrame"] = benchmark::Counter(static_cast<double>(queue.GetCoalescedCount()), benchmark::Counter::kAvgIterations);
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_EventQueueFrame)->Arg(16)->Arg(64);
+
+static void BM_LayerStackUpdate(benchmark::State& state)
+{
+    uint64_t counter = 0;
+    LayerStack layerStack;
+    for (int64_t i = 0; i < state.range(0); ++i)
+    {
+        if (i % 4 == 3)
+            layerStack.PushOverlay(new CountingLayer(counter));
+        else
+            layerStack.PushLayer(new CountingLayer(counter));
+    }
+
+    const Timestep ts(1.0f / 60.0f);
+    for (auto _ : state)
+    {
+        for (Layer* layer : layerStack)
+            layer->OnUpdate(ts);
+    }
+
+    benchmark::DoNotOptimize(counter);
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_LayerStackUpdate)->Arg(4)->Arg(32);
+
+// Events travel from the top of the stack down, as in Application::OnEvent
+static void BM_LayerStackEvent(benchmark::State& state)
+{
+    uint64_t counter = 0;
+    LayerStack layerStack;
+    for (int64_t i = 0; i < state.range(0); ++i)
+        layerStack.PushLayer(new CountingLayer(counter));
+
+    for (auto _ : state)
+    {
+        MouseMovedEvent e(1.0f, 2.0f);
+        for (auto it = layerStack.rbegin(); it != layerStack.rend() && !e.Handled; ++it)
+            (*it)->OnEvent(e);
+    }
+
+    benchmark::DoNotOptimize(counter);
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_LayerStackEvent)->Arg(4)->Arg(32);
+
+// Cost on the logging thread, writing to a sink that discards: 0 formats and writes in place, 1 queues for the background thread
+static void BM_LogMessage(benchmark::State& state)
+{
+    std::vector<spdlog::sink_ptr> sinks = { std::make_shared<spdlog::sinks::null_sink_mt>() };
+    std::shared_ptr<AsyncLogSink> asyncSink;
+    std::shared_ptr<spdlog::logger> logger;
+    if (state.range(0))
+    {
+        asyncSink = std::make_shared<AsyncLogSink>(sinks, 8192);
+        logger = std::make_shared<spdlog::logger>("Bench", asyncSink);
+    }
+    else
+    {
+        logger = std::make_shared<spdlog::logger>("Bench", sinks.begin(), sinks.end());
+    }
+    logger->set_pattern("%^[%T] %n: %v%$");
+
+    uint64_t index = 0;
+    for (auto _ : state)
+        logger->info("Frame {0}: {1} draw calls in {2:.3f} ms", index++, 1234, 16.6f);
+
+    if (asyncSink)
+    {
+        asyncSink->flush();
+        state.counters["Dropped"] = static_cast<double>(asyncSink->GetDroppedCount());
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_LogMessage)->Arg(0)->Arg(1);
+
+// One full pack block of text in the style of an OBJ mesh
+static void BM_LZ4DecompressBlock(benchmark::State& state)
+{
+    SyntheticData::Random random(SyntheticData::DefaultSeed);
+    std::string text;
+    while (text.size() < PakArchive::BlockSize)
+        text += fmt::format("v {0:.4f} {1:.4f} {2:.4f}\n", random.NextFloat(), random.NextFloat(), random.NextFloat());
+    const std::vector<uint8_t> block(text.begin(), text.begin() + PakArchive::BlockSize);
+    std::vector<uint8_t> compressed(LZ4::GetMaxCompressedSize(block.size()));
+    compressed.resize(LZ4::Compress(block.data(), block.size(), compressed.data(), compressed.size()));
+
+    std::vector<uint8_t> output(block.size());
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(LZ4::Decompress(compressed.data(), compressed.size(), output.data(), output.size()));
+        benchmark::ClobberMemory();
+    }
+
+    state.counters["Ratio"] = static_cast<double>(compressed.size()) / static_cast<double>(block.size());
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(block.size()));
+}
+BENCHMARK(BM_LZ4DecompressBlock);
\ No newline at end of file
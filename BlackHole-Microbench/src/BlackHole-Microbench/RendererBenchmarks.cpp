@@ -0,0 +1,73 @@
+#include "BlackHole-Microbench/SyntheticData.h"
+
+#include <benchmark/benchmark.h>
+#include <stb_image.h>
+
+static void BM_MeshConvert(benchmark::State& state)
+{
+    const Scope<aiMesh> mesh = SyntheticData::CreateGridMesh(static_cast<uint32_t>(state.range(0)));
+
+    for (auto _ : state)
+    {
+        MeshData data = Mesh::ConvertMesh(mesh.get());
+        benchmark::DoNotOptimize(data.Vertices.data());
+        benchmark::DoNotOptimize(data.Indices.data());
+    }
+
+    state.SetItemsProcessed(state.iterations() * mesh->mNumVertices);
+    state.counters["Vertices"] = static_cast<double>(mesh->mNumVertices);
+}
+BENCHMARK(BM_MeshConvert)->Arg(16)->Arg(128)->Arg(512)->Unit(benchmark::kMicrosecond);
+
+static void BM_TextureDecodePNG(benchmark::State& state)
+{
+    const uint32_t size = static_cast<uint32_t>(state.range(0));
+    const uint32_t channels = static_cast<uint32_t>(state.range(1));
+    const std::vector<uint8_t> png = SyntheticData::EncodePNG(SyntheticData::CreateImage(size, size, channels), size, size, channels);
+
+    for (auto _ : state)
+    {
+        int width, height, fileChannels;
+        stbi_uc* pixels = stbi_load_from_memory(png.data(), static_cast<int>(png.size()), &width, &height, &fileChannels, 0);
+        benchmark::DoNotOptimize(pixels);
+        stbi_image_free(pixels);
+    }
+
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(size) * size * channels);
+    state.counters["EncodedKB"] = static_cast<double>(png.size()) / 1024.0;
+}
+BENCHMARK(BM_TextureDecodePNG)->Args({ 256, 3 })->Args({ 1024, 3 })->Args({ 1024, 4 })->Unit(benchmark::kMillisecond);
+
+static void BM_CameraRotate(benchmark::State& state)
+{
+    const std::vector<glm::vec2> deltas = SyntheticData::CreateMouseDeltas(4096);
+    PerspectiveCamera camera(45.0f, 16.0f / 9.0f, 0.1f, 100.0f);
+
+    size_t index = 0;
+    for (auto _ : state)
+    {
+        const glm::vec2& delta = deltas[index++ & (deltas.size() - 1)];
+        camera.SetRotation(glm::radians(delta.x * 0.1f), glm::radians(delta.y * 0.1f));
+        camera.SetPosition(camera.GetPosition() + camera.GetTargetDirection() * 0.01f);
+        benchmark::DoNotOptimize(camera.GetViewMatrix());
+    }
+
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_CameraRotate);
+
+static void BM_CameraProjection(benchmark::State& state)
+{
+    PerspectiveCamera camera(45.0f, 16.0f / 9.0f, 0.1f, 100.0f);
+
+    float aspectRatio = 1.0f;
+    for (auto _ : state)
+    {
+        aspectRatio = aspectRatio > 3.0f ? 1.0f : aspectRatio + 0.001f;
+        camera.SetAspectRatio(aspectRatio);
+        benchmark::DoNotOptimize(camera.GetProjectionMatrix());
+    }
+
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_CameraProjection);
\ No newline at end of file
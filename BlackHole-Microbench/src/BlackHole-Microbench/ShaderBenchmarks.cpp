@@ -0,0 +1,65 @@
+#include "BlackHole-Microbench/SyntheticData.h"
+
+#include <benchmark/benchmark.h>
+#include <GLFW/glfw3.h>
+
+namespace
+{
+    // Uniform uploads need a context, a hidden window is created the first time one is asked for
+    Ref<Shader> GetUpscaleShader()
+    {
+        static Scope<Window> s_Window;
+        static Ref<Shader> s_Shader;
+        static bool s_Initialized = false;
+
+        if (!s_Initialized)
+        {
+            s_Initialized = true;
+            if (glfwInit() == GLFW_TRUE)
+            {
+                WindowProps props("Black Hole Microbench", 64, 64);
+                props.Visible = false;
+                s_Window = CreateScope<Window>(props);
+                s_Shader = CreateRef<Shader>(Filesystem::GetShadersPath() / "upscale.glsl");
+            }
+        }
+        return s_Shader;
+    }
+}
+
+// Looked up by name, hashed on every upload
+static void BM_ShaderUploadByName(benchmark::State& state)
+{
+    const Ref<Shader> shader = GetUpscaleShader();
+    if (!shader)
+    {
+        state.SkipWithError("No OpenGL context");
+        return;
+    }
+
+    const std::string name = "u_Sharpness";
+    float value = 0.0f;
+    for (auto _ : state)
+        shader->UploadFloat(std::string_view(name), value += 0.001f);
+
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_ShaderUploadByName);
+
+static void BM_ShaderUploadByHandle(benchmark::State& state)
+{
+    const Ref<Shader> shader = GetUpscaleShader();
+    if (!shader)
+    {
+        state.SkipWithError("No OpenGL context");
+        return;
+    }
+
+    const UniformHandle handle = shader->GetUniformHandle("u_Sharpness");
+    float value = 0.0f;
+    for (auto _ : state)
+        shader->UploadFloat(handle, value += 0.001f);
+
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_ShaderUploadByHandle);
\ No newline at end of file
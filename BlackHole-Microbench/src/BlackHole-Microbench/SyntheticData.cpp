@@ -0,0 +1,110 @@
+#include "BlackHole-Microbench/SyntheticData.h"
+
+// Implemented in the engine, along with frame capture
+#include <stb_image_write.h>
+
+namespace SyntheticData
+{
+    Scope<aiMesh> CreateGridMesh(uint32_t resolution, uint32_t seed)
+    {
+        Random random(seed);
+        resolution = std::max(resolution, 1u);
+
+        const uint32_t rowLength = resolution + 1;
+        const uint32_t vertexCount = rowLength * rowLength;
+        const uint32_t faceCount = resolution * resolution * 2;
+
+        auto mesh = CreateScope<aiMesh>();
+        mesh->mPrimitiveTypes = aiPrimitiveType_TRIANGLE;
+        mesh->mNumVertices = vertexCount;
+        mesh->mVertices = new aiVector3D[vertexCount];
+        mesh->mNormals = new aiVector3D[vertexCount];
+        mesh->mTextureCoords[0] = new aiVector3D[vertexCount];
+        mesh->mNumUVComponents[0] = 2;
+
+        for (uint32_t y = 0; y < rowLength; ++y)
+        {
+            for (uint32_t x = 0; x < rowLength; ++x)
+            {
+                const uint32_t index = y * rowLength + x;
+                const float u = static_cast<float>(x) / static_cast<float>(resolution);
+                const float v = static_cast<float>(y) / static_cast<float>(resolution);
+
+                mesh->mVertices[index] = aiVector3D(u - 0.5f, random.NextFloat(-0.05f, 0.05f), v - 0.5f);
+                mesh->mNormals[index] = aiVector3D(random.NextFloat(-0.1f, 0.1f), 1.0f, random.NextFloat(-0.1f, 0.1f)).Normalize();
+                mesh->mTextureCoords[0][index] = aiVector3D(u, v, 0.0f);
+            }
+        }
+
+        mesh->mNumFaces = faceCount;
+        mesh->mFaces = new aiFace[faceCount];
+
+        uint32_t face = 0;
+        const auto addTriangle = [&mesh, &face](uint32_t a, uint32_t b, uint32_t c)
+        {
+            aiFace& triangle = mesh->mFaces[face++];
+            triangle.mNumIndices = 3;
+            triangle.mIndices = new unsigned int[3] { a, b, c };
+        };
+
+        for (uint32_t y = 0; y < resolution; ++y)
+        {
+            for (uint32_t x = 0; x < resolution; ++x)
+            {
+                const uint32_t corner = y * rowLength + x;
+                addTriangle(corner, corner + rowLength, corner + 1);
+                addTriangle(corner + 1, corner + rowLength, corner + rowLength + 1);
+            }
+        }
+
+        return mesh;
+    }
+
+    std::vector<uint8_t> CreateImage(uint32_t width, uint32_t height, uint32_t channels, uint32_t seed)
+    {
+        Random random(seed);
+
+        std::vector<uint8_t> pixels(static_cast<size_t>(width) * height * channels);
+        size_t index = 0;
+        for (uint32_t y = 0; y < height; ++y)
+        {
+            for (uint32_t x = 0; x < width; ++x)
+            {
+                for (uint32_t c = 0; c < channels; ++c)
+                {
+                    const uint32_t gradient = (x * (c + 1) + y * (channels - c)) & 0xFF;
+                    const uint32_t noise = random.NextUInt() & 0x0F;
+                    pixels[index++] = static_cast<uint8_t>(std::min(gradient + noise, 255u));
+                }
+            }
+        }
+        return pixels;
+    }
+
+    std::vector<uint8_t> EncodePNG(const std::vector<uint8_t>& pixels, uint32_t width, uint32_t height, uint32_t channels)
+    {
+        std::vector<uint8_t> png;
+        stbi_write_png_to_func([](void* context, void* data, int size)
+        {
+            auto* output = static_cast<std::vector<uint8_t>*>(context);
+            const auto* bytes = static_cast<const uint8_t*>(data);
+            output->insert(output->end(), bytes, bytes + size);
+        },
+        &png, static_cast<int>(width), static_cast<int>(height), static_cast<int>(channels), pixels.data(), static_cast<int>(width * channels));
+        return png;
+    }
+
+    std::vector<glm::vec2> CreateMouseDeltas(size_t count, uint32_t seed)
+    {
+        Random random(seed);
+
+        std::vector<glm::vec2> deltas(count);
+        glm::vec2 drift(0.0f);
+        for (glm::vec2& delta : deltas)
+        {
+            drift = glm::clamp(drift + glm::vec2(random.NextFloat(-0.5f, 0.5f), random.NextFloat(-0.5f, 0.5f)), -4.0f, 4.0f);
+            delta = drift + glm::vec2(random.NextFloat(-1.0f, 1.0f), random.NextFloat(-1.0f, 1.0f));
+        }
+        return deltas;
+    }
+}
\ No newline at end of file
@@ -0,0 +1,36 @@
+#pragma once
+#include "BlackHole.h"
+
+#include <random>
+
+#include <assimp/mesh.h>
+
+// Generators for benchmark inputs. Everything derives from a fixed seed through std::mt19937, whose output
+// is fixed by the standard, and is mapped to ranges by hand, since the standard distributions are not
+namespace SyntheticData
+{
+    constexpr uint32_t DefaultSeed = 0x5EED0B1A;
+
+    class Random
+    {
+    public:
+        explicit Random(uint32_t seed = DefaultSeed) : m_Engine(seed) {}
+
+        uint32_t NextUInt() { return m_Engine(); }
+        // In [0, 1)
+        float NextFloat() { return static_cast<float>(m_Engine() >> 8) * (1.0f / 16777216.0f); }
+        float NextFloat(float min, float max) { return min + (max - min) * NextFloat(); }
+    private:
+        std::mt19937 m_Engine;
+    };
+
+    // Square grid of resolution x resolution quads with jittered heights, normals and texture coordinates
+    Scope<aiMesh> CreateGridMesh(uint32_t resolution, uint32_t seed = DefaultSeed);
+
+    // Smooth gradients with noise on top, so it compresses about as well as a real texture
+    std::vector<uint8_t> CreateImage(uint32_t width, uint32_t height, uint32_t channels, uint32_t seed = DefaultSeed);
+    std::vector<uint8_t> EncodePNG(const std::vector<uint8_t>& pixels, uint32_t width, uint32_t height, uint32_t channels);
+
+    // Mouse motion as a camera controller sees it, small deltas around a drifting direction
+    std::vector<glm::vec2> CreateMouseDeltas(size_t count, uint32_t seed = DefaultSeed);
+}
\ No newline at end of file
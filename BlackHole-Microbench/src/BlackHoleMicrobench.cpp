@@ -0,0 +1,21 @@
+#include "BlackHole.h"
+
+#include <benchmark/benchmark.h>
+
+// Usage: BlackHole-Microbench [--benchmark_filter=regex] [--benchmark_format=json] ...
+// Shader benchmarks need a display for their hidden window and are skipped without one
+int main(int argc, char** argv)
+{
+    Log::Init();
+    Log::SetLogLevel(spdlog::level::warn);
+    Filesystem::Init();
+
+    benchmark::Initialize(&argc, argv);
+    if (benchmark::ReportUnrecognizedArguments(argc, argv))
+        return 1;
+
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+
+    Log::Shutdown();
+}
\ No newline at end of file
@@ -0,0 +1,53 @@
+#include "BlackHole.h"
+#include "BlackHole/Core/AsyncLogSink.h"
+
+#include <sstream>
+
+#include <gtest/gtest.h>
+#include <spdlog/sinks/ostream_sink.h>
+
+namespace
+{
+    struct TestLogger
+    {
+        std::ostringstream Output;
+        std::shared_ptr<spdlog::logger> Logger;
+
+        TestLogger()
+        {
+            auto outputSink = std::make_shared<spdlog::sinks::ostream_sink_st>(Output);
+            auto asyncSink = std::make_shared<AsyncLogSink>(std::vector<spdlog::sink_ptr>{ outputSink }, 16);
+            asyncSink->set_pattern("%v");
+            Logger = std::make_shared<spdlog::logger>("Test", asyncSink);
+        }
+    };
+}
+
+TEST(AsyncLogSinkTest, WritesMessagesLongerThanASlot)
+{
+    TestLogger test;
+
+    const std::string longMessage = std::string(2000, 'a') + "end";
+    test.Logger->info("short");
+    test.Logger->info(longMessage);
+    test.Logger->info("after");
+    test.Logger->flush();
+
+    EXPECT_EQ(test.Output.str(), "short\n" + longMessage + "\nafter\n");
+}
+
+TEST(AsyncLogSinkTest, ReusesSlotsAfterLongMessages)
+{
+    TestLogger test;
+
+    std::string expected;
+    for (uint32_t i = 0; i < 40; ++i)
+    {
+        const std::string message = i % 2 ? std::string(300 + i, 'x') : fmt::format("message {0}", i);
+        test.Logger->info(message);
+        test.Logger->flush();
+        expected += message + "\n";
+    }
+
+    EXPECT_EQ(test.Output.str(), expected);
+}
@@ -0,0 +1,65 @@
+#include "BlackHole.h"
+
+#include <gtest/gtest.h>
+
+TEST(DynamicResolutionTest, DropsScaleWhenOverTargetAndWaitsForResults)
+{
+    DynamicResolution resolution;
+    EXPECT_EQ(resolution.GetScale(), 1.0f);
+
+    const float scale = resolution.Update(24.0f);
+    EXPECT_LT(scale, 1.0f);
+
+    // Results measured before the change still come in over the target for a few frames
+    for (uint32_t frame = 0; frame < 4; ++frame)
+        EXPECT_EQ(resolution.Update(24.0f), scale);
+    EXPECT_LT(resolution.Update(24.0f), scale);
+}
+
+TEST(DynamicResolutionTest, IgnoresNoiseAndMissingResults)
+{
+    DynamicResolution resolution;
+    resolution.Update(24.0f);
+    const float scale = resolution.GetScale();
+    for (uint32_t frame = 0; frame < 4; ++frame)
+        resolution.Update(12.0f);
+
+    EXPECT_EQ(resolution.Update(0.0f), scale);
+    EXPECT_EQ(resolution.Update(12.3f), scale);
+    EXPECT_EQ(resolution.Update(11.7f), scale);
+    EXPECT_GT(resolution.Update(6.0f), scale);
+}
+
+// Twice over the target and half of it ask for the same relative change
+TEST(DynamicResolutionTest, RecoversSlowerThanItDrops)
+{
+    DynamicResolution resolution;
+    const float dropped = 1.0f - resolution.Update(24.0f);
+
+    for (uint32_t frame = 0; frame < 200; ++frame)
+        resolution.Update(1000.0f);
+    const float lowScale = resolution.GetScale();
+    for (uint32_t frame = 0; frame < 4; ++frame)
+        resolution.Update(12.0f);
+
+    const float raised = (resolution.Update(6.0f) - lowScale) / lowScale;
+    EXPECT_GT(raised, 0.0f);
+    EXPECT_LT(raised, dropped);
+}
+
+TEST(DynamicResolutionTest, StaysWithinLimitsAndKeepsAPixel)
+{
+    DynamicResolutionSpecification spec;
+    spec.MinScale = 0.5f;
+    DynamicResolution resolution(spec);
+
+    for (uint32_t frame = 0; frame < 200; ++frame)
+        resolution.Update(1000.0f);
+    EXPECT_EQ(resolution.GetScale(), 0.5f);
+    EXPECT_EQ(resolution.GetRenderSize(1920, 1080), glm::uvec2(960, 540));
+    EXPECT_EQ(resolution.GetRenderSize(1, 1), glm::uvec2(1, 1));
+
+    for (uint32_t frame = 0; frame < 200; ++frame)
+        resolution.Update(1.0f);
+    EXPECT_EQ(resolution.GetScale(), 1.0f);
+}
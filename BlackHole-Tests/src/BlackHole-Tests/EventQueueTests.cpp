@@ -0,0 +1,74 @@
+#include "BlackHole.h"
+#include "BlackHole/Events/EventQueue.h"
+
+#include <gtest/gtest.h>
+
+namespace
+{
+    std::vector<std::string> DispatchAll(EventQueue& queue)
+    {
+        std::vector<std::string> events;
+        queue.Dispatch([&events](Event& e) { events.push_back(e.ToString()); });
+        return events;
+    }
+}
+
+TEST(EventQueueTest, CollapsesMovesAndResizesIntoTheLatest)
+{
+    EventQueue queue;
+    queue.Push(MouseMovedEvent(1.0f, 2.0f));
+    queue.Push(MouseMovedEvent(3.0f, 4.0f));
+    queue.Push(MouseMovedEvent(5.0f, 6.0f));
+    queue.Push(WindowResizeEvent(640, 480));
+    queue.Push(WindowResizeEvent(800, 600));
+
+    EXPECT_EQ(queue.GetSize(), 2u);
+    EXPECT_EQ(queue.GetCoalescedCount(), 3u);
+    EXPECT_EQ(DispatchAll(queue), (std::vector<std::string>{
+        MouseMovedEvent(5.0f, 6.0f).ToString(), WindowResizeEvent(800, 600).ToString() }));
+    EXPECT_TRUE(queue.IsEmpty());
+}
+
+TEST(EventQueueTest, AddsUpConsecutiveScrolls)
+{
+    EventQueue queue;
+    queue.Push(MouseScrolledEvent(0.0f, 1.0f));
+    queue.Push(MouseScrolledEvent(0.5f, 2.0f));
+
+    ASSERT_EQ(queue.GetSize(), 1u);
+    queue.Dispatch([](Event& e)
+    {
+        auto& scroll = static_cast<MouseScrolledEvent&>(e);
+        EXPECT_EQ(scroll.GetXOffset(), 0.5f);
+        EXPECT_EQ(scroll.GetYOffset(), 3.0f);
+    });
+}
+
+TEST(EventQueueTest, KeepsMovesOnEitherSideOfAButton)
+{
+    EventQueue queue;
+    queue.Push(MouseMovedEvent(1.0f, 1.0f));
+    queue.Push(MouseButtonPressedEvent(0));
+    queue.Push(MouseMovedEvent(2.0f, 2.0f));
+    queue.Push(MouseButtonReleasedEvent(0));
+
+    EXPECT_EQ(queue.GetCoalescedCount(), 0u);
+    EXPECT_EQ(DispatchAll(queue), (std::vector<std::string>{
+        MouseMovedEvent(1.0f, 1.0f).ToString(), MouseButtonPressedEvent(0).ToString(),
+        MouseMovedEvent(2.0f, 2.0f).ToString(), MouseButtonReleasedEvent(0).ToString() }));
+}
+
+TEST(EventQueueTest, EventsPushedWhileDispatchingWaitForTheNextDispatch)
+{
+    EventQueue queue;
+    queue.Push(KeyPressedEvent(65, 0));
+
+    uint32_t dispatched = 0;
+    queue.Dispatch([&](Event&)
+    {
+        ++dispatched;
+        queue.Push(KeyReleasedEvent(65));
+    });
+    EXPECT_EQ(dispatched, 1u);
+    EXPECT_EQ(DispatchAll(queue), (std::vector<std::string>{ KeyReleasedEvent(65).ToString() }));
+}
@@ -0,0 +1,95 @@
+#include "BlackHole.h"
+
+#include <gtest/gtest.h>
+
+namespace
+{
+    FrameSample CreateSample(uint64_t frameIndex, float cpuTime)
+    {
+        FrameSample sample;
+        sample.FrameIndex = frameIndex;
+        sample.CPUTime = cpuTime;
+        return sample;
+    }
+}
+
+TEST(FrameMetricsTest, JoinsLateGPUTimeToItsFrame)
+{
+    FrameMetrics metrics(16);
+    for (uint64_t frame = 0; frame < 5; ++frame)
+        metrics.Record(CreateSample(frame, static_cast<float>(frame)));
+
+    // Arrives while frame 4 is the newest, measured in frame 1
+    metrics.RecordGPUTime(1, 10.0f);
+
+    std::vector<float> values;
+    metrics.GetValues(FrameMetric::GPUTime, 16, values);
+    ASSERT_EQ(values.size(), 1u);
+    EXPECT_EQ(values[0], 10.0f);
+
+    metrics.RecordGPUTime(2, 20.0f);
+    metrics.GetValues(FrameMetric::GPUTime, 16, values);
+    EXPECT_EQ(values, (std::vector<float>{ 10.0f, 20.0f }));
+}
+
+TEST(FrameMetricsTest, FramesWithoutGPUTimeAreLeftOutOfItsSummary)
+{
+    FrameMetrics metrics(16);
+    for (uint64_t frame = 0; frame < 8; ++frame)
+        metrics.Record(CreateSample(frame, 1.0f));
+    for (uint64_t frame = 0; frame < 4; ++frame)
+        metrics.RecordGPUTime(frame, 5.0f);
+
+    const FrameMetricSummary gpuTime = metrics.Summarize(FrameMetric::GPUTime, 16);
+    EXPECT_EQ(gpuTime.Mean, 5.0f);
+    EXPECT_EQ(gpuTime.P50, 5.0f);
+
+    const FrameMetricSummary cpuTime = metrics.Summarize(FrameMetric::CPUTime, 16);
+    EXPECT_EQ(cpuTime.Mean, 1.0f);
+}
+
+TEST(FrameMetricsTest, RepeatedAndEvictedGPUTimesAreIgnored)
+{
+    FrameMetrics metrics(4);
+    for (uint64_t frame = 0; frame < 8; ++frame)
+        metrics.Record(CreateSample(frame, 1.0f));
+
+    // Frame 2 is no longer in the history, frame 5 keeps the first result it got
+    metrics.RecordGPUTime(2, 3.0f);
+    metrics.RecordGPUTime(5, 4.0f);
+    metrics.RecordGPUTime(5, 9.0f);
+
+    std::vector<float> values;
+    metrics.GetValues(FrameMetric::GPUTime, 4, values);
+    EXPECT_EQ(values, (std::vector<float>{ 4.0f }));
+}
+
+TEST(FrameMetricsTest, GPUBudgetIsCheckedWhenTheTimeArrives)
+{
+    FrameMetrics metrics(16);
+    metrics.GetBudget().GPUTime = 8.0f;
+
+    metrics.Record(CreateSample(0, 1.0f));
+    metrics.Record(CreateSample(1, 1.0f));
+    EXPECT_EQ(metrics.GetOverBudgetCount(), 0u);
+
+    metrics.RecordGPUTime(0, 12.0f);
+    EXPECT_EQ(metrics.GetOverBudgetCount(), 1u);
+    metrics.RecordGPUTime(1, 4.0f);
+    EXPECT_EQ(metrics.GetOverBudgetCount(), 1u);
+}
+
+TEST(FrameMetricsTest, SummarizesValuesByNearestRank)
+{
+    std::vector<float> values;
+    for (uint32_t i = 100; i >= 1; --i)
+        values.push_back(static_cast<float>(i));
+
+    const FrameMetricSummary summary = FrameMetrics::SummarizeValues(values);
+    EXPECT_EQ(summary.Min, 1.0f);
+    EXPECT_EQ(summary.Max, 100.0f);
+    EXPECT_EQ(summary.Mean, 50.5f);
+    EXPECT_EQ(summary.P50, 50.0f);
+    EXPECT_EQ(summary.P90, 90.0f);
+    EXPECT_EQ(summary.P99, 99.0f);
+}
@@ -0,0 +1,93 @@
+#include "BlackHole.h"
+
+#include <fstream>
+
+#include <gtest/gtest.h>
+
+namespace
+{
+    // Runs once on the worker thread fallback and once on io_uring, where the platform has it
+    class IOServiceTest : public testing::TestWithParam<bool>
+    {
+    protected:
+        IOServiceTest()
+        {
+            std::filesystem::remove_all(m_Directory);
+            std::filesystem::create_directories(m_Directory);
+        }
+
+        ~IOServiceTest() override
+        {
+            std::filesystem::remove_all(m_Directory);
+        }
+
+        // Few small buffers and a shallow queue, so reads wait for a slot and some miss a fixed buffer
+        IOServiceSpecification CreateSpecification() const
+        {
+            IOServiceSpecification spec;
+            spec.QueueDepth = 4;
+            spec.FixedBufferCount = 2;
+            spec.FixedBufferSize = 4096;
+            spec.ForceThreadPool = GetParam();
+            return spec;
+        }
+
+        std::filesystem::path WriteFile(uint32_t index, size_t size)
+        {
+            std::string contents(size, '\0');
+            for (size_t i = 0; i < size; ++i)
+                contents[i] = static_cast<char>('a' + (index + i) % 26);
+
+            const std::filesystem::path path = m_Directory / fmt::format("file{0}.txt", index);
+            std::ofstream(path, std::ios::binary | std::ios::trunc) << contents;
+            m_Contents[path] = std::move(contents);
+            return path;
+        }
+    protected:
+        const std::filesystem::path m_Directory = std::filesystem::temp_directory_path() / "bh_io_service_test";
+        std::unordered_map<std::filesystem::path, std::string> m_Contents;
+    };
+}
+
+TEST_P(IOServiceTest, ReadsEveryFileAndWaitsForItsCompletion)
+{
+    IOService service(CreateSpecification());
+    if (!GetParam() && !service.IsUsingIOUring())
+        GTEST_SKIP() << "No io_uring";
+    EXPECT_EQ(service.IsUsingIOUring(), !GetParam());
+
+    std::mutex mutex;
+    std::unordered_map<std::filesystem::path, std::string> results;
+    for (uint32_t i = 0; i < 20; ++i)
+    {
+        const std::filesystem::path path = WriteFile(i, i % 2 ? 100 + i : 10000 + i);
+        service.ReadFile(path, [&](const std::filesystem::path& readPath, FileData data)
+        {
+            ASSERT_TRUE(data.IsValid());
+            std::scoped_lock lock(mutex);
+            results[readPath] = data.GetText();
+        });
+    }
+    service.Wait();
+
+    EXPECT_EQ(results, m_Contents);
+}
+
+TEST_P(IOServiceTest, CompletesMissingAndEmptyFiles)
+{
+    IOService service(CreateSpecification());
+    if (!GetParam() && !service.IsUsingIOUring())
+        GTEST_SKIP() << "No io_uring";
+
+    const std::filesystem::path emptyPath = WriteFile(0, 0);
+    std::atomic<bool> missingIsValid = true, emptyIsValid = false;
+    service.ReadFile(m_Directory / "missing.txt", [&](const std::filesystem::path&, FileData data) { missingIsValid = data.IsValid(); });
+    service.ReadFile(emptyPath, [&](const std::filesystem::path&, FileData data) { emptyIsValid = data.IsValid() && data.GetSize() == 0; });
+    service.Wait();
+
+    EXPECT_FALSE(missingIsValid);
+    EXPECT_TRUE(emptyIsValid);
+}
+
+INSTANTIATE_TEST_SUITE_P(, IOServiceTest, testing::Values(true, false),
+    [](const testing::TestParamInfo<bool>& info) { return info.param ? "ThreadPool" : "IOUring"; });
@@ -0,0 +1,138 @@
+#include "BlackHole.h"
+#include "BlackHole/Core/LZ4.h"
+
+#include <fstream>
+#include <random>
+
+#include <gtest/gtest.h>
+
+namespace
+{
+    // Repeats a short phrase with a few changes, so it compresses but has literals between the matches
+    std::vector<uint8_t> CreateText(size_t size)
+    {
+        constexpr std::string_view phrase = "the quick brown fox jumps over the lazy dog ";
+        std::vector<uint8_t> bytes(size);
+        for (size_t i = 0; i < size; ++i)
+            bytes[i] = static_cast<uint8_t>(i % 97 == 0 ? 'A' + i % 26 : phrase[i % phrase.size()]);
+        return bytes;
+    }
+
+    std::vector<uint8_t> CreateNoise(size_t size)
+    {
+        std::mt19937 random(42);
+        std::vector<uint8_t> bytes(size);
+        for (uint8_t& byte : bytes)
+            byte = static_cast<uint8_t>(random());
+        return bytes;
+    }
+
+    std::vector<uint8_t> RoundTrip(const std::vector<uint8_t>& bytes)
+    {
+        std::vector<uint8_t> compressed(LZ4::GetMaxCompressedSize(bytes.size()));
+        compressed.resize(LZ4::Compress(bytes.data(), bytes.size(), compressed.data(), compressed.size()));
+
+        std::vector<uint8_t> decompressed(bytes.size());
+        EXPECT_TRUE(LZ4::Decompress(compressed.data(), compressed.size(), decompressed.data(), decompressed.size()));
+        return decompressed;
+    }
+
+    std::vector<uint8_t> ToBytes(const FileData& file)
+    {
+        return std::vector<uint8_t>(file.GetData(), file.GetData() + file.GetSize());
+    }
+
+    class PakArchiveTest : public testing::Test
+    {
+    protected:
+        PakArchiveTest()
+        {
+            std::filesystem::remove_all(m_Directory);
+            std::filesystem::create_directories(m_Directory / "assets" / "nested");
+        }
+
+        ~PakArchiveTest() override
+        {
+            std::filesystem::remove_all(m_Directory);
+        }
+
+        void WriteAsset(const std::filesystem::path& path, const std::vector<uint8_t>& bytes)
+        {
+            std::ofstream(m_Directory / "assets" / path, std::ios::binary | std::ios::trunc)
+                .write(reinterpret_cast<const char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+        }
+    protected:
+        const std::filesystem::path m_Directory = std::filesystem::temp_directory_path() / "bh_pak_test";
+        const std::filesystem::path m_PackPath = m_Directory / "assets.bhpak";
+
+        ThreadPool m_ThreadPool { 2 };
+    };
+}
+
+TEST(LZ4Test, RoundTripsCompressibleAndIncompressibleData)
+{
+    const std::vector<uint8_t> text = CreateText(100000);
+    EXPECT_EQ(RoundTrip(text), text);
+
+    const std::vector<uint8_t> noise = CreateNoise(5000);
+    EXPECT_EQ(RoundTrip(noise), noise);
+
+    // Matches overlapping their own output
+    const std::vector<uint8_t> run(3000, 7);
+    EXPECT_EQ(RoundTrip(run), run);
+
+    EXPECT_EQ(RoundTrip({}), std::vector<uint8_t>());
+}
+
+TEST(LZ4Test, RejectsWrongSizeAndTruncatedInput)
+{
+    const std::vector<uint8_t> text = CreateText(10000);
+    std::vector<uint8_t> compressed(LZ4::GetMaxCompressedSize(text.size()));
+    compressed.resize(LZ4::Compress(text.data(), text.size(), compressed.data(), compressed.size()));
+    ASSERT_LT(compressed.size(), text.size());
+
+    std::vector<uint8_t> decompressed(text.size() + 1);
+    EXPECT_FALSE(LZ4::Decompress(compressed.data(), compressed.size(), decompressed.data(), text.size() - 1));
+    EXPECT_FALSE(LZ4::Decompress(compressed.data(), compressed.size(), decompressed.data(), text.size() + 1));
+    EXPECT_FALSE(LZ4::Decompress(compressed.data(), compressed.size() / 2, decompressed.data(), text.size()));
+}
+
+TEST_F(PakArchiveTest, ReadsBackEveryPackedFile)
+{
+    // Several blocks that compress, one file served in place, and an empty one
+    const std::vector<uint8_t> text = CreateText(3 * PakArchive::BlockSize + 123);
+    const std::vector<uint8_t> noise = CreateNoise(20000);
+    WriteAsset("nested/text.txt", text);
+    WriteAsset("noise.bin", noise);
+    WriteAsset("empty.txt", {});
+    ASSERT_TRUE(PakArchive::Build(m_Directory / "assets", m_PackPath, m_ThreadPool));
+
+    const PakArchive archive(m_PackPath);
+    ASSERT_TRUE(archive.IsValid());
+    EXPECT_EQ(archive.GetEntries().size(), 3u);
+    EXPECT_EQ(archive.Find("nested/missing.txt"), nullptr);
+
+    const PakArchive::Entry* textEntry = archive.Find("nested/text.txt");
+    ASSERT_NE(textEntry, nullptr);
+    EXPECT_EQ(textEntry->BlockCount, 4u);
+    EXPECT_EQ(ToBytes(archive.Read(*textEntry)), text);
+    EXPECT_EQ(ToBytes(archive.Read(*textEntry, &m_ThreadPool)), text);
+
+    const PakArchive::Entry* noiseEntry = archive.Find("noise.bin");
+    ASSERT_NE(noiseEntry, nullptr);
+    EXPECT_EQ(noiseEntry->BlockCount, 0u);
+    EXPECT_EQ(ToBytes(archive.Read(*noiseEntry)), noise);
+
+    const PakArchive::Entry* emptyEntry = archive.Find("empty.txt");
+    ASSERT_NE(emptyEntry, nullptr);
+    EXPECT_EQ(archive.Read(*emptyEntry).GetSize(), 0u);
+}
+
+TEST_F(PakArchiveTest, RejectsTruncatedPack)
+{
+    WriteAsset("noise.bin", CreateNoise(20000));
+    ASSERT_TRUE(PakArchive::Build(m_Directory / "assets", m_PackPath, m_ThreadPool));
+
+    std::filesystem::resize_file(m_PackPath, std::filesystem::file_size(m_PackPath) - 16);
+    EXPECT_FALSE(PakArchive(m_PackPath).IsValid());
+}
@@ -0,0 +1,125 @@
+#include "BlackHole.h"
+
+#include <fstream>
+#include <thread>
+
+#include <gtest/gtest.h>
+#include <glad/glad.h>
+#include <GLFW/glfw3.h>
+
+namespace
+{
+    // The fragment stage scales its color by a constant, so a reload can change the source without changing the uniforms
+    constexpr const char* s_ShaderSource = R"(#type vertex
+#version 460 core
+void main()
+{
+	gl_Position = vec4(0.0, 0.0, 0.0, 1.0);
+}
+
+#type fragment
+#version 460 core
+out vec4 FragColor;
+
+uniform vec3 u_Color;
+const float Scale = SCALE;
+
+void main()
+{
+	FragColor = vec4(u_Color * Scale, 1.0);
+}
+)";
+
+    // Shaders need a context, a hidden window is created the first time one is asked for
+    bool HasContext()
+    {
+        static Scope<Window> s_Window;
+        static bool s_Initialized = false;
+
+        if (!s_Initialized)
+        {
+            s_Initialized = true;
+            if (glfwInit() == GLFW_TRUE)
+            {
+                WindowProps props("Black Hole Tests", 64, 64);
+                props.Visible = false;
+                s_Window = CreateScope<Window>(props);
+            }
+        }
+        return s_Window != nullptr;
+    }
+
+    void WriteShader(const std::filesystem::path& path, float scale)
+    {
+        std::string source = s_ShaderSource;
+        source.replace(source.find("SCALE"), 5, fmt::format("{:.2f}", scale));
+        std::ofstream(path, std::ios::trunc) << source;
+    }
+
+    // Reads the value back from the fragment program the shader's pipeline currently uses
+    glm::vec3 GetFragmentUniform(const Shader& shader, const char* name)
+    {
+        shader.Bind();
+        GLint pipeline = 0, program = 0;
+        glGetIntegerv(GL_PROGRAM_PIPELINE_BINDING, &pipeline);
+        glGetProgramPipelineiv(pipeline, GL_FRAGMENT_SHADER, &program);
+
+        glm::vec3 value = glm::vec3(-1.0f);
+        glGetUniformfv(program, glGetUniformLocation(program, name), &value.x);
+        return value;
+    }
+
+    bool WaitForReload(Shader& shader)
+    {
+        for (uint32_t attempt = 0; attempt < 1000 && shader.IsReloading(); ++attempt)
+        {
+            if (shader.UpdateReload())
+                return true;
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        return false;
+    }
+}
+
+TEST(ShaderTest, ReloadCallbackRestoresUniformsOfNewPipeline)
+{
+    if (!HasContext())
+        GTEST_SKIP() << "No OpenGL context";
+
+    const std::filesystem::path path = std::filesystem::temp_directory_path() / "bh_reload_test.glsl";
+    WriteShader(path, 1.0f);
+
+    const glm::vec3 color = { 0.25f, 0.5f, 0.75f };
+    Shader shader(path);
+    shader.SetReloadCallback([&](Shader& reloaded) { reloaded.UploadFloat3(reloaded.GetUniformHandle("u_Color"), color); });
+    shader.UploadFloat3(shader.GetUniformHandle("u_Color"), color);
+    ASSERT_EQ(GetFragmentUniform(shader, "u_Color"), color);
+
+    WriteShader(path, 0.5f);
+    shader.Reload();
+    ASSERT_TRUE(WaitForReload(shader));
+    EXPECT_EQ(GetFragmentUniform(shader, "u_Color"), color);
+
+    std::filesystem::remove(path);
+}
+
+TEST(ShaderTest, FailedReloadKeepsPipelineWithoutCallback)
+{
+    if (!HasContext())
+        GTEST_SKIP() << "No OpenGL context";
+
+    const std::filesystem::path path = std::filesystem::temp_directory_path() / "bh_failed_reload_test.glsl";
+    WriteShader(path, 1.0f);
+
+    uint32_t callbackCount = 0;
+    Shader shader(path);
+    shader.SetReloadCallback([&](Shader&) { ++callbackCount; });
+
+    std::ofstream(path, std::ios::app) << "not glsl\n";
+    shader.Reload();
+    EXPECT_FALSE(WaitForReload(shader));
+    EXPECT_FALSE(shader.IsReloading());
+    EXPECT_EQ(callbackCount, 0u);
+
+    std::filesystem::remove(path);
+}
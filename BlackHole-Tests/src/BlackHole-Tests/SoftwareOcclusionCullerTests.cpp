@@ -0,0 +1,103 @@
+#include "BlackHole.h"
+#include "BlackHole/Renderer/SoftwareOcclusionCuller.h"
+
+#include <gtest/gtest.h>
+
+#include <glm/gtc/matrix_inverse.hpp>
+
+namespace
+{
+    constexpr uint32_t s_Width = 256;
+    constexpr uint32_t s_Height = 128;
+
+    // A quad facing the camera and boxes behind it, placed by their edges in occlusion buffer pixels
+    class SoftwareOcclusionCullerTest : public testing::Test
+    {
+    protected:
+        SoftwareOcclusionCullerTest()
+            : m_Camera(45.0f, static_cast<float>(s_Width) / static_cast<float>(s_Height), 0.1f, 100.0f), m_Culler(m_ThreadPool, s_Width, s_Height)
+        {
+            m_InverseViewProjection = glm::inverse(m_Camera.GetProjectionMatrix() * m_Camera.GetViewMatrix());
+        }
+
+        glm::vec3 Unproject(float pixelX, float pixelY, float ndcDepth) const
+        {
+            const glm::vec4 ndc = { pixelX / s_Width * 2.0f - 1.0f, pixelY / s_Height * 2.0f - 1.0f, ndcDepth, 1.0f };
+            const glm::vec4 world = m_InverseViewProjection * ndc;
+            return glm::vec3(world) / world.w;
+        }
+
+        // Counter-clockwise on screen, lower left corner first
+        void AddOccluder(float minX, float minY, float maxX, float maxY)
+        {
+            m_Positions = {
+                Unproject(minX, minY, s_OccluderDepth),
+                Unproject(maxX, minY, s_OccluderDepth),
+                Unproject(maxX, maxY, s_OccluderDepth),
+                Unproject(minX, maxY, s_OccluderDepth)
+            };
+            m_Culler.AddOccluder(m_Positions, m_Indices, glm::mat4(1.0f));
+        }
+
+        // Flat box facing the camera, so its screen rectangle is exactly the one asked for
+        bool IsVisible(float minX, float minY, float maxX, float maxY)
+        {
+            AABB bounds;
+            bounds.Expand(Unproject(minX, minY, s_OccludeeDepth));
+            bounds.Expand(Unproject(maxX, maxY, s_OccludeeDepth));
+            return m_Culler.IsVisible(bounds);
+        }
+    protected:
+        static constexpr float s_OccluderDepth = 0.5f;
+        static constexpr float s_OccludeeDepth = 0.9f;
+
+        ThreadPool m_ThreadPool { 2 };
+        PerspectiveCamera m_Camera;
+        SoftwareOcclusionCuller m_Culler;
+        glm::mat4 m_InverseViewProjection;
+
+        std::vector<glm::vec3> m_Positions;
+        std::vector<uint32_t> m_Indices = { 0, 1, 2, 0, 2, 3 };
+    };
+}
+
+// Triangles only store pixels they cover completely, so the boxes stay clear of the quad's diagonal,
+// along which neither of its triangles covers a whole pixel
+TEST_F(SoftwareOcclusionCullerTest, CullsBoxEntirelyBehindOccluder)
+{
+    m_Culler.BeginFrame(m_Camera);
+    AddOccluder(40.3f, 30.3f, 100.7f, 90.6f);
+
+    EXPECT_FALSE(IsVisible(80.0f, 31.0f, 99.8f, 50.0f));
+    EXPECT_FALSE(IsVisible(41.2f, 70.0f, 55.0f, 89.5f));
+}
+
+TEST_F(SoftwareOcclusionCullerTest, KeepsBoxInFrontOfOccluder)
+{
+    m_Culler.BeginFrame(m_Camera);
+    AddOccluder(40.3f, 30.3f, 100.7f, 90.6f);
+
+    AABB bounds;
+    bounds.Expand(Unproject(80.0f, 31.0f, 0.2f));
+    bounds.Expand(Unproject(99.8f, 50.0f, 0.2f));
+    EXPECT_TRUE(m_Culler.IsVisible(bounds));
+}
+
+// The occluder covers the centres of its outermost pixel columns and rows, the boxes show past it within those pixels
+TEST_F(SoftwareOcclusionCullerTest, KeepsBoxPastSilhouetteBySubpixelAmount)
+{
+    m_Culler.BeginFrame(m_Camera);
+    AddOccluder(40.3f, 30.3f, 100.7f, 90.6f);
+
+    EXPECT_TRUE(IsVisible(80.0f, 31.0f, 100.9f, 50.0f));
+    EXPECT_TRUE(IsVisible(80.0f, 30.1f, 99.8f, 50.0f));
+    EXPECT_TRUE(IsVisible(40.1f, 70.0f, 55.0f, 89.5f));
+    EXPECT_TRUE(IsVisible(41.2f, 70.0f, 55.0f, 90.8f));
+}
+
+TEST_F(SoftwareOcclusionCullerTest, EmptyFrameCullsNothingInView)
+{
+    m_Culler.BeginFrame(m_Camera);
+
+    EXPECT_TRUE(IsVisible(50.0f, 40.0f, 80.0f, 80.0f));
+}
@@ -0,0 +1,85 @@
+#include "BlackHole.h"
+
+#include <fstream>
+
+#include <gtest/gtest.h>
+
+namespace
+{
+    // A directory with one loose file, packed next to it and mounted over it
+    class VirtualFilesystemTest : public testing::Test
+    {
+    protected:
+        VirtualFilesystemTest()
+        {
+            std::filesystem::remove_all(m_Directory);
+            std::filesystem::create_directories(m_Directory / "assets");
+            WriteAsset("packed");
+        }
+
+        ~VirtualFilesystemTest() override
+        {
+            VirtualFilesystem::SetPreferNewerLooseFiles(false);
+            VirtualFilesystem::UnmountAll();
+            std::filesystem::remove_all(m_Directory);
+        }
+
+        void WriteAsset(std::string_view contents)
+        {
+            std::ofstream(m_AssetPath, std::ios::binary | std::ios::trunc) << contents;
+        }
+
+        bool Pack()
+        {
+            return PakArchive::Build(m_Directory / "assets", m_PackPath, m_ThreadPool);
+        }
+
+        std::string ReadAsset() const
+        {
+            return std::string(VirtualFilesystem::ReadFile(m_AssetPath).GetText());
+        }
+    protected:
+        const std::filesystem::path m_Directory = std::filesystem::temp_directory_path() / "bh_vfs_test";
+        const std::filesystem::path m_AssetPath = m_Directory / "assets" / "asset.txt";
+        const std::filesystem::path m_PackPath = m_Directory / "assets.bhpak";
+
+        ThreadPool m_ThreadPool { 2 };
+    };
+}
+
+TEST_F(VirtualFilesystemTest, NewerLooseFileShadowsPackedCopyWhenPreferred)
+{
+    ASSERT_TRUE(Pack());
+    ASSERT_TRUE(VirtualFilesystem::Mount(m_PackPath, m_Directory / "assets"));
+
+    // Removing the loose file proves the read comes from the pack
+    std::filesystem::remove(m_AssetPath);
+    EXPECT_TRUE(VirtualFilesystem::IsPacked(m_AssetPath));
+    EXPECT_EQ(ReadAsset(), "packed");
+
+    WriteAsset("edited");
+    std::filesystem::last_write_time(m_AssetPath, std::filesystem::last_write_time(m_AssetPath) + std::chrono::seconds(10));
+    EXPECT_EQ(ReadAsset(), "packed");
+
+    VirtualFilesystem::SetPreferNewerLooseFiles(true);
+    EXPECT_FALSE(VirtualFilesystem::IsPacked(m_AssetPath));
+    EXPECT_EQ(ReadAsset(), "edited");
+
+    std::error_code error;
+    EXPECT_EQ(VirtualFilesystem::GetLastWriteTime(m_AssetPath, error), std::filesystem::last_write_time(m_AssetPath));
+}
+
+TEST_F(VirtualFilesystemTest, RebuildReplacesPackOnlyOnceComplete)
+{
+    ASSERT_TRUE(Pack());
+    ASSERT_TRUE(VirtualFilesystem::Mount(m_PackPath, m_Directory / "assets"));
+
+    WriteAsset("repacked");
+    VirtualFilesystem::UnmountAll();
+    ASSERT_TRUE(Pack());
+    EXPECT_FALSE(std::filesystem::exists(m_PackPath.string() + ".tmp"));
+
+    ASSERT_TRUE(VirtualFilesystem::Mount(m_PackPath, m_Directory / "assets"));
+    std::filesystem::remove(m_AssetPath);
+    EXPECT_EQ(ReadAsset(), "repacked");
+}
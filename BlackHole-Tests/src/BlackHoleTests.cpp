@@ -0,0 +1,18 @@
+#include "BlackHole.h"
+
+#include <gtest/gtest.h>
+
+// Usage: BlackHole-Tests [--gtest_filter=pattern] ...
+// Tests that need an OpenGL context create a hidden window and are skipped without a display
+int main(int argc, char** argv)
+{
+    Log::Init();
+    Log::SetLogLevel(spdlog::level::warn);
+    Filesystem::Init();
+
+    testing::InitGoogleTest(&argc, argv);
+    const int result = RUN_ALL_TESTS();
+
+    Log::Shutdown();
+    return result;
+}
@@ -2,21 +2,37 @@
 
 #include "BlackHole/Core/Application.h"
 #include "BlackHole/Core/Base.h"
+#include "BlackHole/Core/Clock.h"
 #include "BlackHole/Core/Filesystem.h"
+#include "BlackHole/Core/IOService.h"
 #include "BlackHole/Core/Input.h"
 #include "BlackHole/Core/Layer.h"
 #include "BlackHole/Core/Log.h"
+#include "BlackHole/Core/PakArchive.h"
+#include "BlackHole/Core/Profiler.h"
+#include "BlackHole/Core/Timer.h"
 #include "BlackHole/Core/Timestep.h"
+#include "BlackHole/Core/VirtualFilesystem.h"
 
 #include "BlackHole/ImGui/ImGuiLayer.h"
 
 #include "BlackHole/Renderer/CameraController.h"
+#include "BlackHole/Renderer/CameraPath.h"
+#include "BlackHole/Renderer/DynamicResolution.h"
+#include "BlackHole/Renderer/FrameMetrics.h"
+#include "BlackHole/Renderer/Image.h"
+#include "BlackHole/Renderer/Light.h"
 #include "BlackHole/Renderer/Model.h"
+#include "BlackHole/Renderer/RenderGraph.h"
 #include "BlackHole/Renderer/Renderer.h"
 
 #include "Platform/OpenGL/Buffer.h"
 #include "Platform/OpenGL/Cubemap.h"
+#include "Platform/OpenGL/FrameCapture.h"
+#include "Platform/OpenGL/FramePacer.h"
 #include "Platform/OpenGL/Framebuffer.h"
+#include "Platform/OpenGL/GPUProfiler.h"
 #include "Platform/OpenGL/Shader.h"
+#include "Platform/OpenGL/ShaderWatcher.h"
 #include "Platform/OpenGL/Texture.h"
 #include "Platform/OpenGL/VertexArray.h"
\ No newline at end of file
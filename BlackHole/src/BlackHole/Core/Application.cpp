@@ -1,18 +1,24 @@
 #include "bhpch.h"
 #include "BlackHole/Core/Application.h"
 
+#include "BlackHole/Core/Clock.h"
 #include "BlackHole/Renderer/Renderer.h"
 
 #include <GLFW/glfw3.h>
 #include <stb_image.h>
 
 #include "Platform/OpenGL/Framebuffer.h"
+#include "Platform/OpenGL/GPUProfiler.h"
+
+static constexpr uint32_t s_ProfileCaptureFrameCount = 120;
 
 Application* Application::s_Instance = nullptr;
 
 Application::Application(const ApplicationSpecification& specification)
     : m_Specification(specification)
 {
+    BH_PROFILE_FUNCTION();
+
     BH_ASSERT(!s_Instance, "Application already exists!");
     s_Instance = this;
 
@@ -23,42 +29,77 @@ Application::Application(const ApplicationSpecification& specification)
 
     WindowProps props;
     props.Title = specification.Name;
+    props.Visible = !specification.Headless;
 
     m_Window = CreateScope<Window>(props);
     m_Window->SetCallbackFunction(BH_BIND_EVENT_FN(OnEvent));
 
     Renderer::Init();
-    
-    m_ImGuiLayer = new ImGuiLayer();
-    PushOverlay(m_ImGuiLayer);
+    m_FramePacer = CreateScope<FramePacer>();
+
+    if (!specification.Headless)
+    {
+        m_ImGuiLayer = new ImGuiLayer();
+        PushOverlay(m_ImGuiLayer);
+    }
 }
 
 Application::~Application()
 {
+    BH_PROFILE_FUNCTION();
+
     for (const auto layer : m_LayerStack)
         layer->OnDetach();
+
+    m_FramePacer.reset();
+    Renderer::Shutdown();
+    GPUProfiler::Shutdown();
 }
 
 void Application::Run()
 {
+    m_LastFrameTime = Clock::Now();
     while (m_IsRunning)
     {
-        const float time = m_Timer.Elapsed();
-        const Timestep ts = time - m_LastFrameTime;
-        m_LastFrameTime = time;
-
-        Framebuffer::ClearDefaultFramebufferColorAttachment({ 0.2f, 0.2f, 0.2f, 1.0f});
-        Framebuffer::ClearDefaultFramebufferDepthStencilAttachment();
-
-        for (Layer* layer : m_LayerStack)
-            layer->OnUpdate(ts);
-
-        ImGuiLayer::Begin();
-        for (Layer* layer : m_LayerStack)
-            layer->OnImGuiRender();
-        ImGuiLayer::End();
-
-        m_Window->OnUpdate();
+        {
+            BH_PROFILE_SCOPE("Frame");
+
+            // Input is sampled after the wait, so the frame starts with the freshest events
+            m_FramePacer->BeginFrame();
+            m_Window->PollEvents();
+
+            const int64_t time = Clock::Now();
+            m_FramePacer->SetInputTime(time);
+            const Timestep ts = Clock::ToSeconds(time - m_LastFrameTime);
+            m_LastFrameTime = time;
+
+            Framebuffer::ClearDefaultFramebufferColorAttachment({ 0.2f, 0.2f, 0.2f, 1.0f});
+            Framebuffer::ClearDefaultFramebufferDepthStencilAttachment();
+
+            {
+                BH_PROFILE_SCOPE("LayerStack OnUpdate");
+                for (Layer* layer : m_LayerStack)
+                    layer->OnUpdate(ts);
+            }
+
+            if (m_ImGuiLayer)
+            {
+                ImGuiLayer::Begin();
+                {
+                    BH_PROFILE_SCOPE("LayerStack OnImGuiRender");
+                    for (Layer* layer : m_LayerStack)
+                        layer->OnImGuiRender();
+                }
+                ImGuiLayer::End();
+            }
+
+            GPUProfiler::EndFrame();
+            m_Window->SwapBuffers();
+            m_FramePacer->EndFrame();
+        }
+
+        // Outside the frame's scope, so the last frame of a capture is still recorded
+        Profiler::EndFrame();
     }
 }
 
@@ -80,12 +121,16 @@ void Application::OnEvent(Event& e)
 
 void Application::PushLayer(Layer* layer)
 {
+    BH_PROFILE_FUNCTION();
+
     m_LayerStack.PushLayer(layer);
     layer->OnAttach();
 }
 
 void Application::PushOverlay(Layer* overlay)
 {
+    BH_PROFILE_FUNCTION();
+
     m_LayerStack.PushOverlay(overlay);
     overlay->OnAttach();
 }
@@ -109,6 +154,11 @@ bool Application::OnKeyPressed(KeyPressedEvent& e)
     case GLFW_KEY_F11:
         m_Window->SetFullscreen(!m_Window->IsFullscreen());
         break;
+#ifdef BH_ENABLE_PROFILING
+    case GLFW_KEY_F12:
+        Profiler::CaptureFrames(s_ProfileCaptureFrameCount, "BlackHole-Frames.json");
+        break;
+#endif
     }
 
     return true;
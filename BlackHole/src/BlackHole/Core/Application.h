@@ -2,7 +2,6 @@
 #include <filesystem>
 
 #include "BlackHole/Core/LayerStack.h"
-#include "BlackHole/Core/Timer.h"
 #include "BlackHole/Core/Window.h"
 
 #include "BlackHole/Events/ApplicationEvent.h"
@@ -10,10 +9,28 @@
 
 #include "BlackHole/ImGui/ImGuiLayer.h"
 
+#include "Platform/OpenGL/FramePacer.h"
+
+struct ApplicationCommandLineArgs
+{
+    int Count = 0;
+    char** Args = nullptr;
+
+    const char* operator[](int index) const
+    {
+        BH_ASSERT(index < Count, "Command line argument out of range!");
+        return Args[index];
+    }
+};
+
 struct ApplicationSpecification
 {
     std::string Name = "Black Hole Application";
     std::filesystem::path WorkingDirectory;
+    ApplicationCommandLineArgs CommandLineArgs;
+
+    // For tools rendering offscreen: the window stays hidden and there is no ImGui layer
+    bool Headless = false;
 };
 
 class Application
@@ -36,7 +53,10 @@ public:
 
     static Application& Get() { return *s_Instance; }
     Window& GetWindow() const { return *m_Window; }
+    // Null for headless applications
     ImGuiLayer* GetImGuiLayer() const { return m_ImGuiLayer; }
+    const ApplicationSpecification& GetSpecification() const { return m_Specification; }
+    FramePacer& GetFramePacer() const { return *m_FramePacer; }
 protected:
     explicit Application(const ApplicationSpecification& specification);
 private:
@@ -48,13 +68,13 @@ private:
     ApplicationSpecification m_Specification;
     bool m_IsRunning = true;
     Scope<Window> m_Window;
-    ImGuiLayer* m_ImGuiLayer;
+    ImGuiLayer* m_ImGuiLayer = nullptr;
     LayerStack m_LayerStack;
-    Timer m_Timer;
-    float m_LastFrameTime = 0.0f;
+    Scope<FramePacer> m_FramePacer;
+    int64_t m_LastFrameTime = 0;
 private:
     static Application* s_Instance;
     friend int main(int argc, char** argv);
 };
 
-extern Application* CreateApplication();
\ No newline at end of file
+extern Application* CreateApplication(ApplicationCommandLineArgs args);
\ No newline at end of file
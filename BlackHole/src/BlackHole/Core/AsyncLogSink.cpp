@@ -0,0 +1,178 @@
+#include "bhpch.h"
+#include "BlackHole/Core/AsyncLogSink.h"
+
+#include <bit>
+
+AsyncLogSink::AsyncLogSink(std::vector<spdlog::sink_ptr> sinks, uint32_t capacity)
+    : m_Sinks(std::move(sinks))
+{
+    const uint64_t size = std::bit_ceil(std::max(capacity, 2u));
+    m_Entries = std::make_unique<Entry[]>(size);
+    m_Mask = size - 1;
+    for (uint64_t i = 0; i < size; ++i)
+        m_Entries[i].Sequence.store(i, std::memory_order_relaxed);
+
+    m_WorkerThread = std::thread(&AsyncLogSink::WorkerLoop, this);
+}
+
+AsyncLogSink::~AsyncLogSink()
+{
+    m_Stopping.store(true, std::memory_order_release);
+    WakeWorker();
+    m_WorkerThread.join();
+
+    for (const auto& sink : m_Sinks)
+        sink->flush();
+}
+
+void AsyncLogSink::log(const spdlog::details::log_msg& msg)
+{
+    if (!TryPush(msg))
+    {
+        m_DroppedCount.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    // Asserts break right after logging, the message has to be out by then
+    if (msg.level >= spdlog::level::critical)
+        flush();
+}
+
+void AsyncLogSink::flush()
+{
+    const uint64_t target = m_EnqueuePosition.load(std::memory_order_acquire);
+    while (m_DequeuePosition.load(std::memory_order_acquire) < target)
+        std::this_thread::yield();
+
+    for (const auto& sink : m_Sinks)
+        sink->flush();
+}
+
+void AsyncLogSink::set_pattern(const std::string& pattern)
+{
+    for (const auto& sink : m_Sinks)
+        sink->set_pattern(pattern);
+}
+
+void AsyncLogSink::set_formatter(std::unique_ptr<spdlog::formatter> formatter)
+{
+    for (const auto& sink : m_Sinks)
+        sink->set_formatter(formatter->clone());
+}
+
+bool AsyncLogSink::TryPush(const spdlog::details::log_msg& msg)
+{
+    // Bounded MPMC queue after Dmitry Vyukov: a slot's sequence tells whether it's free for the position
+    uint64_t position = m_EnqueuePosition.load(std::memory_order_relaxed);
+    Entry* entry;
+    while (true)
+    {
+        entry = &m_Entries[position & m_Mask];
+        const uint64_t sequence = entry->Sequence.load(std::memory_order_acquire);
+        const int64_t difference = static_cast<int64_t>(sequence) - static_cast<int64_t>(position);
+        if (difference == 0)
+        {
+            if (m_EnqueuePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+                break;
+        }
+        else if (difference < 0)
+        {
+            // Full, the slot still holds the message from a lap ago
+            return false;
+        }
+        else
+        {
+            position = m_EnqueuePosition.load(std::memory_order_relaxed);
+        }
+    }
+
+    entry->Level = msg.level;
+    entry->Time = msg.time;
+    entry->ThreadID = msg.thread_id;
+    entry->Source = msg.source;
+    entry->LoggerName = msg.logger_name;
+    entry->Size = static_cast<uint32_t>(std::min<size_t>(msg.payload.size(), std::numeric_limits<uint32_t>::max()));
+    char* message = entry->Message.data();
+    if (entry->Size > MaxMessageSize)
+    {
+        entry->Overflow = std::make_unique_for_overwrite<char[]>(entry->Size);
+        message = entry->Overflow.get();
+    }
+    std::memcpy(message, msg.payload.data(), entry->Size);
+
+    entry->Sequence.store(position + 1, std::memory_order_release);
+    WakeWorker();
+    return true;
+}
+
+void AsyncLogSink::WakeWorker()
+{
+    // Cheap while the worker is awake, only a sleeping worker needs the notify to go to the OS
+    m_WakeCount.fetch_add(1, std::memory_order_release);
+    m_WakeCount.notify_one();
+}
+
+uint32_t AsyncLogSink::Drain()
+{
+    uint32_t count = 0;
+    uint64_t position = m_DequeuePosition.load(std::memory_order_relaxed);
+    while (true)
+    {
+        Entry& entry = m_Entries[position & m_Mask];
+        if (entry.Sequence.load(std::memory_order_acquire) != position + 1)
+            break;
+
+        const char* const message = entry.Overflow ? entry.Overflow.get() : entry.Message.data();
+        spdlog::details::log_msg msg(entry.Source, entry.LoggerName, entry.Level, spdlog::string_view_t(message, entry.Size));
+        msg.time = entry.Time;
+        msg.thread_id = entry.ThreadID;
+
+        for (const auto& sink : m_Sinks)
+        {
+            if (sink->should_log(msg.level))
+                sink->log(msg);
+        }
+
+        // Warnings and errors shouldn't sit in a file buffer if the process goes down
+        if (msg.level >= spdlog::level::warn)
+        {
+            for (const auto& sink : m_Sinks)
+                sink->flush();
+        }
+
+        m_LastLoggerName = entry.LoggerName;
+        entry.Overflow.reset();
+        entry.Sequence.store(position + m_Mask + 1, std::memory_order_release);
+        m_DequeuePosition.store(++position, std::memory_order_release);
+        ++count;
+    }
+
+    const uint64_t droppedCount = m_DroppedCount.load(std::memory_order_relaxed);
+    if (droppedCount != m_ReportedDroppedCount)
+    {
+        const std::string text = fmt::format("{0} log messages dropped, the log queue was full", droppedCount - m_ReportedDroppedCount);
+        spdlog::details::log_msg msg(m_LastLoggerName, spdlog::level::warn, text);
+        for (const auto& sink : m_Sinks)
+            sink->log(msg);
+        m_ReportedDroppedCount = droppedCount;
+    }
+
+    return count;
+}
+
+void AsyncLogSink::WorkerLoop()
+{
+    while (true)
+    {
+        // Both are read before draining: a message queued while draining bumps the wake count, so the wait
+        // returns right away, and messages queued before stopping are all written
+        const uint32_t wakeCount = m_WakeCount.load(std::memory_order_acquire);
+        const bool stopping = m_Stopping.load(std::memory_order_acquire);
+        if (Drain() == 0)
+        {
+            if (stopping)
+                break;
+            m_WakeCount.wait(wakeCount, std::memory_order_acquire);
+        }
+    }
+}
\ No newline at end of file
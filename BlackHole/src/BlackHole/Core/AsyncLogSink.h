@@ -0,0 +1,71 @@
+#pragma once
+#include <atomic>
+#include <thread>
+
+#include <spdlog/sinks/sink.h>
+
+// Hands messages to a background thread that formats them with the sinks' patterns and writes them out.
+// Callers copy the message into a fixed-size slot of a lock-free ring and return, when the ring is full
+// the message is dropped instead of waiting, so logging never blocks a frame. Messages too long for a slot,
+// such as shader info logs, are copied to the heap instead and written out whole
+class AsyncLogSink : public spdlog::sinks::sink
+{
+public:
+    // Capacity is rounded up to a power of two
+    AsyncLogSink(std::vector<spdlog::sink_ptr> sinks, uint32_t capacity);
+    // Writes everything queued before returning
+    ~AsyncLogSink() override;
+
+    AsyncLogSink(const AsyncLogSink&) = delete;
+    AsyncLogSink& operator=(const AsyncLogSink&) = delete;
+
+    void log(const spdlog::details::log_msg& msg) override;
+    // Waits for the messages queued so far to be written, then flushes the sinks
+    void flush() override;
+    void set_pattern(const std::string& pattern) override;
+    void set_formatter(std::unique_ptr<spdlog::formatter> formatter) override;
+
+    uint64_t GetDroppedCount() const { return m_DroppedCount.load(std::memory_order_relaxed); }
+private:
+    // Longer messages go to Overflow
+    static constexpr uint32_t MaxMessageSize = 256 - 8;
+
+    struct Entry
+    {
+        std::atomic<uint64_t> Sequence = 0;
+
+        spdlog::level::level_enum Level = spdlog::level::off;
+        spdlog::log_clock::time_point Time;
+        size_t ThreadID = 0;
+        spdlog::source_loc Source;
+        // Loggers outlive their sinks' queued messages, the name is written out before the logger goes away
+        spdlog::string_view_t LoggerName;
+        uint32_t Size = 0;
+        std::array<char, MaxMessageSize> Message;
+        // Only allocated for messages longer than MaxMessageSize, freed once they are written
+        std::unique_ptr<char[]> Overflow;
+    };
+
+    bool TryPush(const spdlog::details::log_msg& msg);
+    void WakeWorker();
+    // Writes the queued messages, returns how many there were
+    uint32_t Drain();
+    void WorkerLoop();
+private:
+    std::vector<spdlog::sink_ptr> m_Sinks;
+
+    std::unique_ptr<Entry[]> m_Entries;
+    uint64_t m_Mask = 0;
+
+    alignas(64) std::atomic<uint64_t> m_EnqueuePosition = 0;
+    alignas(64) std::atomic<uint64_t> m_DequeuePosition = 0;
+    alignas(64) std::atomic<uint64_t> m_DroppedCount = 0;
+    // Worker thread only
+    uint64_t m_ReportedDroppedCount = 0;
+    spdlog::string_view_t m_LastLoggerName;
+
+    std::thread m_WorkerThread;
+    std::atomic<bool> m_Stopping = false;
+    // Bumped after every push, the worker sleeps on it while the queue is empty
+    alignas(64) std::atomic<uint32_t> m_WakeCount = 0;
+};
\ No newline at end of file
@@ -11,6 +11,9 @@
 
 #define BIT(x) (1 << x)
 
+#define BH_CONCAT_IMPL(a, b) a##b
+#define BH_CONCAT(a, b) BH_CONCAT_IMPL(a, b)
+
 #define BH_BIND_EVENT_FN(EventFn) [this]<typename EventType>(EventType&& e) { return this->EventFn(std::forward<EventType>(e)); }
 
 template <typename T>
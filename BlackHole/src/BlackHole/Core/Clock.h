@@ -0,0 +1,17 @@
+#pragma once
+#include <chrono>
+
+// Monotonic time in integer nanoseconds. Unlike float seconds it keeps full precision however long
+// the application has been running, convert only differences to floating point
+class Clock
+{
+public:
+    static int64_t Now()
+    {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+    static constexpr float ToSeconds(int64_t nanoseconds) { return static_cast<float>(static_cast<double>(nanoseconds) * 1e-9); }
+    static constexpr float ToMilliseconds(int64_t nanoseconds) { return static_cast<float>(static_cast<double>(nanoseconds) * 1e-6); }
+    static constexpr int64_t FromMilliseconds(double milliseconds) { return static_cast<int64_t>(milliseconds * 1e6); }
+};
\ No newline at end of file
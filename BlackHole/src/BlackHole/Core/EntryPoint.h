@@ -2,13 +2,22 @@
 #include "BlackHole/Core/Application.h"
 #include "BlackHole/Core/Base.h"
 #include "BlackHole/Core/Filesystem.h"
+#include "BlackHole/Core/Profiler.h"
 
 int main(int argc, char** argv)
 {
     Log::Init();
     Filesystem::Init();
 
-    auto* app = CreateApplication();
+    BH_PROFILE_BEGIN_SESSION("Startup", "BlackHole-Startup.json");
+    auto* app = CreateApplication({ argc, argv });
+    BH_PROFILE_END_SESSION();
+
     app->Run();
+
+    BH_PROFILE_BEGIN_SESSION("Shutdown", "BlackHole-Shutdown.json");
     delete app;
+    BH_PROFILE_END_SESSION();
+
+    Log::Shutdown();
 }
\ No newline at end of file
@@ -0,0 +1,34 @@
+#pragma once
+#include <string_view>
+#include <vector>
+
+// Contents of a file read through the virtual filesystem. Points straight into a mounted pack
+// for files stored uncompressed there, otherwise owns its bytes
+class FileData
+{
+public:
+    FileData() = default;
+    explicit FileData(std::vector<uint8_t> bytes)
+        : m_Storage(std::move(bytes)), m_Data(m_Storage.data()), m_Size(m_Storage.size()), m_IsValid(true) {}
+    // The owner keeps the memory alive as long as the data is around
+    FileData(const uint8_t* data, size_t size, std::shared_ptr<const void> owner)
+        : m_Owner(std::move(owner)), m_Data(data), m_Size(size), m_IsValid(true) {}
+
+    FileData(FileData&&) = default;
+    FileData& operator=(FileData&&) = default;
+    FileData(const FileData&) = delete;
+    FileData& operator=(const FileData&) = delete;
+
+    // False when the file couldn't be found or read
+    bool IsValid() const { return m_IsValid; }
+
+    const uint8_t* GetData() const { return m_Data; }
+    size_t GetSize() const { return m_Size; }
+    std::string_view GetText() const { return { reinterpret_cast<const char*>(m_Data), m_Size }; }
+private:
+    std::vector<uint8_t> m_Storage;
+    std::shared_ptr<const void> m_Owner;
+    const uint8_t* m_Data = nullptr;
+    size_t m_Size = 0;
+    bool m_IsValid = false;
+};
\ No newline at end of file
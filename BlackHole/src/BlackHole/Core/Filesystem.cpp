@@ -1,5 +1,6 @@
 #include "bhpch.h"
 #include "BlackHole/Core/Filesystem.h"
+#include "BlackHole/Core/VirtualFilesystem.h"
 
 struct FilesystemData
 {
@@ -8,6 +9,8 @@ struct FilesystemData
     std::filesystem::path ShadersPath;
     std::filesystem::path TexturesPath;
     std::filesystem::path FontPath;
+    std::filesystem::path CachePath;
+    std::filesystem::path PackPath;
 } static s_Data;
 
 void Filesystem::Init()
@@ -35,6 +38,12 @@ void Filesystem::Init()
     s_Data.ShadersPath = s_Data.AssetsPath / "shaders";
     s_Data.TexturesPath = s_Data.AssetsPath / "textures";
     s_Data.FontPath = s_Data.AssetsPath / "fonts";
+    s_Data.CachePath = s_Data.AssetsPath.parent_path() / "cache";
+    s_Data.PackPath = s_Data.AssetsPath.parent_path() / "assets.bhpak";
+
+    std::error_code error;
+    if (std::filesystem::is_regular_file(s_Data.PackPath, error))
+        VirtualFilesystem::Mount(s_Data.PackPath, s_Data.AssetsPath);
 }
 
 const std::filesystem::path& Filesystem::GetAssetsPath()
@@ -61,3 +70,14 @@ const std::filesystem::path& Filesystem::GetFontsPath()
 {
     return s_Data.FontPath;
 }
+
+const std::filesystem::path& Filesystem::GetCachePath()
+{
+    return s_Data.CachePath;
+}
+
+
+const std::filesystem::path& Filesystem::GetPackPath()
+{
+    return s_Data.PackPath;
+}
\ No newline at end of file
@@ -11,4 +11,8 @@ public:
     static const std::filesystem::path& GetShadersPath();
     static const std::filesystem::path& GetTexturesPath();
     static const std::filesystem::path& GetFontsPath();
+    // Next to the assets, for files the engine derives from them and can rebuild, such as program binaries
+    static const std::filesystem::path& GetCachePath();
+    // Next to the assets, packed from them and mounted over them when it exists
+    static const std::filesystem::path& GetPackPath();
 };
\ No newline at end of file
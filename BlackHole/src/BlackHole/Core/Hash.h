@@ -0,0 +1,28 @@
+#pragma once
+#include <cstdint>
+#include <string_view>
+
+// FNV-1a hashes usable in constant expressions, so string keys known at compile time cost nothing at runtime
+namespace Hash
+{
+    constexpr uint32_t FNV1a32(std::string_view str)
+    {
+        uint32_t hash = 2166136261u;
+        for (const char c : str)
+        {
+            hash ^= static_cast<uint8_t>(c);
+            hash *= 16777619u;
+        }
+        return hash;
+    }
+
+    constexpr uint64_t FNV1a64(std::string_view str, uint64_t hash = 14695981039346656037ull)
+    {
+        for (const char c : str)
+        {
+            hash ^= static_cast<uint8_t>(c);
+            hash *= 1099511628211ull;
+        }
+        return hash;
+    }
+}
\ No newline at end of file
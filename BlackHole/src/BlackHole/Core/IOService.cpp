@@ -0,0 +1,302 @@
+#include "bhpch.h"
+#include "BlackHole/Core/IOService.h"
+
+#include "BlackHole/Core/VirtualFilesystem.h"
+
+#include "Platform/Linux/IOUring.h"
+
+#if BH_HAS_IO_URING
+    #include <fcntl.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
+IOService::IOService(const IOServiceSpecification& specification)
+    : m_Specification(specification), m_Workers(CreateScope<ThreadPool>())
+{
+    if (!m_Specification.ForceThreadPool)
+        InitIOUring();
+}
+
+IOService::~IOService()
+{
+    Wait();
+}
+
+void IOService::ReadFile(const std::filesystem::path& path, CompletionFn completion)
+{
+    // Packed files are a copy out of a mapping, there is nothing to gain from the ring
+    if (m_Ring && !VirtualFilesystem::IsPacked(path))
+    {
+        m_QueuedRequests.push_back({ path, std::move(completion) });
+        return;
+    }
+
+    {
+        std::scoped_lock lock(m_CompletionMutex);
+        ++m_PendingCompletions;
+    }
+    m_Workers->Enqueue([this, path, completion = std::move(completion)]()
+    {
+        completion(path, VirtualFilesystem::ReadFile(path));
+
+        std::scoped_lock lock(m_CompletionMutex);
+        if (--m_PendingCompletions == 0)
+            m_CompletionsDone.notify_all();
+    });
+}
+
+void IOService::Poll()
+{
+    if (!m_Ring)
+        return;
+
+    ReapCompletions();
+    SubmitQueued();
+}
+
+void IOService::Wait()
+{
+    BH_PROFILE_FUNCTION();
+
+#if BH_HAS_IO_URING
+    if (m_Ring)
+    {
+        SubmitQueued();
+        while (m_ReadsInFlight > 0)
+        {
+            m_Ring->Submit(1);
+            ReapCompletions();
+            SubmitQueued();
+        }
+    }
+#endif
+
+    std::unique_lock lock(m_CompletionMutex);
+    m_CompletionsDone.wait(lock, [this]() { return m_PendingCompletions == 0; });
+}
+
+void IOService::Complete(ReadRequest request, FileData data)
+{
+    {
+        std::scoped_lock lock(m_CompletionMutex);
+        ++m_PendingCompletions;
+    }
+
+    // Jobs have to be copyable and the data isn't
+    auto job = std::make_shared<std::pair<ReadRequest, FileData>>(std::move(request), std::move(data));
+    m_Workers->Enqueue([this, job]()
+    {
+        job->first.Completion(job->first.Path, std::move(job->second));
+
+        std::scoped_lock lock(m_CompletionMutex);
+        if (--m_PendingCompletions == 0)
+            m_CompletionsDone.notify_all();
+    });
+}
+
+#if BH_HAS_IO_URING
+
+void IOService::InitIOUring()
+{
+    auto ring = CreateScope<IOUring>(m_Specification.QueueDepth);
+    if (!ring->IsValid())
+    {
+        BH_LOG_INFO("io_uring is unavailable, reading files on worker threads");
+        return;
+    }
+
+    if (m_Specification.FixedBufferCount > 0)
+    {
+        auto pool = CreateRef<FixedBufferPool>();
+        pool->BufferSize = m_Specification.FixedBufferSize;
+        pool->Memory = std::make_unique<uint8_t[]>(static_cast<size_t>(pool->BufferSize) * m_Specification.FixedBufferCount);
+
+        std::vector<iovec> buffers(m_Specification.FixedBufferCount);
+        for (uint32_t i = 0; i < m_Specification.FixedBufferCount; ++i)
+        {
+            buffers[i].iov_base = pool->Memory.get() + static_cast<size_t>(i) * pool->BufferSize;
+            buffers[i].iov_len = pool->BufferSize;
+            pool->FreeBuffers.push_back(m_Specification.FixedBufferCount - 1 - i);
+        }
+
+        // Pinned memory counts against RLIMIT_MEMLOCK, reads work without it, only with a little more overhead
+        if (ring->RegisterBuffers(buffers.data(), static_cast<uint32_t>(buffers.size())))
+            m_FixedBuffers = std::move(pool);
+        else
+            BH_LOG_WARN("Could not register {0} fixed I/O buffers, reading into regular ones", m_Specification.FixedBufferCount);
+    }
+
+    m_Ring = std::move(ring);
+    m_Reads.resize(m_Specification.QueueDepth);
+    for (uint32_t i = 0; i < m_Specification.QueueDepth; ++i)
+        m_FreeReads.push_back(m_Specification.QueueDepth - 1 - i);
+}
+
+void IOService::SubmitQueued()
+{
+    while (!m_QueuedRequests.empty() && !m_FreeReads.empty())
+    {
+        ReadRequest request = std::move(m_QueuedRequests.front());
+        m_QueuedRequests.pop_front();
+
+        const int fileDescriptor = open(request.Path.c_str(), O_RDONLY | O_CLOEXEC);
+        struct stat status;
+        if (fileDescriptor < 0 || fstat(fileDescriptor, &status) != 0)
+        {
+            BH_LOG_ERROR("Could not open file '{0}'", request.Path.string());
+            if (fileDescriptor >= 0)
+                close(fileDescriptor);
+            Complete(std::move(request), FileData());
+            continue;
+        }
+
+        const uint64_t size = static_cast<uint64_t>(status.st_size);
+        if (size == 0)
+        {
+            close(fileDescriptor);
+            Complete(std::move(request), FileData(std::vector<uint8_t>()));
+            continue;
+        }
+
+        const uint32_t readIndex = m_FreeReads.back();
+        m_FreeReads.pop_back();
+        ++m_ReadsInFlight;
+
+        PendingRead& read = m_Reads[readIndex];
+        read.Request = std::move(request);
+        read.FileDescriptor = fileDescriptor;
+        read.Size = size;
+        read.Offset = 0;
+        read.FixedBufferIndex = size <= m_Specification.FixedBufferSize ? AcquireFixedBuffer() : -1;
+        if (read.FixedBufferIndex >= 0)
+        {
+            read.Buffer = m_FixedBuffers->Memory.get() + static_cast<size_t>(read.FixedBufferIndex) * m_FixedBuffers->BufferSize;
+        }
+        else
+        {
+            read.Storage.resize(size);
+            read.Buffer = read.Storage.data();
+        }
+
+        QueueRead(readIndex);
+    }
+
+    m_Ring->Submit();
+}
+
+bool IOService::QueueRead(uint32_t readIndex)
+{
+    // There are never more reads than ring entries
+    io_uring_sqe* entry = m_Ring->GetSubmissionEntry();
+    BH_ASSERT(entry, "io_uring submission ring is full!");
+    if (!entry)
+        return false;
+
+    const PendingRead& read = m_Reads[readIndex];
+    // Reads are capped at 1 GiB, larger files take several
+    const uint64_t length = std::min<uint64_t>(read.Size - read.Offset, 1u << 30);
+
+    entry->opcode = read.FixedBufferIndex >= 0 ? IORING_OP_READ_FIXED : IORING_OP_READ;
+    entry->fd = read.FileDescriptor;
+    entry->addr = reinterpret_cast<uint64_t>(read.Buffer + read.Offset);
+    entry->len = static_cast<uint32_t>(length);
+    entry->off = read.Offset;
+    entry->buf_index = static_cast<uint16_t>(std::max(read.FixedBufferIndex, 0));
+    entry->user_data = readIndex;
+    return true;
+}
+
+void IOService::ReapCompletions()
+{
+    while (io_uring_cqe* completion = m_Ring->PeekCompletion())
+    {
+        const uint32_t readIndex = static_cast<uint32_t>(completion->user_data);
+        const int32_t result = completion->res;
+        m_Ring->SeenCompletion();
+
+        PendingRead& read = m_Reads[readIndex];
+        if (result == -EINTR || result == -EAGAIN)
+        {
+            if (!QueueRead(readIndex))
+                FinishRead(readIndex, false);
+            continue;
+        }
+
+        if (result <= 0)
+        {
+            // Zero means the file got shorter since it was opened
+            BH_LOG_ERROR("Could not read from file '{0}': {1}", read.Request.Path.string(), result < 0 ? std::strerror(-result) : "unexpected end of file");
+            FinishRead(readIndex, false);
+            continue;
+        }
+
+        // Short reads continue where they stopped
+        read.Offset += static_cast<uint64_t>(result);
+        if (read.Offset < read.Size)
+        {
+            if (!QueueRead(readIndex))
+                FinishRead(readIndex, false);
+            continue;
+        }
+
+        FinishRead(readIndex, true);
+    }
+}
+
+void IOService::FinishRead(uint32_t readIndex, bool succeeded)
+{
+    PendingRead& read = m_Reads[readIndex];
+    close(read.FileDescriptor);
+
+    FileData data;
+    if (read.FixedBufferIndex >= 0)
+    {
+        // The buffer goes back to the pool once the data is dropped, which may be after the service is gone
+        const Ref<FixedBufferPool> pool = m_FixedBuffers;
+        const uint32_t bufferIndex = static_cast<uint32_t>(read.FixedBufferIndex);
+        std::shared_ptr<const void> owner(read.Buffer, [pool, bufferIndex](const void*)
+        {
+            std::scoped_lock lock(pool->Mutex);
+            pool->FreeBuffers.push_back(bufferIndex);
+        });
+
+        if (succeeded)
+            data = FileData(read.Buffer, read.Size, std::move(owner));
+    }
+    else if (succeeded)
+    {
+        data = FileData(std::move(read.Storage));
+    }
+
+    Complete(std::move(read.Request), std::move(data));
+
+    read = PendingRead();
+    m_FreeReads.push_back(readIndex);
+    --m_ReadsInFlight;
+}
+
+int32_t IOService::AcquireFixedBuffer()
+{
+    if (!m_FixedBuffers)
+        return -1;
+
+    std::scoped_lock lock(m_FixedBuffers->Mutex);
+    if (m_FixedBuffers->FreeBuffers.empty())
+        return -1;
+
+    const uint32_t bufferIndex = m_FixedBuffers->FreeBuffers.back();
+    m_FixedBuffers->FreeBuffers.pop_back();
+    return static_cast<int32_t>(bufferIndex);
+}
+
+#else
+
+void IOService::InitIOUring() {}
+void IOService::SubmitQueued() {}
+bool IOService::QueueRead(uint32_t readIndex) { return false; }
+void IOService::ReapCompletions() {}
+void IOService::FinishRead(uint32_t readIndex, bool succeeded) {}
+int32_t IOService::AcquireFixedBuffer() { return -1; }
+
+#endif
\ No newline at end of file
@@ -0,0 +1,100 @@
+#pragma once
+#include <condition_variable>
+#include <deque>
+#include <filesystem>
+#include <mutex>
+
+#include "BlackHole/Core/FileData.h"
+#include "BlackHole/Core/ThreadPool.h"
+
+class IOUring;
+
+struct IOServiceSpecification
+{
+    // Reads in flight at once
+    uint32_t QueueDepth = 64;
+    // Registered with io_uring once, so reads into them skip pinning pages every time. Files that fit are
+    // read into one and handed to their completion without a copy, larger ones get an allocation of their own
+    uint32_t FixedBufferCount = 16;
+    uint32_t FixedBufferSize = 2 * 1024 * 1024;
+    // Blocking reads on the worker threads, which is what platforms without io_uring get
+    bool ForceThreadPool = false;
+};
+
+// Reads many files at once and hands each one to its completion on worker threads, where it can be decoded.
+// On Linux the reads go through io_uring, which keeps up to QueueDepth of them in flight from a single thread,
+// elsewhere the workers read with blocking calls. Files in mounted packs are read from the pack by the workers.
+// ReadFile, Poll and Wait are called from the thread that owns the service
+class IOService
+{
+public:
+    // The data is invalid when the file couldn't be read
+    using CompletionFn = std::function<void(const std::filesystem::path& path, FileData data)>;
+
+    explicit IOService(const IOServiceSpecification& specification = IOServiceSpecification());
+    // Waits for every read and completion
+    ~IOService();
+
+    IOService(const IOService&) = delete;
+    IOService& operator=(const IOService&) = delete;
+
+    // Queued, and submitted on the next Poll or Wait
+    void ReadFile(const std::filesystem::path& path, CompletionFn completion);
+
+    // Submits queued reads and passes finished ones on, without blocking
+    void Poll();
+    // Returns once every read so far has finished and its completion has returned
+    void Wait();
+
+    bool IsUsingIOUring() const { return m_Ring != nullptr; }
+private:
+    struct ReadRequest
+    {
+        std::filesystem::path Path;
+        CompletionFn Completion;
+    };
+
+    struct FixedBufferPool
+    {
+        std::unique_ptr<uint8_t[]> Memory;
+        uint32_t BufferSize = 0;
+        // Buffers come back from whichever thread drops the data read into them
+        std::mutex Mutex;
+        std::vector<uint32_t> FreeBuffers;
+    };
+
+    struct PendingRead
+    {
+        ReadRequest Request;
+        int FileDescriptor = -1;
+        uint64_t Size = 0;
+        uint64_t Offset = 0;
+        uint8_t* Buffer = nullptr;
+        int32_t FixedBufferIndex = -1;
+        std::vector<uint8_t> Storage;
+    };
+private:
+    void InitIOUring();
+    void SubmitQueued();
+    bool QueueRead(uint32_t readIndex);
+    void ReapCompletions();
+    void FinishRead(uint32_t readIndex, bool succeeded);
+    int32_t AcquireFixedBuffer();
+
+    // Runs the completion on the workers
+    void Complete(ReadRequest request, FileData data);
+private:
+    IOServiceSpecification m_Specification;
+    Scope<ThreadPool> m_Workers;
+
+    Scope<IOUring> m_Ring;
+    Ref<FixedBufferPool> m_FixedBuffers;
+    std::deque<ReadRequest> m_QueuedRequests;
+    std::vector<PendingRead> m_Reads;
+    std::vector<uint32_t> m_FreeReads;
+    uint32_t m_ReadsInFlight = 0;
+
+    std::mutex m_CompletionMutex;
+    std::condition_variable m_CompletionsDone;
+    uint32_t m_PendingCompletions = 0;
+};
\ No newline at end of file
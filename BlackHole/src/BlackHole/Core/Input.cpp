@@ -1,37 +1,34 @@
 #include "bhpch.h"
 #include "BlackHole/Core/Input.h"
-#include "BlackHole/Core/Application.h"
 
-#include <GLFW/glfw3.h>
+static InputState s_State;
 
 bool Input::IsKeyPressed(int keyCode)
 {
-    auto* window = Application::Get().GetWindow().GetNativeWindow();
-    const int state = glfwGetKey(window, keyCode);
-    return state == GLFW_PRESS || state == GLFW_REPEAT;
+    return keyCode >= 0 && static_cast<uint32_t>(keyCode) < InputState::MaxKeys && s_State.Keys.test(keyCode);
 }
 
 bool Input::IsMouseButtonPressed(int buttonCode)
 {
-    auto* window = Application::Get().GetWindow().GetNativeWindow();
-    const int state = glfwGetMouseButton(window, buttonCode);
-    return state == GLFW_PRESS;
+    return buttonCode >= 0 && static_cast<uint32_t>(buttonCode) < InputState::MaxMouseButtons && s_State.MouseButtons.test(buttonCode);
 }
 
 glm::vec2 Input::GetMousePosition()
 {
-    auto* window = Application::Get().GetWindow().GetNativeWindow();
-    int width, height;
-    glfwGetWindowSize(window, &width, &height);
-    return { width, height };
+    return s_State.MousePosition;
 }
 
 float Input::GetMouseX()
 {
-    return GetMousePosition().x;
+    return s_State.MousePosition.x;
 }
 
 float Input::GetMouseY()
 {
-    return GetMousePosition().y;
+    return s_State.MousePosition.y;
+}
+
+void Input::SetState(const InputState& state)
+{
+    s_State = state;
 }
\ No newline at end of file
@@ -1,6 +1,22 @@
 #pragma once
+#include <bitset>
+
 #include <glm/vec2.hpp>
 
+// Keyboard and mouse state as of the last polled events
+struct InputState
+{
+    // Indexed by GLFW key and mouse button codes
+    static constexpr uint32_t MaxKeys = 512;
+    static constexpr uint32_t MaxMouseButtons = 8;
+
+    std::bitset<MaxKeys> Keys;
+    std::bitset<MaxMouseButtons> MouseButtons;
+    glm::vec2 MousePosition = { 0.0f, 0.0f };
+};
+
+// Queries read a snapshot taken once per frame, so they don't call into the windowing system
+// and every query in a frame agrees
 class Input
 {
 public:
@@ -10,4 +26,7 @@ public:
     static glm::vec2 GetMousePosition();
     static float GetMouseX();
     static float GetMouseY();
-};
+
+    // Called by the window after dispatching the frame's events
+    static void SetState(const InputState& state);
+};
\ No newline at end of file
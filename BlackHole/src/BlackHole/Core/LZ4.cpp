@@ -0,0 +1,176 @@
+#include "bhpch.h"
+#include "BlackHole/Core/LZ4.h"
+
+namespace Utils
+{
+    static constexpr size_t MinMatch = 4;
+    // The format ends every block with literals: the last match starts at least 12 bytes
+    // before the end and the last 5 bytes are never part of a match
+    static constexpr size_t MatchStartLimit = 12;
+    static constexpr size_t LastLiterals = 5;
+
+    static constexpr uint32_t HashBits = 13;
+
+    static uint32_t Read32(const uint8_t* data)
+    {
+        uint32_t value;
+        std::memcpy(&value, data, sizeof(value));
+        return value;
+    }
+
+    static uint32_t HashSequence(uint32_t sequence)
+    {
+        return (sequence * 2654435761u) >> (32 - HashBits);
+    }
+
+    // Lengths past 15 continue in bytes of 255 and a final byte below it
+    static uint8_t* WriteLength(uint8_t* output, size_t length)
+    {
+        for (; length >= 255; length -= 255)
+            *output++ = 255;
+        *output++ = static_cast<uint8_t>(length);
+        return output;
+    }
+
+    static bool ReadLength(const uint8_t*& input, const uint8_t* inputEnd, size_t& length)
+    {
+        uint8_t byte;
+        do
+        {
+            if (input == inputEnd)
+                return false;
+            byte = *input++;
+            length += byte;
+        } while (byte == 255);
+        return true;
+    }
+
+    static uint8_t* WriteSequence(uint8_t* output, const uint8_t* literals, size_t literalCount, size_t offset, size_t matchLength)
+    {
+        uint8_t* token = output++;
+        *token = static_cast<uint8_t>(std::min<size_t>(literalCount, 15) << 4);
+        if (literalCount >= 15)
+            output = WriteLength(output, literalCount - 15);
+
+        if (literalCount > 0)
+            std::memcpy(output, literals, literalCount);
+        output += literalCount;
+
+        // The last sequence has no match
+        if (matchLength == 0)
+            return output;
+
+        *output++ = static_cast<uint8_t>(offset);
+        *output++ = static_cast<uint8_t>(offset >> 8);
+
+        matchLength -= MinMatch;
+        *token |= static_cast<uint8_t>(std::min<size_t>(matchLength, 15));
+        if (matchLength >= 15)
+            output = WriteLength(output, matchLength - 15);
+
+        return output;
+    }
+}
+
+size_t LZ4::Compress(const uint8_t* source, size_t sourceSize, uint8_t* destination, size_t destinationCapacity)
+{
+    // Worst case, checking it up front keeps the loop free of bounds checks
+    if (destinationCapacity < GetMaxCompressedSize(sourceSize))
+        return 0;
+
+    uint8_t* output = destination;
+    size_t anchor = 0;
+
+    if (sourceSize > Utils::MatchStartLimit)
+    {
+        // Positions plus one, so zero means empty
+        std::vector<uint32_t> table(1u << Utils::HashBits, 0);
+
+        const size_t matchStartLimit = sourceSize - Utils::MatchStartLimit;
+        const size_t matchEndLimit = sourceSize - Utils::LastLiterals;
+
+        size_t position = 0;
+        while (position < matchStartLimit)
+        {
+            const uint32_t sequence = Utils::Read32(source + position);
+            const uint32_t hash = Utils::HashSequence(sequence);
+            const size_t candidate = table[hash];
+            table[hash] = static_cast<uint32_t>(position + 1);
+
+            if (candidate == 0 || position - (candidate - 1) > MaxOffset || Utils::Read32(source + candidate - 1) != sequence)
+            {
+                // Skip faster through data that doesn't compress
+                position += 1 + ((position - anchor) >> 6);
+                continue;
+            }
+
+            const size_t matchPosition = candidate - 1;
+            size_t matchLength = Utils::MinMatch;
+            while (position + matchLength < matchEndLimit && source[matchPosition + matchLength] == source[position + matchLength])
+                ++matchLength;
+
+            output = Utils::WriteSequence(output, source + anchor, position - anchor, position - matchPosition, matchLength);
+            position += matchLength;
+            anchor = position;
+        }
+    }
+
+    output = Utils::WriteSequence(output, source + anchor, sourceSize - anchor, 0, 0);
+    return static_cast<size_t>(output - destination);
+}
+
+bool LZ4::Decompress(const uint8_t* source, size_t sourceSize, uint8_t* destination, size_t destinationSize)
+{
+    const uint8_t* input = source;
+    const uint8_t* inputEnd = source + sourceSize;
+    uint8_t* output = destination;
+    uint8_t* outputEnd = destination + destinationSize;
+
+    while (input < inputEnd)
+    {
+        const uint8_t token = *input++;
+
+        size_t literalCount = token >> 4;
+        if (literalCount == 15 && !Utils::ReadLength(input, inputEnd, literalCount))
+            return false;
+        if (literalCount > static_cast<size_t>(inputEnd - input) || literalCount > static_cast<size_t>(outputEnd - output))
+            return false;
+
+        if (literalCount > 0)
+            std::memcpy(output, input, literalCount);
+        input += literalCount;
+        output += literalCount;
+
+        if (input == inputEnd)
+            break;
+
+        if (inputEnd - input < 2)
+            return false;
+        const size_t offset = input[0] | (static_cast<size_t>(input[1]) << 8);
+        input += 2;
+        if (offset == 0 || offset > static_cast<size_t>(output - destination))
+            return false;
+
+        size_t matchLength = token & 15;
+        if (matchLength == 15 && !Utils::ReadLength(input, inputEnd, matchLength))
+            return false;
+        matchLength += Utils::MinMatch;
+        if (matchLength > static_cast<size_t>(outputEnd - output))
+            return false;
+
+        const uint8_t* match = output - offset;
+        if (offset >= matchLength)
+        {
+            std::memcpy(output, match, matchLength);
+            output += matchLength;
+        }
+        else
+        {
+            // Overlapping copies repeat the last offset bytes, they have to go front to back
+            for (size_t i = 0; i < matchLength; ++i)
+                *output++ = match[i];
+        }
+    }
+
+    return output == outputEnd;
+}
\ No newline at end of file
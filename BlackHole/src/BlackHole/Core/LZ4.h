@@ -0,0 +1,18 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+
+// LZ4 block format, compatible with the reference implementation's LZ4_compress_default and
+// LZ4_decompress_safe. The compressor is a plain greedy one, decompression speed is what matters for packs
+namespace LZ4
+{
+    // Matches can reach at most this far back, so blocks up to this size need no dictionary
+    constexpr size_t MaxOffset = 65535;
+
+    constexpr size_t GetMaxCompressedSize(size_t size) { return size + size / 255 + 16; }
+
+    // Returns the compressed size, 0 if it doesn't fit in the destination
+    size_t Compress(const uint8_t* source, size_t sourceSize, uint8_t* destination, size_t destinationCapacity);
+    // False for malformed input or when it doesn't decompress to exactly destinationSize bytes
+    bool Decompress(const uint8_t* source, size_t sourceSize, uint8_t* destination, size_t destinationSize);
+}
\ No newline at end of file
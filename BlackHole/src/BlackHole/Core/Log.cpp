@@ -1,20 +1,55 @@
 #include "bhpch.h"
 #include "BlackHole/Core/Log.h"
+#include "BlackHole/Core/AsyncLogSink.h"
 
-
-#include <spdlog/sinks/stdout_color_sinks-inl.h>
+#include <spdlog/sinks/rotating_file_sink.h>
+#include <spdlog/sinks/stdout_color_sinks.h>
 
 std::shared_ptr<spdlog::logger> Log::s_Logger = nullptr;
 
-void Log::Init()
+static std::shared_ptr<AsyncLogSink> s_AsyncSink;
+
+void Log::Init(const LogSpecification& specification)
 {
+    std::vector<spdlog::sink_ptr> sinks;
+    sinks.push_back(std::make_shared<spdlog::sinks::stdout_color_sink_mt>());
+    if (!specification.FilePath.empty())
+    {
+        sinks.push_back(std::make_shared<spdlog::sinks::rotating_file_sink_mt>(
+            specification.FilePath, specification.MaxFileSize, specification.MaxFiles));
+    }
+
+    if (specification.Async)
+    {
+        s_AsyncSink = std::make_shared<AsyncLogSink>(std::move(sinks), specification.QueueCapacity);
+        s_Logger = std::make_shared<spdlog::logger>("BLACK HOLE", s_AsyncSink);
+    }
+    else
+    {
+        s_Logger = std::make_shared<spdlog::logger>("BLACK HOLE", sinks.begin(), sinks.end());
+        s_Logger->flush_on(spdlog::level::warn);
+    }
+    spdlog::register_logger(s_Logger);
+
     spdlog::set_pattern("%^[%T] %n: %v%$");
     spdlog::set_level(spdlog::level::trace);
+}
 
-    s_Logger = spdlog::stdout_color_mt("BLACK HOLE");
+void Log::Shutdown()
+{
+    s_Logger->flush();
+    spdlog::drop_all();
+    s_Logger.reset();
+    // Joins the background thread, which writes what's left
+    s_AsyncSink.reset();
 }
 
 void Log::SetLogLevel(const spdlog::level::level_enum level)
 {
     spdlog::set_level(level);
 }
+
+uint64_t Log::GetDroppedCount()
+{
+    return s_AsyncSink ? s_AsyncSink->GetDroppedCount() : 0;
+}
\ No newline at end of file
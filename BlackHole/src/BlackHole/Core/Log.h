@@ -1,29 +1,76 @@
 #pragma once
 #include <spdlog/spdlog.h>
 
+struct LogSpecification
+{
+    // Writes from a background thread, otherwise every message is formatted and written on the calling thread
+    bool Async = true;
+    // Messages queued for the background thread, more than that in one go are dropped
+    uint32_t QueueCapacity = 8192;
+
+    // Rotated once it reaches MaxFileSize, keeping MaxFiles old logs. Empty to only log to the console
+    std::string FilePath = "BlackHole.log";
+    size_t MaxFileSize = 5 * 1024 * 1024;
+    size_t MaxFiles = 3;
+};
+
 class Log
 {
 public:
-    static void Init();
+    static void Init(const LogSpecification& specification = LogSpecification());
+    // Writes out everything still queued
+    static void Shutdown();
     static void SetLogLevel(spdlog::level::level_enum level);
     static std::shared_ptr<spdlog::logger>& GetLogger() { return s_Logger; }
 
+    // Messages lost to a full queue in async mode
+    static uint64_t GetDroppedCount();
+
 private:
     static std::shared_ptr<spdlog::logger> s_Logger;
 };
 
-#ifdef BH_DEBUG
+// Levels below BH_LOG_LEVEL aren't compiled in, it takes spdlog's SPDLOG_LEVEL_* values
+#ifndef BH_LOG_LEVEL
+    #ifdef BH_DEBUG
+        #define BH_LOG_LEVEL SPDLOG_LEVEL_TRACE
+    #else
+        #define BH_LOG_LEVEL SPDLOG_LEVEL_WARN
+    #endif
+#endif
+
+#if BH_LOG_LEVEL <= SPDLOG_LEVEL_TRACE
     #define BH_LOG_TRACE(...)       ::Log::GetLogger()->trace(__VA_ARGS__)
-    #define BH_LOG_DEBUG(...)       ::Log::GetLogger()->debug(__VA_ARGS__)
-    #define BH_LOG_INFO(...)        ::Log::GetLogger()->info(__VA_ARGS__)
-    #define BH_LOG_WARN(...)        ::Log::GetLogger()->warn(__VA_ARGS__)
-    #define BH_LOG_ERROR(...)       ::Log::GetLogger()->error(__VA_ARGS__)
-    #define BH_LOG_CRITICAL(...)    ::Log::GetLogger()->critical(__VA_ARGS__)
 #else
     #define BH_LOG_TRACE(...)
+#endif
+
+#if BH_LOG_LEVEL <= SPDLOG_LEVEL_DEBUG
+    #define BH_LOG_DEBUG(...)       ::Log::GetLogger()->debug(__VA_ARGS__)
+#else
     #define BH_LOG_DEBUG(...)
+#endif
+
+#if BH_LOG_LEVEL <= SPDLOG_LEVEL_INFO
+    #define BH_LOG_INFO(...)        ::Log::GetLogger()->info(__VA_ARGS__)
+#else
     #define BH_LOG_INFO(...)
+#endif
+
+#if BH_LOG_LEVEL <= SPDLOG_LEVEL_WARN
+    #define BH_LOG_WARN(...)        ::Log::GetLogger()->warn(__VA_ARGS__)
+#else
     #define BH_LOG_WARN(...)
+#endif
+
+#if BH_LOG_LEVEL <= SPDLOG_LEVEL_ERROR
+    #define BH_LOG_ERROR(...)       ::Log::GetLogger()->error(__VA_ARGS__)
+#else
     #define BH_LOG_ERROR(...)
+#endif
+
+#if BH_LOG_LEVEL <= SPDLOG_LEVEL_CRITICAL
+    #define BH_LOG_CRITICAL(...)    ::Log::GetLogger()->critical(__VA_ARGS__)
+#else
     #define BH_LOG_CRITICAL(...)
 #endif
\ No newline at end of file
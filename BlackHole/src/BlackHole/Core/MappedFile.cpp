@@ -0,0 +1,82 @@
+#include "bhpch.h"
+#include "BlackHole/Core/MappedFile.h"
+
+#ifdef _WIN32
+    #ifndef WIN32_LEAN_AND_MEAN
+        #define WIN32_LEAN_AND_MEAN
+    #endif
+    #ifndef NOMINMAX
+        #define NOMINMAX
+    #endif
+    #include <windows.h>
+#else
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
+#ifdef _WIN32
+
+MappedFile::MappedFile(const std::filesystem::path& filepath)
+{
+    m_FileHandle = CreateFileW(filepath.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (m_FileHandle == INVALID_HANDLE_VALUE)
+    {
+        m_FileHandle = nullptr;
+        return;
+    }
+
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(m_FileHandle, &size) || size.QuadPart == 0)
+        return;
+
+    m_MappingHandle = CreateFileMappingW(m_FileHandle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (!m_MappingHandle)
+        return;
+
+    m_Data = static_cast<const uint8_t*>(MapViewOfFile(m_MappingHandle, FILE_MAP_READ, 0, 0, 0));
+    if (m_Data)
+        m_Size = static_cast<uint64_t>(size.QuadPart);
+}
+
+MappedFile::~MappedFile()
+{
+    if (m_Data)
+        UnmapViewOfFile(m_Data);
+    if (m_MappingHandle)
+        CloseHandle(m_MappingHandle);
+    if (m_FileHandle)
+        CloseHandle(m_FileHandle);
+}
+
+#else
+
+MappedFile::MappedFile(const std::filesystem::path& filepath)
+{
+    const int file = open(filepath.c_str(), O_RDONLY);
+    if (file < 0)
+        return;
+
+    struct stat status;
+    if (fstat(file, &status) == 0 && status.st_size > 0)
+    {
+        void* data = mmap(nullptr, static_cast<size_t>(status.st_size), PROT_READ, MAP_PRIVATE, file, 0);
+        if (data != MAP_FAILED)
+        {
+            m_Data = static_cast<const uint8_t*>(data);
+            m_Size = static_cast<uint64_t>(status.st_size);
+        }
+    }
+
+    // The mapping keeps the file alive
+    close(file);
+}
+
+MappedFile::~MappedFile()
+{
+    if (m_Data)
+        munmap(const_cast<uint8_t*>(m_Data), static_cast<size_t>(m_Size));
+}
+
+#endif
\ No newline at end of file
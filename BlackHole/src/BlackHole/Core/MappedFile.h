@@ -0,0 +1,25 @@
+#pragma once
+#include <filesystem>
+
+// Read-only memory mapping of a whole file, pages are read in by the OS as they're touched
+class MappedFile
+{
+public:
+    explicit MappedFile(const std::filesystem::path& filepath);
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    bool IsOpen() const { return m_Data != nullptr; }
+
+    const uint8_t* GetData() const { return m_Data; }
+    uint64_t GetSize() const { return m_Size; }
+private:
+    const uint8_t* m_Data = nullptr;
+    uint64_t m_Size = 0;
+#ifdef _WIN32
+    void* m_FileHandle = nullptr;
+    void* m_MappingHandle = nullptr;
+#endif
+};
\ No newline at end of file
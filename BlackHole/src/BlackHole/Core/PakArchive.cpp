@@ -0,0 +1,316 @@
+#include "bhpch.h"
+#include "BlackHole/Core/PakArchive.h"
+
+#include "BlackHole/Core/Hash.h"
+#include "BlackHole/Core/LZ4.h"
+
+static constexpr uint32_t s_FileMagic = 0x4B504842; // "BHPK"
+// Bump when the file layout or the path hash changes
+static constexpr uint32_t s_FileVersion = 1;
+// Stored files start on this boundary, so they can be used in place
+static constexpr uint64_t s_DataAlignment = 16;
+
+// The table of contents follows the file data: entries sorted by path hash, blocks, then the paths
+struct PakFileHeader
+{
+    uint32_t Magic;
+    uint32_t Version;
+    uint32_t EntryCount;
+    uint32_t BlockCount;
+    uint64_t EntriesOffset;
+    uint64_t BlocksOffset;
+    uint64_t PathsOffset;
+    uint64_t PathsSize;
+};
+
+namespace Utils
+{
+    static std::vector<uint8_t> ReadLooseFile(const std::filesystem::path& filepath)
+    {
+        std::ifstream file(filepath, std::ios::in | std::ios::binary);
+        if (!file.is_open())
+            return {};
+
+        file.seekg(0, std::ios::end);
+        std::vector<uint8_t> bytes(static_cast<size_t>(file.tellg()));
+        file.seekg(0, std::ios::beg);
+        file.read(reinterpret_cast<char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+        return bytes;
+    }
+
+    static bool IsInRange(uint64_t offset, uint64_t size, uint64_t fileSize)
+    {
+        return offset <= fileSize && size <= fileSize - offset;
+    }
+}
+
+PakArchive::PakArchive(const std::filesystem::path& filepath)
+    : m_Filepath(filepath), m_File(CreateRef<MappedFile>(filepath))
+{
+    if (!m_File->IsOpen())
+        return;
+
+    const uint64_t fileSize = m_File->GetSize();
+    PakFileHeader header = {};
+    if (fileSize < sizeof(header))
+    {
+        BH_LOG_ERROR("'{0}' is too small to be a pack", filepath.string());
+        return;
+    }
+
+    std::memcpy(&header, m_File->GetData(), sizeof(header));
+    if (header.Magic != s_FileMagic || header.Version != s_FileVersion)
+    {
+        BH_LOG_ERROR("'{0}' is not a version {1} pack", filepath.string(), s_FileVersion);
+        return;
+    }
+
+    if (!Utils::IsInRange(header.EntriesOffset, static_cast<uint64_t>(header.EntryCount) * sizeof(Entry), fileSize) ||
+        !Utils::IsInRange(header.BlocksOffset, static_cast<uint64_t>(header.BlockCount) * sizeof(Block), fileSize) ||
+        !Utils::IsInRange(header.PathsOffset, header.PathsSize, fileSize))
+    {
+        BH_LOG_ERROR("Pack '{0}' is truncated", filepath.string());
+        return;
+    }
+
+    m_Entries.resize(header.EntryCount);
+    std::memcpy(m_Entries.data(), m_File->GetData() + header.EntriesOffset, m_Entries.size() * sizeof(Entry));
+    m_Blocks.resize(header.BlockCount);
+    std::memcpy(m_Blocks.data(), m_File->GetData() + header.BlocksOffset, m_Blocks.size() * sizeof(Block));
+    m_Paths = std::string_view(reinterpret_cast<const char*>(m_File->GetData() + header.PathsOffset), header.PathsSize);
+
+    for (const Entry& entry : m_Entries)
+    {
+        const bool isValid = entry.BlockCount == 0
+            ? Utils::IsInRange(entry.Offset, entry.Size, fileSize)
+            : Utils::IsInRange(entry.FirstBlock, entry.BlockCount, m_Blocks.size());
+        if (!isValid || !Utils::IsInRange(entry.PathOffset, entry.PathSize, m_Paths.size()))
+        {
+            BH_LOG_ERROR("Pack '{0}' has an entry out of its bounds", filepath.string());
+            return;
+        }
+    }
+
+    for (const Block& block : m_Blocks)
+    {
+        if (!Utils::IsInRange(block.Offset, block.StoredSize, fileSize) || block.Size > BlockSize)
+        {
+            BH_LOG_ERROR("Pack '{0}' has a block out of its bounds", filepath.string());
+            return;
+        }
+    }
+
+    m_IsValid = true;
+}
+
+const PakArchive::Entry* PakArchive::Find(std::string_view path) const
+{
+    const uint64_t hash = Hash::FNV1a64(path);
+    const auto [first, last] = std::ranges::equal_range(m_Entries, hash, {}, &Entry::PathHash);
+    for (auto it = first; it != last; ++it)
+    {
+        if (GetPath(*it) == path)
+            return &*it;
+    }
+    return nullptr;
+}
+
+FileData PakArchive::Read(const Entry& entry, ThreadPool* threadPool) const
+{
+    BH_PROFILE_FUNCTION();
+
+    if (entry.BlockCount == 0)
+        return FileData(m_File->GetData() + entry.Offset, entry.Size, m_File);
+
+    std::vector<uint8_t> bytes(entry.Size);
+    std::atomic<bool> isCorrupt = false;
+    const auto readBlock = [&](uint32_t index)
+    {
+        const Block& block = m_Blocks[entry.FirstBlock + index];
+        const uint64_t offset = static_cast<uint64_t>(index) * BlockSize;
+        if (offset >= bytes.size() || block.Size != std::min<uint64_t>(BlockSize, bytes.size() - offset))
+        {
+            isCorrupt = true;
+            return;
+        }
+
+        const uint8_t* source = m_File->GetData() + block.Offset;
+        if (block.StoredSize == block.Size)
+            std::memcpy(bytes.data() + offset, source, block.Size);
+        else if (!LZ4::Decompress(source, block.StoredSize, bytes.data() + offset, block.Size))
+            isCorrupt = true;
+    };
+
+    if (threadPool && entry.BlockCount > 1)
+    {
+        threadPool->ParallelFor(entry.BlockCount, readBlock);
+    }
+    else
+    {
+        for (uint32_t i = 0; i < entry.BlockCount; ++i)
+            readBlock(i);
+    }
+
+    if (isCorrupt)
+    {
+        BH_LOG_ERROR("'{0}' is corrupt in pack '{1}'", GetPath(entry), m_Filepath.string());
+        return {};
+    }
+    return FileData(std::move(bytes));
+}
+
+std::string_view PakArchive::GetPath(const Entry& entry) const
+{
+    return m_Paths.substr(entry.PathOffset, entry.PathSize);
+}
+
+bool PakArchive::Build(const std::filesystem::path& directory, const std::filesystem::path& filepath, ThreadPool& threadPool)
+{
+    BH_PROFILE_FUNCTION();
+
+    std::vector<std::filesystem::path> files;
+    std::error_code error;
+    for (const auto& directoryEntry : std::filesystem::recursive_directory_iterator(directory, error))
+    {
+        if (directoryEntry.is_regular_file() && directoryEntry.path().extension() != ".bhpak")
+            files.push_back(directoryEntry.path());
+    }
+    if (error)
+    {
+        BH_LOG_ERROR("Could not list '{0}' for packing: {1}", directory.string(), error.message());
+        return false;
+    }
+    // Same input, same pack
+    std::ranges::sort(files);
+
+    // Written next to the pack and moved over it once complete, so a failed build leaves the old pack intact
+    std::filesystem::path tempPath = filepath;
+    tempPath += ".tmp";
+
+    std::ofstream output(tempPath, std::ios::out | std::ios::binary | std::ios::trunc);
+    if (!output.is_open())
+    {
+        BH_LOG_ERROR("Could not create pack '{0}'", tempPath.string());
+        return false;
+    }
+
+    PakFileHeader header = {};
+    output.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    uint64_t offset = sizeof(header);
+
+    std::vector<Entry> entries;
+    std::vector<Block> blocks;
+    std::string paths;
+    entries.reserve(files.size());
+
+    // Only logged, which Release builds compile out
+    [[maybe_unused]] uint64_t totalSize = 0;
+    std::vector<std::vector<uint8_t>> compressedBlocks;
+    for (const auto& file : files)
+    {
+        const std::vector<uint8_t> bytes = Utils::ReadLooseFile(file);
+        const std::string path = file.lexically_relative(directory).generic_string();
+
+        Entry entry = {};
+        entry.PathHash = Hash::FNV1a64(path);
+        entry.Size = bytes.size();
+        entry.WriteTime = std::filesystem::last_write_time(file, error).time_since_epoch().count();
+        entry.PathOffset = static_cast<uint32_t>(paths.size());
+        entry.PathSize = static_cast<uint32_t>(path.size());
+        paths += path;
+
+        const uint32_t blockCount = static_cast<uint32_t>((bytes.size() + BlockSize - 1) / BlockSize);
+        const auto getBlockSize = [&bytes](uint32_t index) { return std::min<size_t>(BlockSize, bytes.size() - static_cast<size_t>(index) * BlockSize); };
+
+        compressedBlocks.resize(blockCount);
+        threadPool.ParallelFor(blockCount, [&](uint32_t index)
+        {
+            const size_t size = getBlockSize(index);
+            std::vector<uint8_t>& compressed = compressedBlocks[index];
+            compressed.resize(LZ4::GetMaxCompressedSize(size));
+            compressed.resize(LZ4::Compress(bytes.data() + static_cast<size_t>(index) * BlockSize, size, compressed.data(), compressed.size()));
+        });
+
+        uint64_t compressedSize = 0;
+        for (uint32_t i = 0; i < blockCount; ++i)
+            compressedSize += std::min(compressedBlocks[i].size(), getBlockSize(i));
+
+        // Already compressed formats, such as PNG, barely shrink and are worth more served in place
+        if (compressedSize < bytes.size() - bytes.size() / 8)
+        {
+            entry.FirstBlock = static_cast<uint32_t>(blocks.size());
+            entry.BlockCount = blockCount;
+            for (uint32_t i = 0; i < blockCount; ++i)
+            {
+                Block block = {};
+                block.Offset = offset;
+                block.Size = static_cast<uint32_t>(getBlockSize(i));
+
+                if (compressedBlocks[i].size() < block.Size)
+                {
+                    block.StoredSize = static_cast<uint32_t>(compressedBlocks[i].size());
+                    output.write(reinterpret_cast<const char*>(compressedBlocks[i].data()), block.StoredSize);
+                }
+                else
+                {
+                    block.StoredSize = block.Size;
+                    output.write(reinterpret_cast<const char*>(bytes.data() + static_cast<size_t>(i) * BlockSize), block.StoredSize);
+                }
+                offset += block.StoredSize;
+                blocks.push_back(block);
+            }
+        }
+        else
+        {
+            const uint64_t padding = (s_DataAlignment - offset % s_DataAlignment) % s_DataAlignment;
+            const std::array<char, s_DataAlignment> zeros = {};
+            output.write(zeros.data(), static_cast<std::streamsize>(padding));
+            offset += padding;
+
+            entry.Offset = offset;
+            output.write(reinterpret_cast<const char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+            offset += bytes.size();
+        }
+
+        totalSize += entry.Size;
+        entries.push_back(entry);
+    }
+
+    std::ranges::sort(entries, {}, &Entry::PathHash);
+
+    header.Magic = s_FileMagic;
+    header.Version = s_FileVersion;
+    header.EntryCount = static_cast<uint32_t>(entries.size());
+    header.BlockCount = static_cast<uint32_t>(blocks.size());
+    header.EntriesOffset = offset;
+    header.BlocksOffset = header.EntriesOffset + entries.size() * sizeof(Entry);
+    header.PathsOffset = header.BlocksOffset + blocks.size() * sizeof(Block);
+    header.PathsSize = paths.size();
+
+    output.write(reinterpret_cast<const char*>(entries.data()), static_cast<std::streamsize>(entries.size() * sizeof(Entry)));
+    output.write(reinterpret_cast<const char*>(blocks.data()), static_cast<std::streamsize>(blocks.size() * sizeof(Block)));
+    output.write(paths.data(), static_cast<std::streamsize>(paths.size()));
+    output.seekp(0);
+    output.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    output.close();
+
+    if (!output)
+    {
+        BH_LOG_ERROR("Could not write pack '{0}'", tempPath.string());
+        std::filesystem::remove(tempPath, error);
+        return false;
+    }
+
+    // Fails on Windows while the old pack is still mapped
+    std::filesystem::rename(tempPath, filepath, error);
+    if (error)
+    {
+        BH_LOG_ERROR("Could not replace pack '{0}': {1}", filepath.string(), error.message());
+        std::filesystem::remove(tempPath, error);
+        return false;
+    }
+
+    BH_LOG_INFO("Packed {0} files from '{1}' into '{2}', {3:.1f} MiB stored as {4:.1f} MiB", entries.size(), directory.string(),
+        filepath.string(), static_cast<double>(totalSize) / (1024.0 * 1024.0), static_cast<double>(offset - sizeof(header)) / (1024.0 * 1024.0));
+    return true;
+}
\ No newline at end of file
@@ -0,0 +1,64 @@
+#pragma once
+#include <filesystem>
+
+#include "BlackHole/Core/FileData.h"
+#include "BlackHole/Core/MappedFile.h"
+#include "BlackHole/Core/ThreadPool.h"
+
+// Many files in one read-only .bhpak archive, so loading assets from a cold cache costs a few large
+// reads instead of thousands of small ones. Files are found by a hash of their path in a sorted table
+// of contents. Files that compress are split into 64 KiB LZ4 blocks which decompress independently,
+// the rest are stored as is and served straight from the mapped archive
+class PakArchive
+{
+public:
+    static constexpr uint32_t BlockSize = 64 * 1024;
+
+    struct Entry
+    {
+        uint64_t PathHash;
+        uint64_t Offset;
+        uint64_t Size;
+        // file_time_type ticks of the file when it was packed
+        int64_t WriteTime;
+        // Stored uncompressed when BlockCount is 0
+        uint32_t FirstBlock;
+        uint32_t BlockCount;
+        uint32_t PathOffset;
+        uint32_t PathSize;
+    };
+
+    struct Block
+    {
+        uint64_t Offset;
+        // Blocks that didn't compress are stored as is, with StoredSize equal to Size
+        uint32_t StoredSize;
+        uint32_t Size;
+    };
+
+    explicit PakArchive(const std::filesystem::path& filepath);
+
+    // False when the file is missing or isn't a pack this version can read
+    bool IsValid() const { return m_IsValid; }
+
+    // Path relative to the packed directory, with forward slashes
+    const Entry* Find(std::string_view path) const;
+    // Decompresses the blocks across the thread pool when one is given
+    FileData Read(const Entry& entry, ThreadPool* threadPool = nullptr) const;
+
+    std::string_view GetPath(const Entry& entry) const;
+    const std::vector<Entry>& GetEntries() const { return m_Entries; }
+    const std::filesystem::path& GetFilepath() const { return m_Filepath; }
+
+    // Packs every file below the directory, except other packs. An existing pack at the filepath is
+    // replaced only once the new one is complete and must not be mounted
+    static bool Build(const std::filesystem::path& directory, const std::filesystem::path& filepath, ThreadPool& threadPool);
+private:
+    std::filesystem::path m_Filepath;
+    Ref<MappedFile> m_File;
+
+    std::vector<Entry> m_Entries;
+    std::vector<Block> m_Blocks;
+    std::string_view m_Paths;
+    bool m_IsValid = false;
+};
\ No newline at end of file
@@ -0,0 +1,172 @@
+#include "bhpch.h"
+#include "BlackHole/Core/Profiler.h"
+
+#include <mutex>
+
+static constexpr uint32_t s_MaxEventsPerThread = 1 << 16;
+
+namespace
+{
+    struct ProfileEvent
+    {
+        const char* Name;
+        int64_t Start;
+        int64_t Duration;
+    };
+
+    // Written only by its thread; the session owner reads up to Count, which is published after each event
+    struct ThreadEventBuffer
+    {
+        std::unique_ptr<ProfileEvent[]> Events = std::make_unique<ProfileEvent[]>(s_MaxEventsPerThread);
+        std::atomic<uint32_t> Count = 0;
+        std::atomic<uint32_t> Dropped = 0;
+        // The owning thread clears the buffer itself when it first records into a new session
+        std::atomic<uint32_t> SessionID = 0;
+        uint32_t ThreadID = 0;
+    };
+
+    struct ProfilerData
+    {
+        std::mutex Mutex;
+        // Buffers outlive their threads, so a session can still read events of threads that have exited
+        std::vector<std::unique_ptr<ThreadEventBuffer>> Buffers;
+        std::atomic<uint32_t> SessionID = 0;
+
+        std::string SessionName;
+        std::filesystem::path SessionPath;
+        std::chrono::steady_clock::time_point SessionStart;
+
+        uint32_t CaptureFramesLeft = 0;
+    };
+}
+
+static ProfilerData s_Data;
+std::atomic<bool> Profiler::s_IsSessionActive = false;
+
+namespace Utils
+{
+    static ThreadEventBuffer& GetThreadEventBuffer()
+    {
+        thread_local ThreadEventBuffer* buffer = nullptr;
+        if (!buffer)
+        {
+            std::scoped_lock lock(s_Data.Mutex);
+            auto& newBuffer = s_Data.Buffers.emplace_back(std::make_unique<ThreadEventBuffer>());
+            newBuffer->ThreadID = static_cast<uint32_t>(s_Data.Buffers.size());
+            buffer = newBuffer.get();
+        }
+        return *buffer;
+    }
+
+    static void WriteEscaped(std::ostream& stream, const char* text)
+    {
+        for (; *text; ++text)
+        {
+            if (*text == '"' || *text == '\\')
+                stream << '\\';
+            stream << *text;
+        }
+    }
+}
+
+void Profiler::BeginSession(std::string_view name, const std::filesystem::path& filepath)
+{
+    if (IsSessionActive())
+    {
+        BH_LOG_WARN("Profiler session '{0}' started while '{1}' is still running, ending it", name, s_Data.SessionName);
+        EndSession();
+    }
+
+    s_Data.SessionName = name;
+    s_Data.SessionPath = filepath;
+    s_Data.SessionStart = std::chrono::steady_clock::now();
+    s_Data.SessionID.fetch_add(1, std::memory_order_release);
+    s_IsSessionActive.store(true, std::memory_order_release);
+}
+
+void Profiler::EndSession()
+{
+    if (!IsSessionActive())
+        return;
+
+    s_IsSessionActive.store(false, std::memory_order_release);
+    s_Data.CaptureFramesLeft = 0;
+
+    std::ofstream stream(s_Data.SessionPath);
+    if (!stream)
+    {
+        BH_LOG_ERROR("Could not write profile to {0}", s_Data.SessionPath.string());
+        return;
+    }
+
+    stream << "{\"otherData\":{},\"traceEvents\":[";
+
+    uint32_t eventCount = 0, droppedCount = 0;
+    const uint32_t sessionID = s_Data.SessionID.load(std::memory_order_acquire);
+    std::scoped_lock lock(s_Data.Mutex);
+    for (const auto& buffer : s_Data.Buffers)
+    {
+        if (buffer->SessionID.load(std::memory_order_acquire) != sessionID)
+            continue;
+
+        const uint32_t count = buffer->Count.load(std::memory_order_acquire);
+        for (uint32_t i = 0; i < count; ++i)
+        {
+            const ProfileEvent& event = buffer->Events[i];
+            stream << (eventCount++ ? "," : "") << "\n{\"cat\":\"function\",\"name\":\"";
+            Utils::WriteEscaped(stream, event.Name);
+            stream << "\",\"ph\":\"X\",\"pid\":0,\"tid\":" << buffer->ThreadID
+                   << ",\"ts\":" << static_cast<double>(event.Start) * 0.001
+                   << ",\"dur\":" << static_cast<double>(event.Duration) * 0.001 << "}";
+        }
+        droppedCount += buffer->Dropped.load(std::memory_order_relaxed);
+    }
+
+    stream << "\n]}";
+
+    if (droppedCount)
+        BH_LOG_WARN("Profiler dropped {0} events, thread buffers were full", droppedCount);
+    BH_LOG_INFO("Profile '{0}' with {1} events written to {2}", s_Data.SessionName, eventCount, s_Data.SessionPath.string());
+}
+
+void Profiler::CaptureFrames(uint32_t frameCount, const std::filesystem::path& filepath)
+{
+    if (IsSessionActive() || frameCount == 0)
+        return;
+
+    BeginSession("Frames", filepath);
+    s_Data.CaptureFramesLeft = frameCount;
+}
+
+void Profiler::EndFrame()
+{
+    if (s_Data.CaptureFramesLeft > 0 && --s_Data.CaptureFramesLeft == 0)
+        EndSession();
+}
+
+void Profiler::RecordEvent(const char* name, std::chrono::steady_clock::time_point start, std::chrono::steady_clock::time_point end)
+{
+    ThreadEventBuffer& buffer = Utils::GetThreadEventBuffer();
+
+    const uint32_t sessionID = s_Data.SessionID.load(std::memory_order_acquire);
+    if (buffer.SessionID.load(std::memory_order_relaxed) != sessionID)
+    {
+        buffer.Count.store(0, std::memory_order_relaxed);
+        buffer.Dropped.store(0, std::memory_order_relaxed);
+        buffer.SessionID.store(sessionID, std::memory_order_release);
+    }
+
+    const uint32_t index = buffer.Count.load(std::memory_order_relaxed);
+    if (index >= s_MaxEventsPerThread)
+    {
+        buffer.Dropped.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    buffer.Events[index] = {
+        name,
+        std::chrono::duration_cast<std::chrono::nanoseconds>(start - s_Data.SessionStart).count(),
+        std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count()
+    };
+    buffer.Count.store(index + 1, std::memory_order_release);
+}
\ No newline at end of file
@@ -0,0 +1,70 @@
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <filesystem>
+
+#include "BlackHole/Core/Base.h"
+
+// CPU profiler writing Chrome trace event JSON, viewable in chrome://tracing or Perfetto.
+// Every thread records into a buffer only it writes to, so recording takes no locks;
+// without a session a scope costs one atomic load, and without BH_ENABLE_PROFILING nothing at all
+class Profiler
+{
+public:
+    static void BeginSession(std::string_view name, const std::filesystem::path& filepath);
+    // Writes the events recorded since BeginSession
+    static void EndSession();
+
+    static bool IsSessionActive() { return s_IsSessionActive.load(std::memory_order_relaxed); }
+
+    // Records the next frames into the file, ignored while another session is running
+    static void CaptureFrames(uint32_t frameCount, const std::filesystem::path& filepath);
+    // Ends a frame capture once its frames have passed
+    static void EndFrame();
+
+    // Name must outlive the session, string literals and function signatures do
+    static void RecordEvent(const char* name, std::chrono::steady_clock::time_point start, std::chrono::steady_clock::time_point end);
+private:
+    static std::atomic<bool> s_IsSessionActive;
+};
+
+class ProfileScope
+{
+public:
+    explicit ProfileScope(const char* name)
+        : m_Name(name)
+    {
+        if (Profiler::IsSessionActive())
+            m_Start = std::chrono::steady_clock::now();
+    }
+
+    ~ProfileScope()
+    {
+        if (m_Start != std::chrono::steady_clock::time_point() && Profiler::IsSessionActive())
+            Profiler::RecordEvent(m_Name, m_Start, std::chrono::steady_clock::now());
+    }
+
+    ProfileScope(const ProfileScope&) = delete;
+    ProfileScope& operator=(const ProfileScope&) = delete;
+private:
+    const char* m_Name;
+    std::chrono::steady_clock::time_point m_Start;
+};
+
+#ifdef BH_ENABLE_PROFILING
+    #if defined(_MSC_VER)
+        #define BH_FUNCTION_SIGNATURE __FUNCSIG__
+    #else
+        #define BH_FUNCTION_SIGNATURE __PRETTY_FUNCTION__
+    #endif
+
+    #define BH_PROFILE_BEGIN_SESSION(name, filepath) Profiler::BeginSession(name, filepath)
+    #define BH_PROFILE_END_SESSION() Profiler::EndSession()
+    #define BH_PROFILE_SCOPE(name) const ProfileScope BH_CONCAT(profileScope, __LINE__)(name)
+    #define BH_PROFILE_FUNCTION() BH_PROFILE_SCOPE(BH_FUNCTION_SIGNATURE)
+#else
+    #define BH_PROFILE_BEGIN_SESSION(name, filepath)
+    #define BH_PROFILE_END_SESSION()
+    #define BH_PROFILE_SCOPE(name)
+    #define BH_PROFILE_FUNCTION()
+#endif
\ No newline at end of file
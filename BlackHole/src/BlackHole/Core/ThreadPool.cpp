@@ -0,0 +1,97 @@
+#include "bhpch.h"
+#include "BlackHole/Core/ThreadPool.h"
+
+ThreadPool::ThreadPool(uint32_t threadCount)
+{
+    m_Threads.reserve(threadCount);
+    for (uint32_t i = 0; i < threadCount; ++i)
+        m_Threads.emplace_back(&ThreadPool::WorkerLoop, this);
+}
+
+ThreadPool::~ThreadPool()
+{
+    {
+        std::scoped_lock lock(m_Mutex);
+        m_Stopping = true;
+    }
+    m_JobAvailable.notify_all();
+
+    for (auto& thread : m_Threads)
+        thread.join();
+}
+
+void ThreadPool::Enqueue(std::function<void()> job)
+{
+    {
+        std::scoped_lock lock(m_Mutex);
+        m_Jobs.push(std::move(job));
+    }
+    m_JobAvailable.notify_one();
+}
+
+void ThreadPool::ParallelFor(uint32_t count, const std::function<void(uint32_t)>& function)
+{
+    BH_PROFILE_FUNCTION();
+
+    if (count == 0)
+        return;
+
+    // Shared with the helper jobs, which may only get to run after the last index is done
+    struct ParallelForState
+    {
+        const std::function<void(uint32_t)>* Function;
+        uint32_t Count;
+        std::atomic<uint32_t> NextIndex = 0;
+        std::atomic<uint32_t> Remaining;
+
+        std::mutex Mutex;
+        std::condition_variable Done;
+    };
+
+    const auto state = std::make_shared<ParallelForState>();
+    state->Function = &function;
+    state->Count = count;
+    state->Remaining = count;
+
+    const auto runIndices = [](ParallelForState& s)
+    {
+        for (uint32_t index = s.NextIndex++; index < s.Count; index = s.NextIndex++)
+        {
+            (*s.Function)(index);
+            if (--s.Remaining == 0)
+            {
+                std::scoped_lock lock(s.Mutex);
+                s.Done.notify_all();
+            }
+        }
+    };
+
+    const uint32_t helperCount = std::min(count - 1, GetThreadCount());
+    for (uint32_t i = 0; i < helperCount; ++i)
+        Enqueue([state, runIndices]() { runIndices(*state); });
+
+    runIndices(*state);
+
+    std::unique_lock lock(state->Mutex);
+    state->Done.wait(lock, [&state]() { return state->Remaining == 0; });
+}
+
+void ThreadPool::WorkerLoop()
+{
+    while (true)
+    {
+        std::function<void()> job;
+        {
+            std::unique_lock lock(m_Mutex);
+            m_JobAvailable.wait(lock, [this]() { return m_Stopping || !m_Jobs.empty(); });
+            if (m_Stopping && m_Jobs.empty())
+                return;
+
+            job = std::move(m_Jobs.front());
+            m_Jobs.pop();
+        }
+
+        BH_PROFILE_SCOPE("ThreadPool Job");
+        job();
+    }
+}
\ No newline at end of file
@@ -0,0 +1,33 @@
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <queue>
+#include <thread>
+
+class ThreadPool
+{
+public:
+    // One thread is left for the caller, which helps out in ParallelFor
+    explicit ThreadPool(uint32_t threadCount = std::max(std::thread::hardware_concurrency(), 2u) - 1);
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    void Enqueue(std::function<void()> job);
+
+    // Calls function for every index in [0, count) across the workers and the calling thread, returns once all calls finished
+    void ParallelFor(uint32_t count, const std::function<void(uint32_t)>& function);
+
+    uint32_t GetThreadCount() const { return static_cast<uint32_t>(m_Threads.size()); }
+private:
+    void WorkerLoop();
+private:
+    std::vector<std::thread> m_Threads;
+    std::queue<std::function<void()>> m_Jobs;
+
+    std::mutex m_Mutex;
+    std::condition_variable m_JobAvailable;
+    bool m_Stopping = false;
+};
\ No newline at end of file
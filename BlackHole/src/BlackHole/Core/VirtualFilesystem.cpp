@@ -0,0 +1,146 @@
+#include "bhpch.h"
+#include "BlackHole/Core/VirtualFilesystem.h"
+
+#include "BlackHole/Core/PakArchive.h"
+
+#include <shared_mutex>
+
+struct MountPoint
+{
+    Ref<PakArchive> Archive;
+    std::filesystem::path Root;
+};
+
+struct VirtualFilesystemData
+{
+    std::vector<MountPoint> MountPoints;
+    // Lets the editor swap a rebuilt pack in while loads are in flight
+    std::shared_mutex MountMutex;
+    // Decompresses the blocks of large files, created with the first mount and kept until shutdown
+    Scope<ThreadPool> Workers;
+    std::atomic<bool> PreferNewerLooseFiles = false;
+} static s_Data;
+
+namespace Utils
+{
+    // The archive is handed out so the entry outlives an unmount
+    static const PakArchive::Entry* FindPacked(const std::filesystem::path& path, Ref<PakArchive>& archive)
+    {
+        std::shared_lock lock(s_Data.MountMutex);
+        if (s_Data.MountPoints.empty())
+            return nullptr;
+
+        const std::filesystem::path normalPath = path.lexically_normal();
+        for (auto it = s_Data.MountPoints.rbegin(); it != s_Data.MountPoints.rend(); ++it)
+        {
+            const std::filesystem::path relativePath = normalPath.lexically_relative(it->Root);
+            if (relativePath.empty() || *relativePath.begin() == "..")
+                continue;
+
+            const PakArchive::Entry* entry = it->Archive->Find(relativePath.generic_string());
+            if (!entry)
+                continue;
+
+            // A loose file edited since packing shadows its packed copy, so edits and hot reload see it
+            if (s_Data.PreferNewerLooseFiles.load(std::memory_order_relaxed))
+            {
+                std::error_code error;
+                const auto looseWriteTime = std::filesystem::last_write_time(path, error);
+                if (!error && looseWriteTime.time_since_epoch().count() > entry->WriteTime)
+                    continue;
+            }
+
+            archive = it->Archive;
+            return entry;
+        }
+        return nullptr;
+    }
+}
+
+bool VirtualFilesystem::Mount(const std::filesystem::path& packPath, const std::filesystem::path& root)
+{
+    BH_PROFILE_FUNCTION();
+
+    auto archive = CreateRef<PakArchive>(packPath);
+    if (!archive->IsValid())
+        return false;
+
+    BH_LOG_INFO("Mounted pack '{0}' with {1} files at '{2}'", packPath.string(), archive->GetEntries().size(), root.string());
+
+    std::unique_lock lock(s_Data.MountMutex);
+    if (!s_Data.Workers)
+        s_Data.Workers = CreateScope<ThreadPool>();
+    s_Data.MountPoints.push_back({ std::move(archive), root.lexically_normal() });
+    return true;
+}
+
+void VirtualFilesystem::UnmountAll()
+{
+    std::unique_lock lock(s_Data.MountMutex);
+    s_Data.MountPoints.clear();
+}
+
+void VirtualFilesystem::SetPreferNewerLooseFiles(bool prefer)
+{
+    s_Data.PreferNewerLooseFiles.store(prefer, std::memory_order_relaxed);
+}
+
+uint32_t VirtualFilesystem::GetMountCount()
+{
+    std::shared_lock lock(s_Data.MountMutex);
+    return static_cast<uint32_t>(s_Data.MountPoints.size());
+}
+
+bool VirtualFilesystem::Exists(const std::filesystem::path& path)
+{
+    Ref<PakArchive> archive;
+    if (Utils::FindPacked(path, archive))
+        return true;
+
+    std::error_code error;
+    return std::filesystem::is_regular_file(path, error);
+}
+
+bool VirtualFilesystem::IsPacked(const std::filesystem::path& path)
+{
+    Ref<PakArchive> archive;
+    return Utils::FindPacked(path, archive) != nullptr;
+}
+
+FileData VirtualFilesystem::ReadFile(const std::filesystem::path& path)
+{
+    Ref<PakArchive> archive;
+    if (const PakArchive::Entry* entry = Utils::FindPacked(path, archive))
+        return archive->Read(*entry, s_Data.Workers.get());
+
+    std::ifstream file(path, std::ios::in | std::ios::binary);
+    if (!file.is_open())
+    {
+        BH_LOG_ERROR("Could not open file '{0}'", path.string());
+        return {};
+    }
+
+    file.seekg(0, std::ios::end);
+    const std::streamoff size = file.tellg();
+    if (size < 0)
+    {
+        BH_LOG_ERROR("Could not read from file '{0}'", path.string());
+        return {};
+    }
+
+    std::vector<uint8_t> bytes(static_cast<size_t>(size));
+    file.seekg(0, std::ios::beg);
+    file.read(reinterpret_cast<char*>(bytes.data()), size);
+    return FileData(std::move(bytes));
+}
+
+std::filesystem::file_time_type VirtualFilesystem::GetLastWriteTime(const std::filesystem::path& path, std::error_code& error)
+{
+    Ref<PakArchive> archive;
+    if (const PakArchive::Entry* entry = Utils::FindPacked(path, archive))
+    {
+        error.clear();
+        return std::filesystem::file_time_type(std::filesystem::file_time_type::duration(entry->WriteTime));
+    }
+    return std::filesystem::last_write_time(path, error);
+}
\ No newline at end of file
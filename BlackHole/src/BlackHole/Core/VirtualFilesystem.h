@@ -0,0 +1,27 @@
+#pragma once
+#include <filesystem>
+
+#include "BlackHole/Core/FileData.h"
+
+// Reads files from mounted packs or loose from disk, so loaders don't need to know where assets live.
+// Paths are regular paths, a file below a pack's root is read from the pack and from disk when no pack has it
+class VirtualFilesystem
+{
+public:
+    // Files below the root are found in the pack by their path relative to it. Later mounts take
+    // precedence
+    static bool Mount(const std::filesystem::path& packPath, const std::filesystem::path& root);
+    // Files already read from a pack keep it mapped until they're released
+    static void UnmountAll();
+    static uint32_t GetMountCount();
+    // For tools editing the assets: a loose file written after it was packed is read instead of its packed copy.
+    // Off by default, as it costs a file status lookup per packed file
+    static void SetPreferNewerLooseFiles(bool prefer);
+
+    static bool Exists(const std::filesystem::path& path);
+    // Whether the file is read from a mounted pack rather than from disk
+    static bool IsPacked(const std::filesystem::path& path);
+    static FileData ReadFile(const std::filesystem::path& path);
+    // For packed files, the time the file had when it was packed
+    static std::filesystem::file_time_type GetLastWriteTime(const std::filesystem::path& path, std::error_code& error);
+};
\ No newline at end of file
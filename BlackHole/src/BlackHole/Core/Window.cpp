@@ -26,18 +26,56 @@ Window::~Window()
 
 void Window::OnUpdate()
 {
+    BH_PROFILE_FUNCTION();
+
+    PollEvents();
+    SwapBuffers();
+}
+
+void Window::PollEvents()
+{
+    BH_PROFILE_FUNCTION();
+
+    glfwPollEvents();
+
+    m_Data.Events.Dispatch([this](Event& e) { m_Data.EventCallback(e); });
+    Input::SetState(m_Data.Input);
+}
+
+void Window::PollInput()
+{
+    BH_PROFILE_FUNCTION();
+
     glfwPollEvents();
+}
+
+void Window::SwapBuffers()
+{
     m_Context->SwapBuffers();
 }
 
-void Window::SetVSync(bool enabled)
+void Window::SetVSyncMode(VSyncMode mode)
 {
-    if (enabled)
-        glfwSwapInterval(1);
-    else
+    if (mode == VSyncMode::Adaptive && !glfwExtensionSupported("WGL_EXT_swap_control_tear") && !glfwExtensionSupported("GLX_EXT_swap_control_tear"))
+    {
+        BH_LOG_WARN("Adaptive vsync is not supported, using regular vsync");
+        mode = VSyncMode::On;
+    }
+
+    switch (mode)
+    {
+    case VSyncMode::Off:
         glfwSwapInterval(0);
+        break;
+    case VSyncMode::On:
+        glfwSwapInterval(1);
+        break;
+    case VSyncMode::Adaptive:
+        glfwSwapInterval(-1);
+        break;
+    }
 
-    m_Data.VSync = enabled;
+    m_Data.VSync = mode;
 }
 
 void Window::SetFullscreen(bool isFullscreen)
@@ -67,6 +105,8 @@ void Window::SetFullscreen(bool isFullscreen)
 
 void Window::Init(const WindowProps& props)
 {
+    BH_PROFILE_FUNCTION();
+
     m_Data.Title = props.Title;
     m_Data.Width = props.Width;
     m_Data.Height = props.Height;
@@ -86,6 +126,7 @@ void Window::Init(const WindowProps& props)
     glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 6);
     glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
     glfwWindowHint(GLFW_SAMPLES, 4);
+    glfwWindowHint(GLFW_VISIBLE, props.Visible ? GLFW_TRUE : GLFW_FALSE);
 
 #ifdef BH_DEBUG
     glfwWindowHint(GLFW_OPENGL_DEBUG_CONTEXT, true);
@@ -97,6 +138,12 @@ void Window::Init(const WindowProps& props)
     m_Context->Init();
 
     glfwSetWindowUserPointer(m_Window, &m_Data);
+
+    // The cursor callback only fires on movement
+    double cursorX, cursorY;
+    glfwGetCursorPos(m_Window, &cursorX, &cursorY);
+    m_Data.Input.MousePosition = { static_cast<float>(cursorX), static_cast<float>(cursorY) };
+    Input::SetState(m_Data.Input);
     SetVSync(true);
 
     // Set GLFW callbacks
@@ -107,40 +154,42 @@ void Window::Init(const WindowProps& props)
             data->Width = width;
             data->Height = height;
 
-            WindowResizeEvent e(width, height);
-            data->EventCallback(e);
+            data->Events.Push(WindowResizeEvent(width, height));
         });
 
     glfwSetWindowCloseCallback(m_Window, [](GLFWwindow* window)
         {
             auto* data = static_cast<WindowData*>(glfwGetWindowUserPointer(window));
 
-            WindowCloseEvent e;
-            data->EventCallback(e);
+            data->Events.Push(WindowCloseEvent());
         });
 
     glfwSetKeyCallback(m_Window, [](GLFWwindow* window, int key, int scancode, int action, int mods)
         {
             auto* data = static_cast<WindowData*>(glfwGetWindowUserPointer(window));
 
+            // Unknown keys come in as GLFW_KEY_UNKNOWN
+            const bool isTracked = key >= 0 && static_cast<uint32_t>(key) < InputState::MaxKeys;
+
             switch (action)
             {
                 case GLFW_PRESS:
                 {
-                    KeyPressedEvent e(key, 0);
-                    data->EventCallback(e);
+                    if (isTracked)
+                        data->Input.Keys.set(key);
+                    data->Events.Push(KeyPressedEvent(key, 0));
                     break;
                 }
                 case GLFW_RELEASE:
                 {
-                    KeyReleasedEvent e(key);
-                    data->EventCallback(e);
+                    if (isTracked)
+                        data->Input.Keys.reset(key);
+                    data->Events.Push(KeyReleasedEvent(key));
                     break;
                 }
                 case GLFW_REPEAT:
                 {
-                    KeyPressedEvent e(key, 1);
-                    data->EventCallback(e);
+                    data->Events.Push(KeyPressedEvent(key, 1));
                     break;
                 }
                 default:
@@ -153,18 +202,22 @@ void Window::Init(const WindowProps& props)
         {
             auto* data = static_cast<WindowData*>(glfwGetWindowUserPointer(window));
 
+            const bool isTracked = button >= 0 && static_cast<uint32_t>(button) < InputState::MaxMouseButtons;
+
             switch (action)
             {
                 case GLFW_PRESS:
                 {
-                    MouseButtonPressedEvent e(button);
-                    data->EventCallback(e);
+                    if (isTracked)
+                        data->Input.MouseButtons.set(button);
+                    data->Events.Push(MouseButtonPressedEvent(button));
                     break;
                 }
                 case GLFW_RELEASE:
                 {
-                    MouseButtonReleasedEvent e(button);
-                    data->EventCallback(e);
+                    if (isTracked)
+                        data->Input.MouseButtons.reset(button);
+                    data->Events.Push(MouseButtonReleasedEvent(button));
                     break;
                 }
                 default:
@@ -177,20 +230,21 @@ void Window::Init(const WindowProps& props)
         {
             auto* data = static_cast<WindowData*>(glfwGetWindowUserPointer(window));
 
-            MouseScrolledEvent e(static_cast<float>(xOffset), static_cast<float>(yOffset));
-            data->EventCallback(e);
+            data->Events.Push(MouseScrolledEvent(static_cast<float>(xOffset), static_cast<float>(yOffset)));
         });
 
     glfwSetCursorPosCallback(m_Window, [](GLFWwindow* window, double xPos, double yPos)
         {
             auto* data = static_cast<WindowData*>(glfwGetWindowUserPointer(window));
 
-            MouseMovedEvent e(static_cast<float>(xPos), static_cast<float>(yPos));
-            data->EventCallback(e);
+            data->Input.MousePosition = { static_cast<float>(xPos), static_cast<float>(yPos) };
+            data->Events.Push(MouseMovedEvent(static_cast<float>(xPos), static_cast<float>(yPos)));
         });
 }
 
 void Window::ShutDown()
 {
+    BH_PROFILE_FUNCTION();
+
     glfwDestroyWindow(m_Window);
 }
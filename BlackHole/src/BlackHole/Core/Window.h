@@ -1,11 +1,14 @@
 #pragma once
-#include "BlackHole/Events/Event.h"
+#include "BlackHole/Core/Input.h"
+#include "BlackHole/Events/EventQueue.h"
 #include "Platform/OpenGL/Context.h"
 
 struct WindowProps
 {
     std::string Title;
     uint32_t Width, Height;
+    // Hidden windows still get a context, for rendering offscreen
+    bool Visible = true;
 
     explicit WindowProps(const std::string& title = "Black Hole Window",
                          const uint32_t width = 1280,
@@ -13,6 +16,14 @@ struct WindowProps
         : Title(title), Width(width), Height(height) {}
 };
 
+enum class VSyncMode
+{
+    Off,
+    On,
+    // Syncs when frames keep up and tears instead of waiting a whole refresh when one runs late
+    Adaptive
+};
+
 class Window
 {
     using EventCallbackFn = std::function<void(Event&)>;
@@ -20,20 +31,35 @@ public:
     explicit Window(const WindowProps& props = WindowProps());
     ~Window();
 
+    // Polls, dispatches the queued events and refreshes the input snapshot, then swaps
     void OnUpdate();
+    // The two halves of OnUpdate, for sampling input as late as possible before a frame
+    void PollEvents();
+    void SwapBuffers();
+
+    // Polls again mid-frame without dispatching, the events stay queued for the next PollEvents.
+    // Only refreshes the latest input below, the frame's Input snapshot stays as it was
+    void PollInput();
+    const InputState& GetLatestInput() const { return m_Data.Input; }
 
     uint32_t GetWidth() const { return m_Data.Width; }
     uint32_t GetHeight() const { return m_Data.Height; }
 
-    void SetVSync(bool enabled);
-    bool IsVSync() const { return m_Data.VSync; }
+    void SetVSync(bool enabled) { SetVSyncMode(enabled ? VSyncMode::On : VSyncMode::Off); }
+    bool IsVSync() const { return m_Data.VSync != VSyncMode::Off; }
+    // Adaptive falls back to On where the driver lacks swap_control_tear
+    void SetVSyncMode(VSyncMode mode);
+    VSyncMode GetVSyncMode() const { return m_Data.VSync; }
 
     void SetFullscreen(bool isFullscreen);
     bool IsFullscreen() const { return m_Data.IsFullscreen; }
 
     void SetCallbackFunction(const EventCallbackFn& eventCallback) { m_Data.EventCallback = eventCallback; }
 
+    const EventQueue& GetEventQueue() const { return m_Data.Events; }
+
     GLFWwindow* GetNativeWindow() const { return m_Window; }
+    const Context& GetContext() const { return *m_Context; }
 private:
     void Init(const WindowProps& props);
     void ShutDown();
@@ -45,9 +71,13 @@ private:
     {
         std::string Title;
         uint32_t Width, Height;
-        bool VSync;
+        VSyncMode VSync;
         bool IsFullscreen;
 
         EventCallbackFn EventCallback;
+
+        // Filled by the GLFW callbacks while polling
+        EventQueue Events;
+        InputState Input;
     } m_Data;
 };
\ No newline at end of file
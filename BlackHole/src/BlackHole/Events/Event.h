@@ -23,7 +23,7 @@ enum EventCategory
     EventCategoryMouseButton    = BIT(4)
 };
 
-#define EVENT_CLASS_TYPE(type) static EventType GetStaticType() { return EventType::##type; }\
+#define EVENT_CLASS_TYPE(type) static constexpr EventType GetStaticType() { return EventType::type; }\
                                virtual EventType GetEventType() const override { return GetStaticType(); }\
                                virtual const char* GetName() const override { return #type; }
 
@@ -50,18 +50,18 @@ OStream& operator<<(OStream& os, const Event& e)
     return os;
 };
 
+// Handlers are taken by reference and called directly, so dispatching doesn't allocate,
+// and the event type is read once instead of once per handler
 class EventDispatcher
 {
-    template <typename T>
-    using EventFn = std::function<bool(T&)>;
 public:
     EventDispatcher(Event& e)
-        : m_Event(e) {}
+        : m_Event(e), m_EventType(e.GetEventType()) {}
 
-    template <typename T>
-    bool Dispatch(EventFn<T> func)
+    template <typename T, typename F>
+    bool Dispatch(const F& func)
     {
-        if (m_Event.GetEventType() == T::GetStaticType())
+        if (m_EventType == T::GetStaticType())
         {
             m_Event.Handled |= func(static_cast<T&>(m_Event));
             return true;
@@ -71,4 +71,5 @@ public:
 
 private:
     Event& m_Event;
+    EventType m_EventType;
 };
\ No newline at end of file
@@ -0,0 +1,31 @@
+#include "bhpch.h"
+#include "BlackHole/Events/EventQueue.h"
+
+void EventQueue::Push(const QueuedEvent& event)
+{
+    // Only the last event is folded into, so moves never jump over a button press or release
+    if (!m_Events.empty())
+    {
+        QueuedEvent& last = m_Events.back();
+        // Positions and sizes are absolute, the latest one is all that matters
+        const bool isMove = std::holds_alternative<MouseMovedEvent>(event) && std::holds_alternative<MouseMovedEvent>(last);
+        const bool isResize = std::holds_alternative<WindowResizeEvent>(event) && std::holds_alternative<WindowResizeEvent>(last);
+        if (isMove || isResize)
+        {
+            last = event;
+            ++m_CoalescedCount;
+            return;
+        }
+
+        if (std::holds_alternative<MouseScrolledEvent>(event) && std::holds_alternative<MouseScrolledEvent>(last))
+        {
+            const auto& scroll = std::get<MouseScrolledEvent>(event);
+            const auto& lastScroll = std::get<MouseScrolledEvent>(last);
+            last = MouseScrolledEvent(lastScroll.GetXOffset() + scroll.GetXOffset(), lastScroll.GetYOffset() + scroll.GetYOffset());
+            ++m_CoalescedCount;
+            return;
+        }
+    }
+
+    m_Events.push_back(event);
+}
\ No newline at end of file
@@ -0,0 +1,41 @@
+#pragma once
+#include <variant>
+
+#include "BlackHole/Events/ApplicationEvent.h"
+#include "BlackHole/Events/KeyEvent.h"
+#include "BlackHole/Events/MouseEvent.h"
+
+// Window events collected while polling and dispatched once per frame. Events are stored by value,
+// so queuing doesn't allocate once the storage has grown. Consecutive mouse moves collapse into the
+// latest position, resizes into the latest size, and consecutive scrolls add up, so a high rate mouse costs one dispatch per frame
+class EventQueue
+{
+public:
+    using QueuedEvent = std::variant<
+        WindowResizeEvent, WindowCloseEvent,
+        KeyPressedEvent, KeyReleasedEvent,
+        MouseButtonPressedEvent, MouseButtonReleasedEvent, MouseMovedEvent, MouseScrolledEvent
+    >;
+
+    void Push(const QueuedEvent& event);
+
+    // Calls function with every queued event as Event&, in the order they were pushed, and empties the queue
+    template <typename Function>
+    void Dispatch(Function&& function)
+    {
+        // Swapped out, so events pushed by the handlers wait for the next frame
+        std::swap(m_Events, m_Dispatching);
+        for (auto& event : m_Dispatching)
+            std::visit([&function](Event& e) { function(e); }, event);
+        m_Dispatching.clear();
+    }
+
+    uint32_t GetSize() const { return static_cast<uint32_t>(m_Events.size()); }
+    bool IsEmpty() const { return m_Events.empty(); }
+    // Pushes folded into an earlier event since the queue was created
+    uint64_t GetCoalescedCount() const { return m_CoalescedCount; }
+private:
+    std::vector<QueuedEvent> m_Events;
+    std::vector<QueuedEvent> m_Dispatching;
+    uint64_t m_CoalescedCount = 0;
+};
\ No newline at end of file
@@ -3,6 +3,8 @@
 
 #include "BlackHole/Core/Application.h"
 
+#include "Platform/OpenGL/GPUProfiler.h"
+
 #include <GLFW/glfw3.h>
 
 #include <backends/imgui_impl_glfw.h>
@@ -15,6 +17,8 @@ ImGuiLayer::ImGuiLayer()
 
 void ImGuiLayer::OnAttach()
 {
+    BH_PROFILE_FUNCTION();
+
     IMGUI_CHECKVERSION();
     ImGui::CreateContext();
     ImGuiIO& io = ImGui::GetIO(); (void)io;
@@ -44,6 +48,8 @@ void ImGuiLayer::OnAttach()
 
 void ImGuiLayer::OnDetach()
 {
+    BH_PROFILE_FUNCTION();
+
     ImGui_ImplOpenGL3_Shutdown();
     ImGui_ImplGlfw_Shutdown();
     ImGui::DestroyContext();
@@ -61,6 +67,8 @@ void ImGuiLayer::OnEvent(Event& e)
 
 void ImGuiLayer::Begin()
 {
+    BH_PROFILE_FUNCTION();
+
     ImGui_ImplOpenGL3_NewFrame();
     ImGui_ImplGlfw_NewFrame();
     ImGui::NewFrame();
@@ -68,12 +76,17 @@ void ImGuiLayer::Begin()
 
 void ImGuiLayer::End()
 {
+    BH_PROFILE_FUNCTION();
+
     ImGuiIO& io = ImGui::GetIO();
     const Application& app = Application::Get();
     io.DisplaySize = ImVec2(static_cast<float>(app.GetWindow().GetWidth()), static_cast<float>(app.GetWindow().GetHeight()));
 
     ImGui::Render();
-    ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
+    {
+        BH_GPU_PROFILE_SCOPE("ImGui");
+        ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
+    }
 
     if (io.ConfigFlags & ImGuiConfigFlags_ViewportsEnable)
     {
@@ -0,0 +1,42 @@
+#pragma once
+#include <limits>
+
+#include <glm/common.hpp>
+#include <glm/mat4x4.hpp>
+#include <glm/vec3.hpp>
+
+struct AABB
+{
+    glm::vec3 Min = glm::vec3(std::numeric_limits<float>::max());
+    glm::vec3 Max = glm::vec3(std::numeric_limits<float>::lowest());
+
+    bool IsValid() const { return Min.x <= Max.x && Min.y <= Max.y && Min.z <= Max.z; }
+
+    glm::vec3 GetCenter() const { return (Min + Max) * 0.5f; }
+    glm::vec3 GetExtents() const { return (Max - Min) * 0.5f; }
+
+    void Expand(const glm::vec3& point)
+    {
+        Min = glm::min(Min, point);
+        Max = glm::max(Max, point);
+    }
+
+    void Expand(const AABB& other)
+    {
+        Min = glm::min(Min, other.Min);
+        Max = glm::max(Max, other.Max);
+    }
+
+    // Box enclosing this one after an affine transform, without transforming all eight corners
+    AABB Transform(const glm::mat4& transform) const
+    {
+        const glm::vec3 center = glm::vec3(transform * glm::vec4(GetCenter(), 1.0f));
+        const glm::vec3 extents = GetExtents();
+        const glm::vec3 transformedExtents =
+            glm::abs(glm::vec3(transform[0])) * extents.x +
+            glm::abs(glm::vec3(transform[1])) * extents.y +
+            glm::abs(glm::vec3(transform[2])) * extents.z;
+
+        return { center - transformedExtents, center + transformedExtents };
+    }
+};
\ No newline at end of file
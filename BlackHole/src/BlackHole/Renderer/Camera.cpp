@@ -40,6 +40,21 @@ void PerspectiveCamera::SetRotation(float yaw, float pitch)
     UpdateView();
 }
 
+void PerspectiveCamera::SetOrientation(const glm::quat& orientation)
+{
+    m_Orientation = glm::normalize(orientation);
+
+    const glm::quat invOrientation = glm::conjugate(m_Orientation);
+    m_Target = glm::normalize(invOrientation * glm::vec3(0, 0, -1));
+    m_Up = glm::normalize(invOrientation * glm::vec3(0, 1, 0));
+    m_Right = glm::normalize(invOrientation * glm::vec3(1, 0, 0));
+
+    // Keep the accumulated pitch in step, so later relative rotations are still clamped correctly
+    m_QuatPitch = glm::angleAxis(-glm::asin(glm::clamp(m_Target.y, -1.0f, 1.0f)), glm::vec3(1, 0, 0));
+
+    UpdateView();
+}
+
 void PerspectiveCamera::SetPosition(const glm::vec3& pos)
 {
     m_Position = pos;
@@ -11,14 +11,19 @@ public:
 
     void SetRotation(float yaw, float pitch);
     void SetPosition(const glm::vec3& pos);
+    // Absolute orientation, taking world space to view space, as returned by GetOrientation
+    void SetOrientation(const glm::quat& orientation);
 
     void SetPerspectiveProjection(float fovDegrees, float aspectRatio, float near, float far);
     void SetFOV(float fovDegrees);
     void SetAspectRatio(float aspectRatio);
 
     float GetFOV() const { return m_FOV; }
+    float GetNearClip() const { return m_Near; }
+    float GetFarClip() const { return m_Far; }
 
     glm::vec3 GetPosition() const { return m_Position; }
+    glm::quat GetOrientation() const { return m_Orientation; }
 
     glm::vec3 GetTargetDirection() const { return m_Target; }
     glm::vec3 GetRightDirection() const { return m_Right; }
@@ -13,6 +13,8 @@ PerspectiveCameraController::PerspectiveCameraController(const PerspectiveCamera
 
 void PerspectiveCameraController::OnUpdate(Timestep ts)
 {
+    m_LastTimestep = ts;
+
     if (Input::IsMouseButtonPressed(GLFW_MOUSE_BUTTON_RIGHT))
     {
         if (Input::IsKeyPressed(GLFW_KEY_W))
@@ -52,6 +54,27 @@ void PerspectiveCameraController::OnUpdate(Timestep ts)
     }
 }
 
+void PerspectiveCameraController::OnLateUpdate()
+{
+    BH_PROFILE_FUNCTION();
+
+    Window& window = Application::Get().GetWindow();
+    window.PollInput();
+
+    const InputState& input = window.GetLatestInput();
+    if (m_FirstMouseMoveEvent || !input.MouseButtons[GLFW_MOUSE_BUTTON_RIGHT])
+        return;
+
+    // The queued move events carry the same position, so next frame they only add motion that came after this
+    const float offsetX = input.MousePosition.x - m_LastMouseX;
+    const float offsetY = input.MousePosition.y - m_LastMouseY;
+    m_LastMouseX = input.MousePosition.x;
+    m_LastMouseY = input.MousePosition.y;
+
+    if (offsetX != 0.0f || offsetY != 0.0f)
+        m_Camera.SetRotation(offsetX * m_CameraRotateSensitivity * m_LastTimestep, offsetY * m_CameraRotateSensitivity * m_LastTimestep);
+}
+
 void PerspectiveCameraController::OnEvent(Event& e)
 {
     EventDispatcher dispatcher(e);
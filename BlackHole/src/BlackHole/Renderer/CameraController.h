@@ -13,6 +13,8 @@ public:
     ~PerspectiveCameraController() = default;
 
     void OnUpdate(Timestep ts);
+    // Applies mouse motion that arrived since OnUpdate, for calling right before the camera's matrices are used
+    void OnLateUpdate();
     void OnEvent(Event& e);
 
     void OnResize(uint32_t width, uint32_t height);
@@ -36,6 +38,8 @@ private:
 
     bool m_CameraWasRotated = false;
     bool m_FirstMouseMoveEvent = true;
+    // Late updates turn by the same amount per pixel as the frame's OnUpdate
+    Timestep m_LastTimestep;
 
     PerspectiveCamera m_Camera;
     glm::vec3 m_CameraPosition;
@@ -0,0 +1,126 @@
+#include "bhpch.h"
+#include "BlackHole/Renderer/CameraPath.h"
+
+#include <iomanip>
+
+#include <glm/gtc/constants.hpp>
+
+static constexpr std::string_view s_FileHeader = "bhcampath";
+static constexpr uint32_t s_FileVersion = 1;
+
+bool CameraPath::Load(const std::filesystem::path& filepath)
+{
+    BH_PROFILE_FUNCTION();
+
+    std::ifstream file(filepath);
+    if (!file.is_open())
+    {
+        BH_LOG_ERROR("Could not open camera path '{0}'", filepath.string());
+        return false;
+    }
+
+    std::string header;
+    uint32_t version = 0;
+    file >> header >> version;
+    if (header != s_FileHeader || version != s_FileVersion)
+    {
+        BH_LOG_ERROR("'{0}' is not a camera path of version {1}", filepath.string(), s_FileVersion);
+        return false;
+    }
+
+    std::vector<CameraKeyframe> keyframes;
+    CameraKeyframe keyframe;
+    while (file >> keyframe.Time
+        >> keyframe.Position.x >> keyframe.Position.y >> keyframe.Position.z
+        >> keyframe.Orientation.w >> keyframe.Orientation.x >> keyframe.Orientation.y >> keyframe.Orientation.z)
+    {
+        keyframes.push_back(keyframe);
+    }
+
+    if (!file.eof())
+    {
+        BH_LOG_ERROR("Malformed keyframe in camera path '{0}'", filepath.string());
+        return false;
+    }
+
+    m_Keyframes = std::move(keyframes);
+    return true;
+}
+
+bool CameraPath::Save(const std::filesystem::path& filepath) const
+{
+    std::ofstream file(filepath);
+    if (!file.is_open())
+    {
+        BH_LOG_ERROR("Could not write camera path '{0}'", filepath.string());
+        return false;
+    }
+
+    file << s_FileHeader << ' ' << s_FileVersion << '\n';
+    file << std::setprecision(9);
+    for (const CameraKeyframe& keyframe : m_Keyframes)
+    {
+        file << keyframe.Time << ' '
+            << keyframe.Position.x << ' ' << keyframe.Position.y << ' ' << keyframe.Position.z << ' '
+            << keyframe.Orientation.w << ' ' << keyframe.Orientation.x << ' ' << keyframe.Orientation.y << ' ' << keyframe.Orientation.z << '\n';
+    }
+    return file.good();
+}
+
+void CameraPath::AddKeyframe(const CameraKeyframe& keyframe)
+{
+    BH_ASSERT(m_Keyframes.empty() || keyframe.Time >= m_Keyframes.back().Time, "Camera keyframes must be added in time order!");
+    m_Keyframes.push_back(keyframe);
+}
+
+CameraKeyframe CameraPath::Evaluate(float time) const
+{
+    if (m_Keyframes.empty())
+        return {};
+    if (time <= m_Keyframes.front().Time)
+        return m_Keyframes.front();
+    if (time >= m_Keyframes.back().Time)
+        return m_Keyframes.back();
+
+    const auto next = std::upper_bound(m_Keyframes.begin(), m_Keyframes.end(), time,
+        [](float t, const CameraKeyframe& keyframe) { return t < keyframe.Time; });
+    const CameraKeyframe& b = *next;
+    const CameraKeyframe& a = *(next - 1);
+
+    const float span = b.Time - a.Time;
+    const float t = span > 0.0f ? (time - a.Time) / span : 1.0f;
+
+    CameraKeyframe result;
+    result.Time = time;
+    result.Position = glm::mix(a.Position, b.Position, t);
+    // slerp takes the short way round, so a sign flip between recorded quaternions doesn't spin the camera
+    result.Orientation = glm::normalize(glm::slerp(a.Orientation, b.Orientation, t));
+    return result;
+}
+
+void CameraPath::Apply(PerspectiveCamera& camera, float time) const
+{
+    const CameraKeyframe keyframe = Evaluate(time);
+    camera.SetPosition(keyframe.Position);
+    camera.SetOrientation(keyframe.Orientation);
+}
+
+CameraPath CameraPath::CreateOrbit(const glm::vec3& center, float radius, float height, float duration, uint32_t keyframeCount)
+{
+    keyframeCount = std::max(keyframeCount, 2u);
+
+    CameraPath path;
+    for (uint32_t i = 0; i < keyframeCount; ++i)
+    {
+        const float t = static_cast<float>(i) / static_cast<float>(keyframeCount - 1);
+        const float angle = t * glm::two_pi<float>();
+
+        CameraKeyframe keyframe;
+        keyframe.Time = t * duration;
+        keyframe.Position = center + glm::vec3(std::sin(angle) * radius, height, std::cos(angle) * radius);
+        // The view orientation is the inverse of the camera's world rotation
+        keyframe.Orientation = glm::conjugate(glm::quatLookAt(glm::normalize(center - keyframe.Position), glm::vec3(0.0f, 1.0f, 0.0f)));
+        path.AddKeyframe(keyframe);
+    }
+    return path;
+}
\ No newline at end of file
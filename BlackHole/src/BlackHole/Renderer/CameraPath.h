@@ -0,0 +1,40 @@
+#pragma once
+#include "BlackHole/Renderer/Camera.h"
+
+#include <filesystem>
+
+struct CameraKeyframe
+{
+    // Seconds from the start of the path
+    float Time = 0.0f;
+    glm::vec3 Position = glm::vec3(0.0f);
+    glm::quat Orientation = { 1.0f, 0.0f, 0.0f, 0.0f };
+};
+
+// Timed camera poses, recorded in the editor and replayed by benchmarks so every run sees the same frames.
+// Stored as text: a "bhcampath 1" header, then one "time px py pz qw qx qy qz" line per keyframe
+class CameraPath
+{
+public:
+    CameraPath() = default;
+
+    bool Load(const std::filesystem::path& filepath);
+    bool Save(const std::filesystem::path& filepath) const;
+
+    // Keyframes are expected in increasing time order
+    void AddKeyframe(const CameraKeyframe& keyframe);
+    void Clear() { m_Keyframes.clear(); }
+
+    // Interpolated pose at the time, clamped to the ends of the path
+    CameraKeyframe Evaluate(float time) const;
+    void Apply(PerspectiveCamera& camera, float time) const;
+
+    float GetDuration() const { return m_Keyframes.empty() ? 0.0f : m_Keyframes.back().Time; }
+    bool IsEmpty() const { return m_Keyframes.empty(); }
+    const std::vector<CameraKeyframe>& GetKeyframes() const { return m_Keyframes; }
+
+    // Full circle around the center at a fixed height, looking at it
+    static CameraPath CreateOrbit(const glm::vec3& center, float radius, float height, float duration, uint32_t keyframeCount = 64);
+private:
+    std::vector<CameraKeyframe> m_Keyframes;
+};
\ No newline at end of file
@@ -0,0 +1,122 @@
+#include "bhpch.h"
+#include "BlackHole/Renderer/CascadedShadows.h"
+
+#include <glm/gtc/matrix_transform.hpp>
+
+// Shadows fade out past this view distance, however far the camera sees
+static constexpr float s_ShadowDistance = 60.0f;
+// Blend between logarithmic and uniform split distances
+static constexpr float s_SplitLambda = 0.8f;
+// Cached cascades cover more than their slice, so the camera can move a while before they are refit
+static constexpr float s_CachedCascadePadding = 1.5f;
+
+CascadedShadows::CascadedShadows(uint32_t resolution)
+    : m_ShadowMap(resolution, CascadeCount)
+{
+}
+
+void CascadedShadows::Update(const glm::mat4& view, const glm::mat4& projection, float nearClip, float farClip,
+    const glm::vec3& lightDirection, uint64_t staticGeometryHash)
+{
+    const glm::vec3 direction = glm::normalize(lightDirection);
+    if (direction != m_LightDirection || staticGeometryHash != m_StaticGeometryHash)
+    {
+        Invalidate();
+        m_LightDirection = direction;
+        m_StaticGeometryHash = staticGeometryHash;
+    }
+
+    // The light view only depends on the direction, so texel snapping in it stays stable while the camera moves
+    const glm::vec3 up = std::abs(direction.y) > 0.99f ? glm::vec3(0.0f, 0.0f, 1.0f) : glm::vec3(0.0f, 1.0f, 0.0f);
+    m_LightView = glm::lookAt(glm::vec3(0.0f), direction, up);
+
+    const glm::mat4 cameraToLight = m_LightView * glm::inverse(view);
+    const float tanHalfFovX = 1.0f / projection[0][0];
+    const float tanHalfFovY = 1.0f / projection[1][1];
+    const float shadowDistance = std::min(farClip, s_ShadowDistance);
+
+    // Moving the camera refits at most one cached cascade per frame, so the cost stays bounded
+    bool refitBudgetUsed = false;
+
+    float sliceNear = nearClip;
+    for (uint32_t index = 0; index < CascadeCount; ++index)
+    {
+        Cascade& cascade = m_Cascades[index];
+
+        const float t = static_cast<float>(index + 1) / static_cast<float>(CascadeCount);
+        const float logSplit = nearClip * std::pow(shadowDistance / nearClip, t);
+        const float uniformSplit = nearClip + (shadowDistance - nearClip) * t;
+        const float sliceFar = s_SplitLambda * logSplit + (1.0f - s_SplitLambda) * uniformSplit;
+        cascade.SplitDistance = sliceFar;
+
+        // Bounding sphere of the frustum slice in light space, its radius doesn't change as the camera turns
+        std::array<glm::vec3, 8> corners;
+        glm::vec3 center = glm::vec3(0.0f);
+        for (uint32_t i = 0; i < 8; ++i)
+        {
+            const float depth = (i & 4) ? sliceFar : sliceNear;
+            const glm::vec4 viewCorner = {
+                ((i & 1) ? 1.0f : -1.0f) * depth * tanHalfFovX,
+                ((i & 2) ? 1.0f : -1.0f) * depth * tanHalfFovY,
+                -depth,
+                1.0f
+            };
+            corners[i] = glm::vec3(cameraToLight * viewCorner);
+            center += corners[i] / 8.0f;
+        }
+
+        float radius = 0.0f;
+        for (const auto& corner : corners)
+            radius = std::max(radius, glm::length(corner - center));
+        radius = std::ceil(radius * 16.0f) / 16.0f;
+
+        sliceNear = sliceFar;
+
+        cascade.IsCached = index >= FirstCachedCascade;
+        if (!cascade.IsCached)
+        {
+            FitCascade(cascade, center, radius);
+            cascade.NeedsRender = true;
+            continue;
+        }
+
+        CachedFit& fit = m_CachedFits[index];
+        const bool stillCovers = fit.IsValid && glm::length(center - fit.Center) + radius <= fit.Radius;
+        cascade.NeedsRender = false;
+        if (!fit.IsValid || (!stillCovers && !refitBudgetUsed))
+        {
+            refitBudgetUsed = refitBudgetUsed || fit.IsValid;
+            fit = { center, radius * s_CachedCascadePadding, true };
+            cascade.NeedsRender = true;
+        }
+
+        FitCascade(cascade, fit.Center, fit.Radius);
+    }
+}
+
+void CascadedShadows::Invalidate()
+{
+    for (auto& fit : m_CachedFits)
+        fit.IsValid = false;
+}
+
+void CascadedShadows::FitCascade(Cascade& cascade, const glm::vec3& center, float radius)
+{
+    // Snapping the centre to whole texels keeps shadow edges from shimmering as the camera moves
+    const float texelSize = 2.0f * radius / static_cast<float>(m_ShadowMap.GetSize());
+    const glm::vec3 snappedCenter = {
+        std::floor(center.x / texelSize) * texelSize,
+        std::floor(center.y / texelSize) * texelSize,
+        center.z
+    };
+
+    cascade.LightSpaceBounds = { snappedCenter - glm::vec3(radius), snappedCenter + glm::vec3(radius) };
+
+    // The light looks down -z, distances along it run from the far side of the box towards the light
+    const glm::mat4 projection = glm::ortho(
+        snappedCenter.x - radius, snappedCenter.x + radius,
+        snappedCenter.y - radius, snappedCenter.y + radius,
+        -snappedCenter.z - radius, -snappedCenter.z + radius);
+
+    cascade.ViewProjection = projection * m_LightView;
+}
\ No newline at end of file
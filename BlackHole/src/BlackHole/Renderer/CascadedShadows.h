@@ -0,0 +1,57 @@
+#pragma once
+#include <glm/mat4x4.hpp>
+#include <glm/vec3.hpp>
+
+#include "BlackHole/Renderer/BoundingBox.h"
+#include "Platform/OpenGL/ShadowMap.h"
+
+// Directional light shadows split along the view depth. Near cascades are redrawn every frame,
+// far ones only hold static geometry and are kept until the light, the static geometry or the camera invalidates them
+class CascadedShadows
+{
+public:
+    static constexpr uint32_t CascadeCount = 4;
+    static constexpr uint32_t FirstCachedCascade = 2;
+
+    struct Cascade
+    {
+        glm::mat4 ViewProjection = glm::mat4(1.0f);
+        // Light view space box the cascade covers, casters in front of it still cast into it
+        AABB LightSpaceBounds;
+        // View depth where the cascade ends
+        float SplitDistance = 0.0f;
+        bool NeedsRender = true;
+        bool IsCached = false;
+    };
+
+    explicit CascadedShadows(uint32_t resolution = 2048);
+
+    // Fits the cascades to the camera frustum and decides which of them have to be redrawn this frame
+    void Update(const glm::mat4& view, const glm::mat4& projection, float nearClip, float farClip,
+        const glm::vec3& lightDirection, uint64_t staticGeometryHash);
+
+    // Forces every cascade to be redrawn on the next update
+    void Invalidate();
+
+    const Cascade& GetCascade(uint32_t index) const { return m_Cascades[index]; }
+    const glm::mat4& GetLightView() const { return m_LightView; }
+    const ShadowMap& GetShadowMap() const { return m_ShadowMap; }
+private:
+    struct CachedFit
+    {
+        glm::vec3 Center = glm::vec3(0.0f);
+        float Radius = 0.0f;
+        bool IsValid = false;
+    };
+
+    void FitCascade(Cascade& cascade, const glm::vec3& center, float radius);
+private:
+    ShadowMap m_ShadowMap;
+
+    glm::mat4 m_LightView = glm::mat4(1.0f);
+    glm::vec3 m_LightDirection = glm::vec3(0.0f);
+    uint64_t m_StaticGeometryHash = 0;
+
+    std::array<Cascade, CascadeCount> m_Cascades;
+    std::array<CachedFit, CascadeCount> m_CachedFits;
+};
\ No newline at end of file
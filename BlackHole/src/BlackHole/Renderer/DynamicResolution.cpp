@@ -0,0 +1,58 @@
+#include "bhpch.h"
+#include "BlackHole/Renderer/DynamicResolution.h"
+
+// Within this fraction of the target the scale is left alone
+static constexpr float s_Deadband = 0.05f;
+static constexpr float s_DecreaseRate = 0.5f;
+static constexpr float s_IncreaseRate = 0.1f;
+// Timer results lag behind, measurements taken right after a change still show the old scale
+static constexpr uint32_t s_SettleFrames = 4;
+// Scales are kept to multiples of this, so the render size doesn't creep by a pixel every frame
+static constexpr float s_ScaleStep = 1.0f / 64.0f;
+
+DynamicResolution::DynamicResolution(const DynamicResolutionSpecification& specification)
+    : m_Specification(specification), m_Scale(specification.MaxScale)
+{
+}
+
+float DynamicResolution::Update(float gpuTime)
+{
+    const float minScale = std::min(m_Specification.MinScale, m_Specification.MaxScale);
+    if (gpuTime <= 0.0f || m_Specification.TargetFrameTime <= 0.0f)
+    {
+        m_Scale = std::clamp(m_Scale, minScale, m_Specification.MaxScale);
+        return m_Scale;
+    }
+
+    if (m_SettleFrames > 0)
+    {
+        --m_SettleFrames;
+        return m_Scale;
+    }
+
+    const float ratio = m_Specification.TargetFrameTime / gpuTime;
+    if (std::abs(ratio - 1.0f) > s_Deadband)
+    {
+        const float desiredScale = m_Scale * std::sqrt(ratio);
+        const float rate = desiredScale < m_Scale ? s_DecreaseRate : s_IncreaseRate;
+        const float scale = m_Scale + (desiredScale - m_Scale) * rate;
+
+        // Rounded away from the current scale, otherwise small steps would never leave it
+        const float steps = scale < m_Scale ? std::floor(scale / s_ScaleStep) : std::ceil(scale / s_ScaleStep);
+        const float previousScale = m_Scale;
+        m_Scale = std::clamp(steps * s_ScaleStep, minScale, m_Specification.MaxScale);
+        if (m_Scale != previousScale)
+            m_SettleFrames = s_SettleFrames;
+    }
+
+    m_Scale = std::clamp(m_Scale, minScale, m_Specification.MaxScale);
+    return m_Scale;
+}
+
+glm::uvec2 DynamicResolution::GetRenderSize(uint32_t width, uint32_t height) const
+{
+    return {
+        std::max(static_cast<uint32_t>(std::round(static_cast<float>(width) * m_Scale)), 1u),
+        std::max(static_cast<uint32_t>(std::round(static_cast<float>(height) * m_Scale)), 1u)
+    };
+}
\ No newline at end of file
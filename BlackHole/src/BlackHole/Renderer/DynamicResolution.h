@@ -0,0 +1,35 @@
+#pragma once
+#include <glm/vec2.hpp>
+
+struct DynamicResolutionSpecification
+{
+    // GPU time the measured passes should fit in, in milliseconds
+    float TargetFrameTime = 12.0f;
+    float MinScale = 0.5f;
+    float MaxScale = 1.0f;
+};
+
+// Picks the render scale for the next frame from measured GPU time. GPU time grows roughly with
+// the pixel count, so the scale moves by the square root of the time ratio. Timer results arrive
+// a few frames late, so after every change the controller waits for them to catch up. It only covers
+// part of the distance at once, drops faster than it recovers, and ignores deviations small enough to be noise
+class DynamicResolution
+{
+public:
+    explicit DynamicResolution(const DynamicResolutionSpecification& specification = DynamicResolutionSpecification());
+
+    // Returns the new scale, a measurement of 0 means no result is available yet and keeps it
+    float Update(float gpuTime);
+    void Reset() { m_Scale = m_Specification.MaxScale; m_SettleFrames = 0; }
+
+    float GetScale() const { return m_Scale; }
+    // Scaled size, never smaller than a pixel
+    glm::uvec2 GetRenderSize(uint32_t width, uint32_t height) const;
+
+    DynamicResolutionSpecification& GetSpecification() { return m_Specification; }
+    const DynamicResolutionSpecification& GetSpecification() const { return m_Specification; }
+private:
+    DynamicResolutionSpecification m_Specification;
+    float m_Scale;
+    uint32_t m_SettleFrames = 0;
+};
\ No newline at end of file
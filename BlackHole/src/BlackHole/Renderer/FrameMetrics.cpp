@@ -0,0 +1,180 @@
+#include "bhpch.h"
+#include "BlackHole/Renderer/FrameMetrics.h"
+
+namespace Utils
+{
+    static float GetMetricValue(const FrameSample& sample, FrameMetric metric)
+    {
+        switch (metric)
+        {
+        case FrameMetric::CPUTime: return sample.CPUTime;
+        case FrameMetric::GPUTime: return sample.GPUTime;
+        case FrameMetric::DrawCalls: return static_cast<float>(sample.DrawCalls);
+        case FrameMetric::TriangleCount: return static_cast<float>(sample.TriangleCount);
+        }
+
+        BH_ASSERT(false, "Unknown frame metric!");
+        return 0.0f;
+    }
+
+    // Nearest rank, so a percentile is always a value some frame actually had
+    static float Percentile(std::vector<float>& values, float percentile)
+    {
+        const size_t rank = static_cast<size_t>(std::ceil(percentile * static_cast<float>(values.size())));
+        const auto nth = values.begin() + static_cast<ptrdiff_t>(std::clamp<size_t>(rank, 1, values.size()) - 1);
+        std::nth_element(values.begin(), nth, values.end());
+        return *nth;
+    }
+}
+
+FrameMetrics::FrameMetrics(uint32_t capacity)
+    : m_Samples(std::max(capacity, 1u))
+{
+}
+
+void FrameMetrics::Record(const FrameSample& sample)
+{
+    m_Samples[m_NextIndex] = sample;
+    m_NextIndex = (m_NextIndex + 1) % GetCapacity();
+    m_SampleCount = std::min(m_SampleCount + 1, GetCapacity());
+
+    const bool isOverBudget = CheckBudget(sample);
+    if (isOverBudget)
+    {
+        ++m_OverBudgetCount;
+        if (!m_WasOverBudget)
+            LogOverBudget(sample);
+    }
+    m_WasOverBudget = isOverBudget;
+}
+
+void FrameMetrics::RecordGPUTime(uint64_t frameIndex, float milliseconds)
+{
+    // Results arrive a few frames late, so the frame is close to the newest
+    for (uint32_t age = 0; age < m_SampleCount; ++age)
+    {
+        FrameSample& sample = m_Samples[(m_NextIndex + GetCapacity() - 1 - age) % GetCapacity()];
+        if (sample.FrameIndex < frameIndex)
+            return;
+        if (sample.FrameIndex != frameIndex)
+            continue;
+
+        // The profiler keeps reporting its latest result until the next one arrives
+        if (sample.HasGPUTime)
+            return;
+
+        const bool wasOverBudget = CheckBudget(sample);
+        sample.GPUTime = milliseconds;
+        sample.HasGPUTime = true;
+
+        // Checked as the results come in, so a run is one of consecutive GPU results rather than frames
+        const bool isOverGPUBudget = m_Budget.GPUTime > 0.0f && milliseconds > m_Budget.GPUTime;
+        if (isOverGPUBudget && !wasOverBudget)
+            ++m_OverBudgetCount;
+        if (isOverGPUBudget && !m_WasOverGPUBudget)
+            LogOverBudget(sample);
+        m_WasOverGPUBudget = isOverGPUBudget;
+        return;
+    }
+}
+
+void FrameMetrics::Clear()
+{
+    m_NextIndex = 0;
+    m_SampleCount = 0;
+    m_WasOverBudget = false;
+    m_WasOverGPUBudget = false;
+    m_OverBudgetCount = 0;
+}
+
+FrameMetricSummary FrameMetrics::Summarize(FrameMetric metric, uint32_t frameCount) const
+{
+    GetValues(metric, frameCount, m_SortedValues);
+    return SummarizeValues(m_SortedValues);
+}
+
+FrameMetricSummary FrameMetrics::SummarizeValues(std::vector<float>& values)
+{
+    if (values.empty())
+        return {};
+
+    FrameMetricSummary summary;
+    summary.Min = values.front();
+    summary.Max = values.front();
+    double sum = 0.0;
+    for (const float value : values)
+    {
+        sum += value;
+        summary.Min = std::min(summary.Min, value);
+        summary.Max = std::max(summary.Max, value);
+    }
+    summary.Mean = static_cast<float>(sum / static_cast<double>(values.size()));
+
+    summary.P50 = Utils::Percentile(values, 0.50f);
+    summary.P90 = Utils::Percentile(values, 0.90f);
+    summary.P95 = Utils::Percentile(values, 0.95f);
+    summary.P99 = Utils::Percentile(values, 0.99f);
+    return summary;
+}
+
+void FrameMetrics::GetValues(FrameMetric metric, uint32_t frameCount, std::vector<float>& values) const
+{
+    const uint32_t count = std::min(frameCount, m_SampleCount);
+    values.clear();
+    values.reserve(count);
+    for (uint32_t age = count; age-- > 0;)
+    {
+        const FrameSample& sample = GetSample(age);
+        if (metric != FrameMetric::GPUTime || sample.HasGPUTime)
+            values.push_back(Utils::GetMetricValue(sample, metric));
+    }
+}
+
+bool FrameMetrics::ExportCSV(const std::filesystem::path& filepath) const
+{
+    std::ofstream file(filepath, std::ios::out | std::ios::trunc);
+    if (!file.is_open())
+    {
+        BH_LOG_ERROR("Could not open file '{0}'", filepath.string());
+        return false;
+    }
+
+    file << "frame,cpu_ms,gpu_ms,draw_calls,triangles\n";
+    for (uint32_t age = m_SampleCount; age-- > 0;)
+    {
+        const FrameSample& sample = GetSample(age);
+        const std::string gpuTime = sample.HasGPUTime ? fmt::format("{0:.3f}", sample.GPUTime) : std::string();
+        file << fmt::format("{0},{1:.3f},{2},{3},{4}\n", sample.FrameIndex, sample.CPUTime, gpuTime, sample.DrawCalls, sample.TriangleCount);
+    }
+
+    BH_LOG_INFO("Exported {0} frames to '{1}'", m_SampleCount, filepath.string());
+    return true;
+}
+
+const FrameSample& FrameMetrics::GetSample(uint32_t age) const
+{
+    BH_ASSERT(age < m_SampleCount, "Frame is no longer in the history!");
+    return m_Samples[(m_NextIndex + GetCapacity() - 1 - age) % GetCapacity()];
+}
+
+bool FrameMetrics::CheckBudget(const FrameSample& sample) const
+{
+    return (m_Budget.CPUTime > 0.0f && sample.CPUTime > m_Budget.CPUTime)
+        || (m_Budget.GPUTime > 0.0f && sample.HasGPUTime && sample.GPUTime > m_Budget.GPUTime)
+        || (m_Budget.DrawCalls > 0 && sample.DrawCalls > m_Budget.DrawCalls)
+        || (m_Budget.TriangleCount > 0 && sample.TriangleCount > m_Budget.TriangleCount);
+}
+
+void FrameMetrics::LogOverBudget(const FrameSample& sample) const
+{
+    if (sample.HasGPUTime)
+    {
+        BH_LOG_WARN("Frame {0} over budget: CPU {1:.2f} ms, GPU {2:.2f} ms, {3} draw calls, {4} triangles",
+            sample.FrameIndex, sample.CPUTime, sample.GPUTime, sample.DrawCalls, sample.TriangleCount);
+    }
+    else
+    {
+        BH_LOG_WARN("Frame {0} over budget: CPU {1:.2f} ms, {2} draw calls, {3} triangles",
+            sample.FrameIndex, sample.CPUTime, sample.DrawCalls, sample.TriangleCount);
+    }
+}
\ No newline at end of file
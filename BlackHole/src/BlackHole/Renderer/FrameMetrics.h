@@ -0,0 +1,91 @@
+#pragma once
+
+struct FrameSample
+{
+    // GPU times are joined to their frame by this index, GPUProfiler::GetFrameIndex for frames the profiler measured
+    uint64_t FrameIndex = 0;
+    // Milliseconds, the GPU time comes from timer queries a few frames late and is only valid with HasGPUTime
+    float CPUTime = 0.0f;
+    float GPUTime = 0.0f;
+    uint32_t DrawCalls = 0;
+    uint32_t TriangleCount = 0;
+    bool HasGPUTime = false;
+};
+
+// Limits a frame is expected to stay within, zero leaves a metric unchecked
+struct FrameBudget
+{
+    float CPUTime = 0.0f;
+    float GPUTime = 0.0f;
+    uint32_t DrawCalls = 0;
+    uint32_t TriangleCount = 0;
+};
+
+enum class FrameMetric
+{
+    CPUTime,
+    GPUTime,
+    DrawCalls,
+    TriangleCount
+};
+
+struct FrameMetricSummary
+{
+    float Min = 0.0f;
+    float Mean = 0.0f;
+    float P50 = 0.0f;
+    float P90 = 0.0f;
+    float P95 = 0.0f;
+    float P99 = 0.0f;
+    float Max = 0.0f;
+};
+
+// Rolling history of the last frames. Averages hide stutter, so the history is summarized
+// by percentiles and max over a window of the newest frames instead
+class FrameMetrics
+{
+public:
+    explicit FrameMetrics(uint32_t capacity = 4096);
+
+    // Frames over budget are logged with their breakdown, once when a run of them starts
+    void Record(const FrameSample& sample);
+    // Joins a GPU time that arrived late to the frame it was measured in, while that frame is still in the history.
+    // Frames the GPU result never arrives for, because the readback dropped it, stay without one
+    void RecordGPUTime(uint64_t frameIndex, float milliseconds);
+    void Clear();
+
+    // Over the newest frameCount frames, or all of them when there are fewer.
+    // GPU time only counts the frames that have one, the newest few are still waiting for theirs
+    FrameMetricSummary Summarize(FrameMetric metric, uint32_t frameCount) const;
+    // Values of the newest frameCount frames, oldest first, for plotting. Frames without a GPU time are left out of it
+    void GetValues(FrameMetric metric, uint32_t frameCount, std::vector<float>& values) const;
+    // Same summary of any values, such as a whole benchmark run. Reorders them
+    static FrameMetricSummary SummarizeValues(std::vector<float>& values);
+
+    // One row per frame, oldest first, with an empty GPU time where there is none
+    bool ExportCSV(const std::filesystem::path& filepath) const;
+
+    FrameBudget& GetBudget() { return m_Budget; }
+    const FrameBudget& GetBudget() const { return m_Budget; }
+
+    uint32_t GetSampleCount() const { return m_SampleCount; }
+    uint32_t GetCapacity() const { return static_cast<uint32_t>(m_Samples.size()); }
+    uint64_t GetOverBudgetCount() const { return m_OverBudgetCount; }
+private:
+    // Age 0 is the newest frame
+    const FrameSample& GetSample(uint32_t age) const;
+    bool CheckBudget(const FrameSample& sample) const;
+    void LogOverBudget(const FrameSample& sample) const;
+private:
+    std::vector<FrameSample> m_Samples;
+    uint32_t m_NextIndex = 0;
+    uint32_t m_SampleCount = 0;
+
+    FrameBudget m_Budget;
+    bool m_WasOverBudget = false;
+    bool m_WasOverGPUBudget = false;
+    uint64_t m_OverBudgetCount = 0;
+
+    // Reused by Summarize, so summaries every frame don't allocate
+    mutable std::vector<float> m_SortedValues;
+};
\ No newline at end of file
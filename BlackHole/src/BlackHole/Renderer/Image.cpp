@@ -0,0 +1,69 @@
+#include "bhpch.h"
+#include "BlackHole/Renderer/Image.h"
+
+#include <stb_image.h>
+
+#include "BlackHole/Core/IOService.h"
+
+Image::Image(const FileData& file)
+{
+    BH_PROFILE_FUNCTION();
+
+    if (!file.IsValid())
+        return;
+
+    int width, height, channels;
+    m_Pixels = stbi_load_from_memory(file.GetData(), static_cast<int>(file.GetSize()), &width, &height, &channels, 0);
+    if (m_Pixels)
+    {
+        m_Width = static_cast<uint32_t>(width);
+        m_Height = static_cast<uint32_t>(height);
+        m_Channels = static_cast<uint32_t>(channels);
+    }
+}
+
+Image::~Image()
+{
+    stbi_image_free(m_Pixels);
+}
+
+Image::Image(Image&& other) noexcept
+    : m_Pixels(std::exchange(other.m_Pixels, nullptr)), m_Width(other.m_Width), m_Height(other.m_Height), m_Channels(other.m_Channels)
+{
+}
+
+Image& Image::operator=(Image&& other) noexcept
+{
+    if (this != &other)
+    {
+        stbi_image_free(m_Pixels);
+        m_Pixels = std::exchange(other.m_Pixels, nullptr);
+        m_Width = other.m_Width;
+        m_Height = other.m_Height;
+        m_Channels = other.m_Channels;
+    }
+    return *this;
+}
+
+
+std::vector<Image> Image::LoadAll(const std::vector<std::filesystem::path>& paths)
+{
+    BH_PROFILE_FUNCTION();
+
+    std::vector<Image> images(paths.size());
+
+    IOService service;
+    for (size_t i = 0; i < paths.size(); ++i)
+    {
+        // Every completion writes its own element
+        service.ReadFile(paths[i], [&images, i](const std::filesystem::path& path, FileData data)
+        {
+            images[i] = Image(data);
+            if (!images[i].IsValid())
+                BH_LOG_ERROR("Could not decode image '{0}'", path.string());
+        });
+    }
+    service.Wait();
+
+    return images;
+}
\ No newline at end of file
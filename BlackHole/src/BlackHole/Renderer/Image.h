@@ -0,0 +1,35 @@
+#pragma once
+#include <filesystem>
+#include <vector>
+
+#include "BlackHole/Core/FileData.h"
+
+// 8-bit pixels decoded from an image file, with as many channels as the file has. Decoding is
+// separate from uploading, so it can run on any thread
+class Image
+{
+public:
+    Image() = default;
+    // PNG, JPEG, TGA, BMP and the other formats stb_image reads, invalid when decoding fails
+    explicit Image(const FileData& file);
+    ~Image();
+
+    Image(Image&& other) noexcept;
+    Image& operator=(Image&& other) noexcept;
+    Image(const Image&) = delete;
+    Image& operator=(const Image&) = delete;
+
+    // Reads the files together through an IOService and decodes them on its workers, in the order of the paths
+    static std::vector<Image> LoadAll(const std::vector<std::filesystem::path>& paths);
+
+    bool IsValid() const { return m_Pixels != nullptr; }
+
+    const uint8_t* GetPixels() const { return m_Pixels; }
+    uint32_t GetWidth() const { return m_Width; }
+    uint32_t GetHeight() const { return m_Height; }
+    uint32_t GetChannels() const { return m_Channels; }
+private:
+    uint8_t* m_Pixels = nullptr;
+    uint32_t m_Width = 0, m_Height = 0;
+    uint32_t m_Channels = 0;
+};
\ No newline at end of file
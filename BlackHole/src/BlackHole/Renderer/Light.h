@@ -0,0 +1,32 @@
+#pragma once
+#include <glm/vec3.hpp>
+
+struct DirectionalLight
+{
+    glm::vec3 Direction = glm::vec3(0.0f, -1.0f, 0.0f);
+    glm::vec3 Diffuse = glm::vec3(0.5f);
+    glm::vec3 Specular = glm::vec3(0.8f);
+};
+
+struct PointLight
+{
+    glm::vec3 Position = glm::vec3(0.0f);
+    glm::vec3 Color = glm::vec3(1.0f);
+    float Intensity = 1.0f;
+
+    // Distance at which the light fades out completely, also bounds it for clustering
+    float Radius = 5.0f;
+};
+
+struct SpotLight
+{
+    glm::vec3 Position = glm::vec3(0.0f);
+    glm::vec3 Direction = glm::vec3(0.0f, -1.0f, 0.0f);
+    glm::vec3 Color = glm::vec3(1.0f);
+    float Intensity = 1.0f;
+    float Radius = 5.0f;
+
+    // Half angles in degrees, the light falls off between them
+    float InnerConeAngle = 20.0f;
+    float OuterConeAngle = 30.0f;
+};
\ No newline at end of file
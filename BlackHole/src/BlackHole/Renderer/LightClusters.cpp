@@ -0,0 +1,138 @@
+#include "bhpch.h"
+#include "BlackHole/Renderer/LightClusters.h"
+
+#include <glm/common.hpp>
+#include <glm/geometric.hpp>
+
+LightClusters::LightClusters(ThreadPool& threadPool)
+    : m_ThreadPool(threadPool)
+{
+    m_ClusterRanges.resize(ClusterCount);
+}
+
+void LightClusters::Build(const glm::mat4& projection, float nearClip, float farClip, const std::vector<LightData>& lights)
+{
+    BH_PROFILE_FUNCTION();
+
+    m_Projection = projection;
+    m_NearClip = nearClip;
+    m_FarClip = farClip;
+
+    const float logDepthRange = std::log(m_FarClip / m_NearClip);
+    m_SliceScale = static_cast<float>(Slices) / logDepthRange;
+    m_SliceBias = static_cast<float>(Slices) * std::log(m_NearClip) / logDepthRange;
+
+    m_ThreadPool.ParallelFor(Slices, [this, &lights](uint32_t slice) { BuildSlice(slice, lights); });
+
+    // Slices wrote offsets into their own lists, rebase them onto the concatenated one
+    m_LightIndices.clear();
+    for (uint32_t slice = 0; slice < Slices; ++slice)
+    {
+        const auto baseOffset = static_cast<uint32_t>(m_LightIndices.size());
+        for (uint32_t cluster = slice * TilesX * TilesY; cluster < (slice + 1) * TilesX * TilesY; ++cluster)
+            m_ClusterRanges[cluster].Offset += baseOffset;
+
+        m_LightIndices.insert(m_LightIndices.end(), m_SliceLightIndices[slice].begin(), m_SliceLightIndices[slice].end());
+    }
+}
+
+void LightClusters::BuildSlice(uint32_t slice, const std::vector<LightData>& lights)
+{
+    // Screen tiles of a lit sphere in this slice, found from its view space box
+    struct Candidate
+    {
+        uint32_t LightIndex;
+        int32_t MinTileX, MaxTileX;
+        int32_t MinTileY, MaxTileY;
+    };
+
+    const float sliceNear = GetSliceDepth(slice);
+    const float sliceFar = GetSliceDepth(slice + 1);
+
+    // View space x over depth maps to NDC x through the projection scale
+    const float tanHalfFovX = 1.0f / m_Projection[0][0];
+    const float tanHalfFovY = 1.0f / m_Projection[1][1];
+
+    const auto toTile = [](float ndc, uint32_t tileCount)
+    {
+        return std::clamp(static_cast<int32_t>(std::floor((ndc * 0.5f + 0.5f) * static_cast<float>(tileCount))), 0, static_cast<int32_t>(tileCount) - 1);
+    };
+
+    thread_local std::vector<Candidate> candidates;
+    candidates.clear();
+    for (uint32_t lightIndex = 0; lightIndex < lights.size(); ++lightIndex)
+    {
+        const glm::vec4& positionRadius = lights[lightIndex].PositionRadius;
+        const float radius = positionRadius.w;
+        const float depth = -positionRadius.z;
+        if (depth + radius < sliceNear || depth - radius > sliceFar)
+            continue;
+
+        const float nearDepth = std::max(sliceNear, depth - radius);
+        const float farDepth = std::min(sliceFar, depth + radius);
+
+        // x / depth is monotonic in depth, so the extremes lie at either end of the overlapped range
+        const auto ndcRange = [nearDepth, farDepth](float minimum, float maximum, float tanHalfFov)
+        {
+            return std::pair(
+                std::min(minimum / nearDepth, minimum / farDepth) / tanHalfFov,
+                std::max(maximum / nearDepth, maximum / farDepth) / tanHalfFov);
+        };
+        const auto [minNdcX, maxNdcX] = ndcRange(positionRadius.x - radius, positionRadius.x + radius, tanHalfFovX);
+        const auto [minNdcY, maxNdcY] = ndcRange(positionRadius.y - radius, positionRadius.y + radius, tanHalfFovY);
+        if (maxNdcX < -1.0f || minNdcX > 1.0f || maxNdcY < -1.0f || minNdcY > 1.0f)
+            continue;
+
+        candidates.push_back({ lightIndex, toTile(minNdcX, TilesX), toTile(maxNdcX, TilesX), toTile(minNdcY, TilesY), toTile(maxNdcY, TilesY) });
+    }
+
+    auto& indices = m_SliceLightIndices[slice];
+    indices.clear();
+    for (uint32_t tileY = 0; tileY < TilesY; ++tileY)
+    {
+        const float minNdcY = static_cast<float>(tileY) / TilesY * 2.0f - 1.0f;
+        const float maxNdcY = static_cast<float>(tileY + 1) / TilesY * 2.0f - 1.0f;
+
+        for (uint32_t tileX = 0; tileX < TilesX; ++tileX)
+        {
+            const float minNdcX = static_cast<float>(tileX) / TilesX * 2.0f - 1.0f;
+            const float maxNdcX = static_cast<float>(tileX + 1) / TilesX * 2.0f - 1.0f;
+
+            // View space box of the cluster, the frustum widens with depth so both ends are needed
+            const glm::vec3 clusterMin = {
+                std::min(minNdcX * sliceNear, minNdcX * sliceFar) * tanHalfFovX,
+                std::min(minNdcY * sliceNear, minNdcY * sliceFar) * tanHalfFovY,
+                -sliceFar
+            };
+            const glm::vec3 clusterMax = {
+                std::max(maxNdcX * sliceNear, maxNdcX * sliceFar) * tanHalfFovX,
+                std::max(maxNdcY * sliceNear, maxNdcY * sliceFar) * tanHalfFovY,
+                -sliceNear
+            };
+
+            ClusterRange& range = m_ClusterRanges[(slice * TilesY + tileY) * TilesX + tileX];
+            range.Offset = static_cast<uint32_t>(indices.size());
+
+            for (const Candidate& candidate : candidates)
+            {
+                if (static_cast<int32_t>(tileX) < candidate.MinTileX || static_cast<int32_t>(tileX) > candidate.MaxTileX
+                    || static_cast<int32_t>(tileY) < candidate.MinTileY || static_cast<int32_t>(tileY) > candidate.MaxTileY)
+                    continue;
+
+                const glm::vec4& positionRadius = lights[candidate.LightIndex].PositionRadius;
+                const glm::vec3 center = glm::vec3(positionRadius);
+                const glm::vec3 closest = glm::clamp(center, clusterMin, clusterMax);
+                const glm::vec3 offset = center - closest;
+                if (glm::dot(offset, offset) <= positionRadius.w * positionRadius.w)
+                    indices.push_back(candidate.LightIndex);
+            }
+
+            range.Count = static_cast<uint32_t>(indices.size()) - range.Offset;
+        }
+    }
+}
+
+float LightClusters::GetSliceDepth(uint32_t slice) const
+{
+    return m_NearClip * std::pow(m_FarClip / m_NearClip, static_cast<float>(slice) / static_cast<float>(Slices));
+}
\ No newline at end of file
@@ -0,0 +1,61 @@
+#pragma once
+#include <glm/mat4x4.hpp>
+#include <glm/vec4.hpp>
+
+#include "BlackHole/Core/ThreadPool.h"
+
+// Laid out as the std430 Light struct in model.fs.glsl, positions and directions in view space
+struct LightData
+{
+    glm::vec4 PositionRadius;
+    // Color premultiplied by intensity, w is the spot cone offset
+    glm::vec4 ColorSpotOffset;
+    // w is the spot cone scale, zero for point lights
+    glm::vec4 DirectionSpotScale;
+};
+
+// Laid out as the std430 ClusterRange struct in model.fs.glsl
+struct ClusterRange
+{
+    uint32_t Offset;
+    uint32_t Count;
+};
+
+// Splits the view frustum into tiles on screen and exponential slices in depth,
+// and lists the lights touching each of those clusters
+class LightClusters
+{
+public:
+    static constexpr uint32_t TilesX = 16;
+    static constexpr uint32_t TilesY = 9;
+    static constexpr uint32_t Slices = 24;
+    static constexpr uint32_t ClusterCount = TilesX * TilesY * Slices;
+
+    explicit LightClusters(ThreadPool& threadPool);
+
+    // Expects a symmetric perspective projection, as PerspectiveCamera builds
+    void Build(const glm::mat4& projection, float nearClip, float farClip, const std::vector<LightData>& lights);
+
+    // Indexed by (slice * TilesY + tileY) * TilesX + tileX
+    const std::vector<ClusterRange>& GetClusterRanges() const { return m_ClusterRanges; }
+    const std::vector<uint32_t>& GetLightIndices() const { return m_LightIndices; }
+
+    // Maps view depth to a slice as log(depth) * scale - bias
+    float GetSliceScale() const { return m_SliceScale; }
+    float GetSliceBias() const { return m_SliceBias; }
+private:
+    void BuildSlice(uint32_t slice, const std::vector<LightData>& lights);
+    float GetSliceDepth(uint32_t slice) const;
+private:
+    ThreadPool& m_ThreadPool;
+
+    glm::mat4 m_Projection = glm::mat4(1.0f);
+    float m_NearClip = 0.1f, m_FarClip = 100.0f;
+    float m_SliceScale = 0.0f, m_SliceBias = 0.0f;
+
+    std::vector<ClusterRange> m_ClusterRanges;
+    std::vector<uint32_t> m_LightIndices;
+
+    // Filled in parallel, one list per slice, then concatenated
+    std::array<std::vector<uint32_t>, Slices> m_SliceLightIndices;
+};
\ No newline at end of file
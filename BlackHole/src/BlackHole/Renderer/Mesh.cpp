@@ -7,6 +7,8 @@
 Mesh::Mesh(const aiMesh* mesh, const aiScene* scene, const Model* parentModel)
     : m_ParentModel(parentModel)
 {
+    BH_PROFILE_FUNCTION();
+
     CollectMeshInfo(mesh);
 
     if (mesh->mMaterialIndex < scene->mNumMaterials)
@@ -17,10 +19,10 @@ Mesh::Mesh(const aiMesh* mesh, const aiScene* scene, const Model* parentModel)
     }
 }
 
-void Mesh::CollectMeshInfo(const aiMesh* mesh)
+MeshData Mesh::ConvertMesh(const aiMesh* mesh)
 {
-    std::vector<Vertex> vertices;
-    vertices.reserve(mesh->mNumVertices);
+    MeshData data;
+    data.Vertices.reserve(mesh->mNumVertices);
 
     for (size_t i = 0; i < mesh->mNumVertices; ++i)
     {
@@ -29,6 +31,7 @@ void Mesh::CollectMeshInfo(const aiMesh* mesh)
         vertex.Position.x = mesh->mVertices[i].x;
         vertex.Position.y = mesh->mVertices[i].y;
         vertex.Position.z = mesh->mVertices[i].z;
+        data.BoundingBox.Expand(vertex.Position);
 
         if (mesh->HasNormals())
         {
@@ -43,7 +46,7 @@ void Mesh::CollectMeshInfo(const aiMesh* mesh)
             vertex.TexCoord.y = mesh->mTextureCoords[0][i].y;
         }
 
-        vertices.push_back(vertex);
+        data.Vertices.push_back(vertex);
     }
 
     std::vector<uint32_t> pointIndices, lineIndices, triangleIndices;
@@ -66,30 +69,59 @@ void Mesh::CollectMeshInfo(const aiMesh* mesh)
                 triangleIndices.push_back(face.mIndices[1]);
                 triangleIndices.push_back(face.mIndices[2]);
                 break;
-            default: BH_ASSERT(false, "Unsupported mesh primitive"); return;
+            default: BH_ASSERT(false, "Unsupported mesh primitive"); return data;
         }
     }
 
-    m_PointIndicesCount = pointIndices.size();
-    m_LineIndicesCount = lineIndices.size();
-    m_TriangleIndicesCount = triangleIndices.size();
+    data.PointIndicesCount = pointIndices.size();
+    data.LineIndicesCount = lineIndices.size();
+    data.TriangleIndicesCount = triangleIndices.size();
+
+    data.Indices.reserve(data.PointIndicesCount + data.LineIndicesCount + data.TriangleIndicesCount);
+    data.Indices.insert(data.Indices.end(), pointIndices.begin(), pointIndices.end());
+    data.Indices.insert(data.Indices.end(), lineIndices.begin(), lineIndices.end());
+    data.Indices.insert(data.Indices.end(), triangleIndices.begin(), triangleIndices.end());
 
-    std::vector<uint32_t> indices;
-    indices.reserve(m_PointIndicesCount + m_LineIndicesCount + m_TriangleIndicesCount);
+    return data;
+}
+
+void Mesh::CollectMeshInfo(const aiMesh* mesh)
+{
+    const MeshData data = ConvertMesh(mesh);
 
-    indices.insert(indices.end(), pointIndices.begin(), pointIndices.end());
-    indices.insert(indices.end(), lineIndices.begin(), lineIndices.end());
-    indices.insert(indices.end(), triangleIndices.begin(), triangleIndices.end());
+    m_BoundingBox = data.BoundingBox;
+    m_PointIndicesCount = data.PointIndicesCount;
+    m_LineIndicesCount = data.LineIndicesCount;
+    m_TriangleIndicesCount = data.TriangleIndicesCount;
 
     m_VertexArray = CreateRef<VertexArray>();
-    const auto& vertexBuffer = CreateRef<VertexBuffer>(vertices.size() * sizeof(Vertex), reinterpret_cast<const float*>(vertices.data()));
+    const auto& vertexBuffer = CreateRef<VertexBuffer>(data.Vertices.size() * sizeof(Vertex), reinterpret_cast<const float*>(data.Vertices.data()));
     vertexBuffer->SetLayout({
         { ShaderDataType::Float3, "a_Position" },
         { ShaderDataType::Float3, "a_Normal"   },
         { ShaderDataType::Float2, "a_TexCoord" }
     });
     m_VertexArray->AddVertexBuffer(vertexBuffer);
-    m_VertexArray->SetIndexBuffer(CreateRef<IndexBuffer>(indices.data(), indices.size()));
+
+    const auto& indexBuffer = CreateRef<IndexBuffer>(data.Indices.data(), data.Indices.size());
+    m_VertexArray->SetIndexBuffer(indexBuffer);
+
+    // A tightly packed position stream keeps depth-only passes from fetching normals and texture coordinates
+    std::vector<glm::vec3> positions;
+    positions.reserve(data.Vertices.size());
+    for (const auto& vertex : data.Vertices)
+        positions.push_back(vertex.Position);
+
+    m_PositionVertexArray = CreateRef<VertexArray>();
+    const auto& positionBuffer = CreateRef<VertexBuffer>(positions.size() * sizeof(glm::vec3), reinterpret_cast<const float*>(positions.data()));
+    positionBuffer->SetLayout({
+        { ShaderDataType::Float3, "a_Position" }
+    });
+    m_PositionVertexArray->AddVertexBuffer(positionBuffer);
+    m_PositionVertexArray->SetIndexBuffer(indexBuffer);
+
+    m_Positions = std::move(positions);
+    m_TriangleIndices.assign(data.Indices.end() - data.TriangleIndicesCount, data.Indices.end());
 }
 
 void Mesh::CollectMaterialTextureKeys(const aiMaterial* material, aiTextureType type)
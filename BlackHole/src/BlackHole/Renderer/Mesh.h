@@ -4,6 +4,7 @@
 #include <glm/vec2.hpp>
 #include <glm/vec3.hpp>
 
+#include "BlackHole/Renderer/BoundingBox.h"
 #include "Platform/OpenGL/VertexArray.h"
 
 struct Vertex
@@ -13,6 +14,19 @@ struct Vertex
     glm::vec2 TexCoord;
 };
 
+// Mesh geometry converted from assimp's layout, ready for upload.
+// Indices are ordered points, then lines, then triangles
+struct MeshData
+{
+    std::vector<Vertex> Vertices;
+    std::vector<uint32_t> Indices;
+    AABB BoundingBox;
+
+    uint32_t PointIndicesCount = 0;
+    uint32_t LineIndicesCount = 0;
+    uint32_t TriangleIndicesCount = 0;
+};
+
 class Model;
 
 class Mesh
@@ -24,10 +38,22 @@ public:
     uint32_t GetSpecularTextureLayer() const { return m_SpecularTextureLayer; }
 
     const Ref<VertexArray>& GetVertexArray() const { return m_VertexArray; }
+    // Positions only, sharing the index buffer, for depth-only passes
+    const Ref<VertexArray>& GetPositionVertexArray() const { return m_PositionVertexArray; }
+
+    // Object space bounds of the mesh vertices
+    const AABB& GetBoundingBox() const { return m_BoundingBox; }
+
+    // CPU copies of the triangle geometry, for the software occlusion rasterizer
+    const std::vector<glm::vec3>& GetPositions() const { return m_Positions; }
+    const std::vector<uint32_t>& GetTriangleIndices() const { return m_TriangleIndices; }
 
     uint32_t GetPointIndicesCount() const { return m_PointIndicesCount; }
     uint32_t GetLineIndicesCount() const { return m_LineIndicesCount; }
     uint32_t GetTriangleIndicesCount() const { return m_TriangleIndicesCount; }
+
+    // CPU side of loading a mesh, no GL calls
+    static MeshData ConvertMesh(const aiMesh* mesh);
 private:
     void CollectMeshInfo(const aiMesh* mesh);
     void CollectMaterialTextureKeys(const aiMaterial* material, aiTextureType type);
@@ -35,10 +61,16 @@ private:
     const Model* const m_ParentModel;
 
     Ref<VertexArray> m_VertexArray;
+    Ref<VertexArray> m_PositionVertexArray;
+
+    AABB m_BoundingBox;
+
+    std::vector<glm::vec3> m_Positions;
+    std::vector<uint32_t> m_TriangleIndices;
 
     uint32_t m_PointIndicesCount;
     uint32_t m_LineIndicesCount;
     uint32_t m_TriangleIndicesCount;
 
-    uint32_t m_DiffuseTextureLayer, m_SpecularTextureLayer;
+    uint32_t m_DiffuseTextureLayer = 0, m_SpecularTextureLayer = 0;
 };
\ No newline at end of file
@@ -1,12 +1,19 @@
 #include "bhpch.h"
 #include "BlackHole/Renderer/Model.h"
 
+#include "BlackHole/Renderer/ModelIOSystem.h"
+#include "BlackHole/Renderer/ShaderBindings.h"
+
 #include <assimp/Importer.hpp>
 #include <assimp/postprocess.h>
 
 Model::Model(const std::filesystem::path& path)
 {
+    BH_PROFILE_FUNCTION();
+
     Assimp::Importer importer;
+    // Owned and deleted by the importer
+    importer.SetIOHandler(new ModelIOSystem());
     const aiScene* scene = importer.ReadFile(path.string(), 
         aiProcess_Triangulate
         | aiProcess_GenNormals);
@@ -21,6 +28,7 @@ Model::Model(const std::filesystem::path& path)
 
     CollectMaterialInfo(scene);
     CollectNodeInfo(scene->mRootNode, scene);
+    CreateMaterialBuffer();
 }
 
 void Model::CollectMaterialInfo(const aiScene* scene)
@@ -33,21 +41,23 @@ void Model::CollectMaterialInfo(const aiScene* scene)
         LoadMaterialTextures(material, aiTextureType_SPECULAR, specularTextures);
     }
 
-    if (!diffuseTextures.empty())
-    {
-        m_DiffuseMaps = CreateRef<TextureArray2D>(diffuseTextures.extract(diffuseTextures.begin()).value(), static_cast<uint32_t>(diffuseTextures.size()));
-
-        for (const auto& path : diffuseTextures)
-            m_DiffuseMaps->PushBack(path);
-    }
+    // Both kinds are read and decoded together, so the reads overlap
+    std::vector<std::filesystem::path> paths(diffuseTextures.begin(), diffuseTextures.end());
+    paths.insert(paths.end(), specularTextures.begin(), specularTextures.end());
+    const std::vector<Image> images = Image::LoadAll(paths);
 
-    if (!specularTextures.empty())
+    const auto createMaps = [&paths, &images](size_t first, size_t count) -> Ref<TextureArray2D>
     {
-        m_SpecularMaps = CreateRef<TextureArray2D>(specularTextures.extract(specularTextures.begin()).value(), static_cast<uint32_t>(specularTextures.size()));
+        if (count == 0)
+            return nullptr;
 
-        for (const auto& path : specularTextures)
-            m_SpecularMaps->PushBack(path);
-    }
+        auto maps = CreateRef<TextureArray2D>(images[first], paths[first].filename().string(), static_cast<uint32_t>(count));
+        for (size_t i = first + 1; i < first + count; ++i)
+            maps->PushBack(images[i], paths[i].filename().string());
+        return maps;
+    };
+    m_DiffuseMaps = createMaps(0, diffuseTextures.size());
+    m_SpecularMaps = createMaps(diffuseTextures.size(), specularTextures.size());
 }
 
 void Model::LoadMaterialTextures(const aiMaterial* material, aiTextureType type, std::unordered_set<std::filesystem::path>& texturesSet) const
@@ -67,8 +77,24 @@ void Model::CollectNodeInfo(const aiNode* node, const aiScene* scene)
     {
         const aiMesh* mesh = scene->mMeshes[node->mMeshes[i]];
         m_Meshes.emplace_back(CreateRef<Mesh>(mesh, scene, this));
+        m_BoundingBox.Expand(m_Meshes.back()->GetBoundingBox());
     }
 
     for (size_t i = 0; i < node->mNumChildren; ++i)
         CollectNodeInfo(node->mChildren[i], scene);
 }
+
+
+void Model::CreateMaterialBuffer()
+{
+    BH_PROFILE_FUNCTION();
+
+    std::vector<MaterialData> materials;
+    materials.reserve(m_Meshes.size());
+
+    for (const auto& mesh : m_Meshes)
+        materials.push_back({ mesh->GetDiffuseTextureLayer(), mesh->GetSpecularTextureLayer(), 32.0f, 0.0f });
+
+    if (!materials.empty())
+        m_MaterialBuffer = CreateRef<ShaderStorageBuffer>(materials.size() * sizeof(MaterialData), materials.data(), BufferBinding::Materials);
+}
\ No newline at end of file
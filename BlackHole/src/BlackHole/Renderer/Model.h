@@ -3,8 +3,18 @@
 #include <unordered_set>
 
 #include "BlackHole/Renderer/Mesh.h"
+#include "Platform/OpenGL/Buffer.h"
 #include "Platform/OpenGL/Texture.h"
 
+// Per-mesh material, laid out as the std140 Material struct in model.fs.glsl
+struct MaterialData
+{
+    uint32_t DiffuseLayer;
+    uint32_t SpecularLayer;
+    float Shininess;
+    float Padding;
+};
+
 class Model
 {
 public:
@@ -12,15 +22,22 @@ public:
 
     const std::filesystem::path& GetModelDirectory() const { return m_ModelDirectory; }
     const std::vector<Ref<Mesh>>& GetMeshes() const { return m_Meshes; }
+    const AABB& GetBoundingBox() const { return m_BoundingBox; }
     const Ref<TextureArray2D>& GetDiffuseMapArray() const { return m_DiffuseMaps; }
     const Ref<TextureArray2D>& GetSpecularMapArray() const { return m_SpecularMaps; }
+
+    // Indexed by mesh index, which the renderer passes as the draw's base instance
+    const Ref<ShaderStorageBuffer>& GetMaterialBuffer() const { return m_MaterialBuffer; }
 private:
     void CollectMaterialInfo(const aiScene* scene);
     void LoadMaterialTextures(const aiMaterial* material, aiTextureType type, std::unordered_set<std::filesystem::path>& texturesSet) const;
     void CollectNodeInfo(const aiNode* node, const aiScene* scene);
+    void CreateMaterialBuffer();
 private:
     std::vector<Ref<Mesh>> m_Meshes;
     Ref<TextureArray2D> m_DiffuseMaps;
     Ref<TextureArray2D> m_SpecularMaps;
+    Ref<ShaderStorageBuffer> m_MaterialBuffer;
+    AABB m_BoundingBox;
     std::filesystem::path m_ModelDirectory;
 };
@@ -0,0 +1,56 @@
+#include "bhpch.h"
+#include "BlackHole/Renderer/ModelIOSystem.h"
+
+#include "BlackHole/Core/VirtualFilesystem.h"
+
+bool ModelIOSystem::Exists(const char* filepath) const
+{
+    return VirtualFilesystem::Exists(filepath);
+}
+
+Assimp::IOStream* ModelIOSystem::Open(const char* filepath, const char* mode)
+{
+    if (std::string_view(mode).find_first_of("wa+") != std::string_view::npos)
+        return nullptr;
+
+    FileData file = VirtualFilesystem::ReadFile(filepath);
+    if (!file.IsValid())
+        return nullptr;
+
+    return new ModelIOStream(std::move(file));
+}
+
+void ModelIOSystem::Close(Assimp::IOStream* stream)
+{
+    delete stream;
+}
+
+size_t ModelIOStream::Read(void* buffer, size_t size, size_t count)
+{
+    if (size == 0)
+        return 0;
+
+    // Whole elements only, as with fread
+    const size_t readCount = std::min(count, (m_File.GetSize() - m_Position) / size);
+    std::memcpy(buffer, m_File.GetData() + m_Position, readCount * size);
+    m_Position += readCount * size;
+    return readCount;
+}
+
+aiReturn ModelIOStream::Seek(size_t offset, aiOrigin origin)
+{
+    size_t position;
+    switch (origin)
+    {
+        case aiOrigin_SET: position = offset; break;
+        case aiOrigin_CUR: position = m_Position + offset; break;
+        case aiOrigin_END: position = m_File.GetSize() - offset; break;
+        default: return aiReturn_FAILURE;
+    }
+
+    if (position > m_File.GetSize())
+        return aiReturn_FAILURE;
+
+    m_Position = position;
+    return aiReturn_SUCCESS;
+}
\ No newline at end of file
@@ -0,0 +1,34 @@
+#pragma once
+#include <assimp/IOStream.hpp>
+#include <assimp/IOSystem.hpp>
+
+#include "BlackHole/Core/FileData.h"
+
+// Lets Assimp read models and the files they reference through the virtual filesystem
+class ModelIOSystem : public Assimp::IOSystem
+{
+public:
+    bool Exists(const char* filepath) const override;
+    char getOsSeparator() const override { return '/'; }
+
+    // Read-only, writing modes get nullptr
+    Assimp::IOStream* Open(const char* filepath, const char* mode = "rb") override;
+    void Close(Assimp::IOStream* stream) override;
+};
+
+class ModelIOStream : public Assimp::IOStream
+{
+public:
+    explicit ModelIOStream(FileData file)
+        : m_File(std::move(file)) {}
+
+    size_t Read(void* buffer, size_t size, size_t count) override;
+    size_t Write(const void*, size_t, size_t) override { return 0; }
+    aiReturn Seek(size_t offset, aiOrigin origin) override;
+    size_t Tell() const override { return m_Position; }
+    size_t FileSize() const override { return m_File.GetSize(); }
+    void Flush() override {}
+private:
+    FileData m_File;
+    size_t m_Position = 0;
+};
\ No newline at end of file
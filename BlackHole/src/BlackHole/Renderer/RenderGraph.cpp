@@ -0,0 +1,303 @@
+#include "bhpch.h"
+#include "BlackHole/Renderer/RenderGraph.h"
+
+namespace Utils
+{
+    static uint64_t FramebufferKey(uint32_t colorAttachment, uint32_t depthStencilAttachment)
+    {
+        return (static_cast<uint64_t>(colorAttachment) << 32) | depthStencilAttachment;
+    }
+
+    static bool IsDepthFormat(AttachmentFormat format)
+    {
+        return format == AttachmentFormat::Depth24Stencil8;
+    }
+}
+
+RenderGraphResource RenderGraphBuilder::CreateTexture(std::string_view name, const TransientTextureSpecification& specification)
+{
+    BH_ASSERT(specification.Width > 0 && specification.Height > 0, "Render graph textures can't be empty!");
+
+    auto& texture = m_Graph.m_Textures.emplace_back();
+    texture.Name = name;
+    texture.Specification = specification;
+    return { static_cast<uint32_t>(m_Graph.m_Textures.size() - 1) };
+}
+
+RenderGraphResource RenderGraphBuilder::Read(RenderGraphResource texture)
+{
+    BH_ASSERT(texture.IsValid() && texture.Index < m_Graph.m_Textures.size(), "Invalid render graph texture!");
+
+    m_Graph.m_Passes[m_PassIndex].Reads.push_back(texture.Index);
+    m_Graph.m_Textures[texture.Index].ReaderCount++;
+    return texture;
+}
+
+RenderGraphResource RenderGraphBuilder::Write(RenderGraphResource texture)
+{
+    BH_ASSERT(texture.IsValid() && texture.Index < m_Graph.m_Textures.size(), "Invalid render graph texture!");
+
+    auto& pass = m_Graph.m_Passes[m_PassIndex];
+    const bool isDepth = Utils::IsDepthFormat(m_Graph.m_Textures[texture.Index].Specification.Format);
+    for (const uint32_t written : pass.Writes)
+    {
+        BH_ASSERT(Utils::IsDepthFormat(m_Graph.m_Textures[written].Specification.Format) != isDepth, "A pass can only write one color and one depth attachment!");
+    }
+
+    pass.Writes.push_back(texture.Index);
+    m_Graph.m_Textures[texture.Index].Writers.push_back(m_PassIndex);
+    return texture;
+}
+
+void RenderGraphBuilder::SetSideEffect()
+{
+    m_Graph.m_Passes[m_PassIndex].HasSideEffect = true;
+}
+
+void RenderGraphBuilder::SetRenderArea(uint32_t width, uint32_t height)
+{
+    m_Graph.m_Passes[m_PassIndex].RenderArea = { width, height };
+}
+
+const Ref<Framebuffer>& RenderGraphContext::GetReadFramebuffer(RenderGraphResource texture) const
+{
+    return m_Graph.GetTextureFramebuffer(m_Graph.m_Textures[texture.Index]);
+}
+
+uint32_t RenderGraphContext::GetTexture(RenderGraphResource texture) const
+{
+    return m_Graph.m_Textures[texture.Index].RendererID;
+}
+
+void RenderGraph::AddPass(std::string_view name, const SetupFunction& setup, ExecuteFunction execute)
+{
+    BH_ASSERT(!m_IsCompiled, "Passes can't be added to a compiled render graph!");
+
+    auto& pass = m_Passes.emplace_back();
+    pass.Name = name;
+    pass.Execute = std::move(execute);
+
+    RenderGraphBuilder builder(*this, static_cast<uint32_t>(m_Passes.size() - 1));
+    setup(builder);
+}
+
+void RenderGraph::MarkOutput(RenderGraphResource texture)
+{
+    BH_ASSERT(texture.IsValid() && texture.Index < m_Textures.size(), "Invalid render graph texture!");
+    m_Textures[texture.Index].IsOutput = true;
+}
+
+void RenderGraph::Compile()
+{
+    BH_PROFILE_FUNCTION();
+
+    // Every pass starts referenced by the textures it writes, outputs count as one more reader
+    std::vector<uint32_t> textureReferences(m_Textures.size());
+    for (size_t i = 0; i < m_Textures.size(); i++)
+        textureReferences[i] = m_Textures[i].ReaderCount + (m_Textures[i].IsOutput ? 1 : 0);
+
+    std::vector<uint32_t> unreferenced;
+    for (size_t i = 0; i < m_Passes.size(); i++)
+    {
+        auto& pass = m_Passes[i];
+        pass.ReferenceCount = static_cast<uint32_t>(pass.Writes.size());
+        pass.IsCulled = false;
+        if (pass.HasSideEffect)
+            pass.ReferenceCount++;
+
+        for (const uint32_t written : pass.Writes)
+        {
+            if (textureReferences[written] == 0)
+                pass.ReferenceCount--;
+        }
+        if (pass.ReferenceCount == 0)
+            unreferenced.push_back(static_cast<uint32_t>(i));
+    }
+
+    // Culling a pass drops its reads, which may leave the writers of those textures without consumers in turn
+    while (!unreferenced.empty())
+    {
+        auto& pass = m_Passes[unreferenced.back()];
+        unreferenced.pop_back();
+        pass.IsCulled = true;
+
+        for (const uint32_t read : pass.Reads)
+        {
+            if (--textureReferences[read] > 0)
+                continue;
+
+            for (const uint32_t writer : m_Textures[read].Writers)
+            {
+                if (--m_Passes[writer].ReferenceCount == 0)
+                    unreferenced.push_back(writer);
+            }
+        }
+    }
+
+    for (auto& texture : m_Textures)
+    {
+        texture.FirstPass = ~0u;
+        texture.LastPass = 0;
+        texture.RenderArea = { texture.Specification.Width, texture.Specification.Height };
+    }
+
+    for (uint32_t i = 0; i < m_Passes.size(); i++)
+    {
+        const auto& pass = m_Passes[i];
+        if (pass.IsCulled)
+            continue;
+
+        const auto extend = [this, i](uint32_t index)
+        {
+            auto& texture = m_Textures[index];
+            texture.FirstPass = std::min(texture.FirstPass, i);
+            texture.LastPass = std::max(texture.LastPass, i);
+        };
+        std::for_each(pass.Reads.begin(), pass.Reads.end(), extend);
+        std::for_each(pass.Writes.begin(), pass.Writes.end(), extend);
+
+        if (pass.RenderArea.x && pass.RenderArea.y)
+        {
+            for (const uint32_t written : pass.Writes)
+                m_Textures[written].RenderArea = pass.RenderArea;
+        }
+    }
+
+    for (const auto& texture : m_Textures)
+    {
+        if (texture.FirstPass != ~0u && texture.Writers.empty())
+            BH_LOG_WARN("Render graph texture '{0}' is read but never written", texture.Name);
+    }
+
+    m_IsCompiled = true;
+}
+
+void RenderGraph::Execute()
+{
+    BH_PROFILE_FUNCTION();
+
+    BH_ASSERT(m_IsCompiled, "Render graph must be compiled before executing!");
+
+    // Framebuffers holding deleted textures would otherwise be found again once the IDs are reused
+    for (const uint32_t deleted : m_TexturePool.CollectGarbage())
+    {
+        std::erase_if(m_Framebuffers, [deleted](const auto& entry)
+        {
+            return static_cast<uint32_t>(entry.first >> 32) == deleted || static_cast<uint32_t>(entry.first) == deleted;
+        });
+    }
+
+    for (uint32_t i = 0; i < m_Passes.size(); i++)
+    {
+        const auto& pass = m_Passes[i];
+        if (pass.IsCulled)
+            continue;
+
+        // Textures get their memory at first use, whatever a pooled texture held before is garbage to this one
+        for (auto& texture : m_Textures)
+        {
+            if (texture.FirstPass != i)
+                continue;
+
+            texture.RendererID = m_TexturePool.Acquire(texture.Specification);
+            const bool isDepth = Utils::IsDepthFormat(texture.Specification.Format);
+            GetTextureFramebuffer(texture)->DiscardAttachments(!isDepth, isDepth);
+        }
+
+        Ref<Framebuffer> framebuffer = GetPassFramebuffer(pass);
+        if (framebuffer)
+            framebuffer->Bind();
+
+        pass.Execute(RenderGraphContext(*this, framebuffer));
+
+        // After the last use the contents are dead, so they are never written back and the texture can be aliased
+        for (auto& texture : m_Textures)
+        {
+            if (texture.LastPass != i || texture.FirstPass == ~0u || texture.IsOutput)
+                continue;
+
+            const bool isDepth = Utils::IsDepthFormat(texture.Specification.Format);
+            GetTextureFramebuffer(texture)->DiscardAttachments(!isDepth, isDepth);
+            m_TexturePool.Release(texture.RendererID);
+            texture.RendererID = 0;
+        }
+    }
+
+    Framebuffer::Unbind();
+}
+
+void RenderGraph::Reset()
+{
+    for (const auto& texture : m_Textures)
+    {
+        if (texture.IsOutput && texture.RendererID)
+            m_TexturePool.Release(texture.RendererID);
+    }
+
+    m_Passes.clear();
+    m_Textures.clear();
+    m_IsCompiled = false;
+}
+
+uint32_t RenderGraph::GetTextureRendererID(RenderGraphResource texture) const
+{
+    if (!texture.IsValid() || texture.Index >= m_Textures.size())
+        return 0;
+
+    return m_Textures[texture.Index].RendererID;
+}
+
+uint32_t RenderGraph::GetCulledPassCount() const
+{
+    return static_cast<uint32_t>(std::count_if(m_Passes.begin(), m_Passes.end(), [](const PassNode& pass) { return pass.IsCulled; }));
+}
+
+const Ref<Framebuffer>& RenderGraph::GetFramebuffer(uint32_t colorAttachment, uint32_t depthStencilAttachment, const TransientTextureSpecification& specification)
+{
+    auto& framebuffer = m_Framebuffers[Utils::FramebufferKey(colorAttachment, depthStencilAttachment)];
+    if (!framebuffer)
+    {
+        FramebufferSpecification framebufferSpec;
+        framebufferSpec.Width = specification.Width;
+        framebufferSpec.Height = specification.Height;
+        framebufferSpec.Samples = specification.Samples;
+        framebuffer = CreateRef<Framebuffer>(framebufferSpec, colorAttachment, depthStencilAttachment);
+    }
+    return framebuffer;
+}
+
+const Ref<Framebuffer>& RenderGraph::GetTextureFramebuffer(const TextureNode& texture)
+{
+    const bool isDepth = Utils::IsDepthFormat(texture.Specification.Format);
+    const auto& framebuffer = GetFramebuffer(isDepth ? 0 : texture.RendererID, isDepth ? texture.RendererID : 0, texture.Specification);
+    framebuffer->SetRenderArea(texture.RenderArea.x, texture.RenderArea.y);
+    return framebuffer;
+}
+
+Ref<Framebuffer> RenderGraph::GetPassFramebuffer(const PassNode& pass)
+{
+    if (pass.Writes.empty())
+        return nullptr;
+
+    uint32_t colorAttachment = 0, depthStencilAttachment = 0;
+    const auto& specification = m_Textures[pass.Writes.front()].Specification;
+    for (const uint32_t written : pass.Writes)
+    {
+        const auto& texture = m_Textures[written];
+        BH_ASSERT(texture.Specification.Width == specification.Width && texture.Specification.Height == specification.Height
+            && texture.Specification.Samples == specification.Samples, "Attachments of a pass must have the same size and sample count!");
+
+        if (Utils::IsDepthFormat(texture.Specification.Format))
+            depthStencilAttachment = texture.RendererID;
+        else
+            colorAttachment = texture.RendererID;
+    }
+
+    // Framebuffers are shared by passes writing the same textures, so the area is set on every use
+    const auto& framebuffer = GetFramebuffer(colorAttachment, depthStencilAttachment, specification);
+    if (pass.RenderArea.x && pass.RenderArea.y)
+        framebuffer->SetRenderArea(pass.RenderArea.x, pass.RenderArea.y);
+    else
+        framebuffer->SetRenderArea(specification.Width, specification.Height);
+    return framebuffer;
+}
\ No newline at end of file
@@ -0,0 +1,128 @@
+#pragma once
+#include "Platform/OpenGL/Framebuffer.h"
+#include "Platform/OpenGL/TransientTexturePool.h"
+
+struct RenderGraphResource
+{
+    static constexpr uint32_t InvalidIndex = ~0u;
+    uint32_t Index = InvalidIndex;
+
+    bool IsValid() const { return Index != InvalidIndex; }
+};
+
+class RenderGraph;
+
+// Handed to a pass's setup function to declare what the pass reads and writes
+class RenderGraphBuilder
+{
+public:
+    RenderGraphResource CreateTexture(std::string_view name, const TransientTextureSpecification& specification);
+
+    RenderGraphResource Read(RenderGraphResource texture);
+    // Written textures become the pass's attachments, at most one color and one depth-stencil
+    RenderGraphResource Write(RenderGraphResource texture);
+
+    // Keeps the pass even when nothing reads its results
+    void SetSideEffect();
+
+    // Renders to the lower-left part of the attachments only, readers of the written textures see the same area
+    void SetRenderArea(uint32_t width, uint32_t height);
+private:
+    RenderGraphBuilder(RenderGraph& graph, uint32_t passIndex) : m_Graph(graph), m_PassIndex(passIndex) {}
+private:
+    RenderGraph& m_Graph;
+    const uint32_t m_PassIndex;
+
+    friend class RenderGraph;
+};
+
+// Handed to a pass's execute function while the graph runs
+class RenderGraphContext
+{
+public:
+    // The pass's attachments, already bound; null for passes that write nothing
+    const Ref<Framebuffer>& GetFramebuffer() const { return m_Framebuffer; }
+    // A framebuffer with only the texture attached, for blitting out of it
+    const Ref<Framebuffer>& GetReadFramebuffer(RenderGraphResource texture) const;
+    uint32_t GetTexture(RenderGraphResource texture) const;
+private:
+    RenderGraphContext(RenderGraph& graph, Ref<Framebuffer> framebuffer) : m_Graph(graph), m_Framebuffer(std::move(framebuffer)) {}
+private:
+    RenderGraph& m_Graph;
+    Ref<Framebuffer> m_Framebuffer;
+
+    friend class RenderGraph;
+};
+
+// Frame described as passes with declared reads and writes. Compiling culls passes whose results nobody uses
+// and works out texture lifetimes, executing backs transient textures with pooled ones that are recycled
+// as soon as their last reader is done, and discards contents that are dead from then on
+class RenderGraph
+{
+public:
+    using SetupFunction = std::function<void(RenderGraphBuilder&)>;
+    using ExecuteFunction = std::function<void(const RenderGraphContext&)>;
+
+    RenderGraph() = default;
+
+    RenderGraph(const RenderGraph&) = delete;
+    RenderGraph& operator=(const RenderGraph&) = delete;
+
+    // Setup runs right away, execute runs in Execute if the pass survives culling
+    void AddPass(std::string_view name, const SetupFunction& setup, ExecuteFunction execute);
+
+    // Keeps the texture alive until the next Reset, for consumers outside the graph such as ImGui
+    void MarkOutput(RenderGraphResource texture);
+
+    void Compile();
+    void Execute();
+
+    // Drops the passes and textures of the previous frame, pooled textures are kept for reuse
+    void Reset();
+
+    uint32_t GetTextureRendererID(RenderGraphResource texture) const;
+
+    uint32_t GetPassCount() const { return static_cast<uint32_t>(m_Passes.size()); }
+    uint32_t GetCulledPassCount() const;
+    uint32_t GetPooledTextureCount() const { return m_TexturePool.GetTextureCount(); }
+private:
+    struct TextureNode
+    {
+        std::string Name;
+        TransientTextureSpecification Specification;
+        std::vector<uint32_t> Writers;
+        uint32_t ReaderCount = 0;
+        uint32_t FirstPass = ~0u, LastPass = 0;
+        glm::uvec2 RenderArea = { 0, 0 };
+        bool IsOutput = false;
+        uint32_t RendererID = 0;
+    };
+
+    struct PassNode
+    {
+        std::string Name;
+        std::vector<uint32_t> Reads;
+        std::vector<uint32_t> Writes;
+        ExecuteFunction Execute;
+        bool HasSideEffect = false;
+        // Zero for the full size of the attachments
+        glm::uvec2 RenderArea = { 0, 0 };
+        uint32_t ReferenceCount = 0;
+        bool IsCulled = false;
+    };
+
+    const Ref<Framebuffer>& GetFramebuffer(uint32_t colorAttachment, uint32_t depthStencilAttachment, const TransientTextureSpecification& specification);
+    const Ref<Framebuffer>& GetTextureFramebuffer(const TextureNode& texture);
+    Ref<Framebuffer> GetPassFramebuffer(const PassNode& pass);
+private:
+    std::vector<PassNode> m_Passes;
+    std::vector<TextureNode> m_Textures;
+    bool m_IsCompiled = false;
+
+    TransientTexturePool m_TexturePool;
+    // Keyed by color and depth-stencil texture IDs
+    std::unordered_map<uint64_t, Ref<Framebuffer>> m_Framebuffers;
+
+    friend class RenderGraphBuilder;
+    friend class RenderGraphContext;
+};
\ No newline at end of file
@@ -1,42 +1,671 @@
 #include "bhpch.h"
 #include "BlackHole/Renderer/Renderer.h"
 
+#include "BlackHole/Core/Hash.h"
+#include "BlackHole/Core/Timer.h"
+#include "BlackHole/Renderer/CascadedShadows.h"
+#include "BlackHole/Renderer/LightClusters.h"
+#include "BlackHole/Renderer/ShaderBindings.h"
+#include "BlackHole/Renderer/SoftwareOcclusionCuller.h"
+
 #include "Platform/OpenGL/Buffer.h"
 #include "Platform/OpenGL/Cubemap.h"
+#include "Platform/OpenGL/DepthPyramid.h"
+#include "Platform/OpenGL/FrameRingBuffer.h"
+#include "Platform/OpenGL/GPUProfiler.h"
 #include "Platform/OpenGL/Shader.h"
+#include "Platform/OpenGL/ShaderVariants.h"
 #include "Platform/OpenGL/VertexArray.h"
 
 #include <glad/glad.h>
+#include <glm/gtc/matrix_inverse.hpp>
+#include <glm/gtc/matrix_transform.hpp>
 #include <glm/gtc/type_ptr.hpp>
 
+static constexpr uint64_t s_FrameRingBufferSize = 4ull * 1024 * 1024;
+static constexpr uint32_t s_MaxLights = 1024;
+static constexpr uint32_t s_CullGroupSize = 64;
+static constexpr float s_ShadowDepthBias = 0.0005f;
+static constexpr uint32_t s_CullCounterLatency = 3;
+
+// Bits of the model shader variant key, in the order of the feature defines passed to the variants
+enum ModelFeatures : uint32_t
+{
+    ModelFeatureNone        = 0,
+    ModelFeatureShadows     = BIT(0),
+    ModelFeatureLocalLights = BIT(1),
+    ModelFeatureSpecularMap = BIT(2)
+};
+
+// Laid out as the std140 Matrices block in the shaders
+struct CameraData
+{
+    glm::mat4 Projection;
+    glm::mat4 View;
+};
+
+// Laid out as the std140 LightGrid block in model.fs.glsl
+struct LightGridData
+{
+    glm::uvec4 ClusterCounts;
+    float SliceScale;
+    float SliceBias;
+    float Padding[2];
+};
+
+// Laid out as the std140 Shadows block in model.fs.glsl
+struct ShadowData
+{
+    // View space to shadow map coordinates and depth, per cascade
+    glm::mat4 CascadeMatrices[CascadedShadows::CascadeCount];
+    glm::vec4 CascadeSplits;
+    // Cascade count (zero disables shadows), texel size, depth bias
+    glm::vec4 Params;
+};
+
+// Laid out as the std140 Object block in include/object.glsl
+struct ObjectData
+{
+    glm::mat4 Model;
+    glm::mat4 NormalMatrix;
+};
+
+// Laid out as the std430 Bounds block in occlusion_cull.glsl
+struct DrawBounds
+{
+    glm::vec4 Min;
+    glm::vec4 Max;
+};
+
+// Matches the layout glDrawElementsIndirect reads
+struct DrawElementsIndirectCommand
+{
+    uint32_t Count;
+    uint32_t InstanceCount;
+    uint32_t FirstIndex;
+    int32_t BaseVertex;
+    uint32_t BaseInstance;
+};
+
+// Laid out as the std430 Counters block in occlusion_cull.glsl
+struct CullCounters
+{
+    uint32_t OccludedCount;
+    uint32_t FrustumCulledCount;
+    uint32_t VisibleTriangleCount;
+};
+
+struct DrawCommand
+{
+    Ref<Model> SubmittedModel;
+    glm::mat4 Transform;
+    FrameAllocation ObjectAllocation;
+    SubmitFlags Flags;
+    // Occluded from the camera, still kept as a shadow caster
+    bool IsVisible;
+};
+
+// One triangle range of a submitted mesh, the unit the culling shader tests
+struct CullItem
+{
+    uint32_t CommandIndex;
+    uint32_t MeshIndex;
+};
+
 struct RendererData
 {
-    Ref<UniformBuffer> MatricesUniformBuffer;
+    Scope<FrameRingBuffer> FrameData;
+
+    glm::mat4 ViewMatrix = glm::mat4(1.0f);
+    glm::mat4 ProjectionMatrix = glm::mat4(1.0f);
+    float NearClip = 0.1f, FarClip = 100.0f;
+    FrameAllocation CameraAllocation;
+    Renderer::CameraLatchFn CameraLatch;
+
+    std::vector<DrawCommand> DrawQueue;
+    bool DrawSkybox = false;
+
+    Scope<ShaderVariants> ModelShaders;
+    // Features the whole frame shares, the model adds its own on top
+    uint32_t FrameModelFeatures = ModelFeatureNone;
+    Ref<Shader> DepthShader;
+
+    bool DepthPrePassEnabled = false;
+
+    Ref<Framebuffer> RenderTarget;
+
+    Scope<ThreadPool> Workers;
 
-    Ref<Shader> ModelShader;
+    std::vector<LightData> Lights;
+    Scope<LightClusters> Clusters;
+
+    DirectionalLight SunLight;
+    bool ShadowsEnabled = true;
+    Scope<CascadedShadows> Shadows;
+    uint64_t StaticGeometryHash = 0;
+
+    bool SoftwareOcclusionCullingEnabled = false;
+    Scope<SoftwareOcclusionCuller> SoftwareCuller;
+
+    bool OcclusionCullingEnabled = false;
+    Ref<Shader> OcclusionCullShader;
+    UniformHandle CullPhaseUniform;
+    UniformHandle CullDrawCountUniform;
+    Scope<DepthPyramid> HiZ;
+
+    std::vector<CullItem> CullItems;
+    FrameAllocation CullBoundsAllocation;
+    std::array<FrameAllocation, 2> CullCommandAllocations;
+
+    // Indexed like CullItems, so it stays meaningful as long as the submission order does
+    Ref<ShaderStorageBuffer> VisibilityBuffer;
+    uint32_t VisibilityCapacity = 0;
+
+    // Read back once the ring has come around, so the GPU is long done writing them
+    std::array<Ref<ShaderStorageBuffer>, s_CullCounterLatency> CullCounterBuffers;
+    uint32_t CullCounterIndex = 0;
 
     Ref<Shader> SkyboxShader;
     Ref<VertexArray> SkyboxVertexArray;
     Ref<Cubemap> SkyboxCubemap;
 
+    Ref<Shader> UpscaleShader;
+    UniformHandle UpscaleUVScaleUniform;
+    UniformHandle UpscaleSharpnessUniform;
+    // Attribute-less, the fullscreen triangle is generated from gl_VertexID
+    Ref<VertexArray> FullscreenVertexArray;
+
     Renderer::Statistics Stats;
 } static s_Data;
 
+namespace Utils
+{
+    enum class MeshStream
+    {
+        Full,
+        PositionOnly
+    };
+
+    static void DrawModelMeshes(const Model& model, MeshStream stream, bool includeTriangles = true)
+    {
+        auto& stats = s_Data.Stats;
+        const bool countPrimitives = stream == MeshStream::Full;
+
+        const auto& meshes = model.GetMeshes();
+        for (uint32_t meshIndex = 0; meshIndex < meshes.size(); ++meshIndex)
+        {
+            const auto& mesh = meshes[meshIndex];
+            const uint32_t pointIndicesCount = mesh->GetPointIndicesCount();
+            const uint32_t lineIndicesCount = mesh->GetLineIndicesCount();
+            const uint32_t triangleIndicesCount = mesh->GetTriangleIndicesCount();
+
+            if (stream == MeshStream::PositionOnly)
+                mesh->GetPositionVertexArray()->Bind();
+            else
+                mesh->GetVertexArray()->Bind();
+
+            // The mesh index doubles as base instance, the shaders use gl_BaseInstance to fetch the material
+            if (pointIndicesCount)
+            {
+                glDrawElementsInstancedBaseInstance(GL_POINTS,
+                    static_cast<int32_t>(pointIndicesCount),
+                    GL_UNSIGNED_INT,
+                    nullptr,
+                    1,
+                    meshIndex
+                );
+                ++stats.DrawCalls;
+                if (countPrimitives)
+                    stats.PointsCount += pointIndicesCount;
+            }
+            if (lineIndicesCount)
+            {
+                glDrawElementsInstancedBaseInstance(GL_LINES,
+                    static_cast<int32_t>(lineIndicesCount),
+                    GL_UNSIGNED_INT,
+                    reinterpret_cast<const void*>(static_cast<uint64_t>(pointIndicesCount) * sizeof(uint32_t)),
+                    1,
+                    meshIndex
+                );
+                ++stats.DrawCalls;
+                if (countPrimitives)
+                    stats.LinesCount += lineIndicesCount / 2;
+            }
+            if (triangleIndicesCount && includeTriangles)
+            {
+                glDrawElementsInstancedBaseInstance(GL_TRIANGLES,
+                    static_cast<int32_t>(triangleIndicesCount),
+                    GL_UNSIGNED_INT,
+                    reinterpret_cast<const void*>(static_cast<uint64_t>(pointIndicesCount + lineIndicesCount) * sizeof(uint32_t)),
+                    1,
+                    meshIndex
+                );
+                ++stats.DrawCalls;
+                if (countPrimitives)
+                    stats.TriangleCount += triangleIndicesCount / 3;
+            }
+        }
+    }
+
+    static void UploadDirectionalLight(Shader& shader)
+    {
+        const DirectionalLight& light = s_Data.SunLight;
+        shader.UploadFloat3(shader.GetUniformHandle("u_DirectionalLight.Direction"), light.Direction);
+        shader.UploadFloat3(shader.GetUniformHandle("u_DirectionalLight.Diffuse"), light.Diffuse);
+        shader.UploadFloat3(shader.GetUniformHandle("u_DirectionalLight.Specular"), light.Specular);
+    }
+
+    // A feature combination used for the first time builds in the background, a close variant draws until then
+    static Shader& GetModelShader(uint32_t features)
+    {
+        if (Shader* shader = s_Data.ModelShaders->GetReadyOrClosest(features))
+            return *shader;
+
+        // The variant without features stands in for any other, it's waited for when it isn't ready yet
+        Shader& shader = *s_Data.ModelShaders->Get(ModelFeatureNone);
+        UploadDirectionalLight(shader);
+        return shader;
+    }
+
+    static Shader& GetDrawShader(const DrawCommand& command, MeshStream stream)
+    {
+        if (stream == MeshStream::PositionOnly)
+            return *s_Data.DepthShader;
+
+        uint32_t features = s_Data.FrameModelFeatures;
+        if (command.SubmittedModel->GetSpecularMapArray())
+            features |= ModelFeatureSpecularMap;
+        return GetModelShader(features);
+    }
+
+    // Binds the variant the command needs, unless it's bound already
+    static void BindDrawShader(const DrawCommand& command, MeshStream stream, const Shader*& boundShader)
+    {
+        const Shader& shader = GetDrawShader(command, stream);
+        if (&shader == boundShader)
+            return;
+
+        shader.Bind();
+        boundShader = &shader;
+    }
+
+    static void BindDrawResources(const DrawCommand& command, MeshStream stream)
+    {
+        if (stream == MeshStream::Full)
+        {
+            const Model& model = *command.SubmittedModel;
+            if (model.GetDiffuseMapArray())
+                model.GetDiffuseMapArray()->Bind(TextureUnit::DiffuseMaps);
+            // Models without one draw with a variant that doesn't sample specular maps
+            if (model.GetSpecularMapArray())
+                model.GetSpecularMapArray()->Bind(TextureUnit::SpecularMaps);
+            // Only models without meshes have none, and they draw nothing
+            if (model.GetMaterialBuffer())
+                model.GetMaterialBuffer()->Bind();
+        }
+
+        s_Data.FrameData->BindUniformRange(BufferBinding::Object, command.ObjectAllocation);
+    }
+
+    static void DrawQueue(MeshStream stream, bool includeTriangles)
+    {
+        const Shader* boundShader = nullptr;
+        for (const auto& command : s_Data.DrawQueue)
+        {
+            if (!command.IsVisible)
+                continue;
+
+            BindDrawShader(command, stream, boundShader);
+            BindDrawResources(command, stream);
+            DrawModelMeshes(*command.SubmittedModel, stream, includeTriangles);
+        }
+    }
+
+    // Rewrites the camera matrices in place. Nothing has read them yet and the buffer is persistently mapped,
+    // so the draws see the new ones without another allocation or binding
+    static void LatchCamera()
+    {
+        BH_PROFILE_FUNCTION();
+
+        const PerspectiveCamera& camera = s_Data.CameraLatch();
+
+        const glm::mat4 view = camera.GetViewMatrix();
+        if (view == s_Data.ViewMatrix && camera.GetProjectionMatrix() == s_Data.ProjectionMatrix)
+            return;
+
+        // Lights were taken to view space by the view from BeginScene
+        const glm::mat4 correction = view * glm::inverse(s_Data.ViewMatrix);
+        for (LightData& light : s_Data.Lights)
+        {
+            light.PositionRadius = glm::vec4(glm::vec3(correction * glm::vec4(glm::vec3(light.PositionRadius), 1.0f)), light.PositionRadius.w);
+            light.DirectionSpotScale = glm::vec4(glm::mat3(correction) * glm::vec3(light.DirectionSpotScale), light.DirectionSpotScale.w);
+        }
+
+        s_Data.ViewMatrix = view;
+        s_Data.ProjectionMatrix = camera.GetProjectionMatrix();
+        s_Data.NearClip = camera.GetNearClip();
+        s_Data.FarClip = camera.GetFarClip();
+
+        auto* const cameraData = static_cast<CameraData*>(s_Data.CameraAllocation.Data);
+        cameraData->Projection = s_Data.ProjectionMatrix;
+        cameraData->View = s_Data.ViewMatrix;
+    }
+
+    // Bins this frame's lights into clusters and binds the grid, lights and light lists for the model shader
+    static void UploadLights()
+    {
+        const Timer timer;
+
+        s_Data.Clusters->Build(s_Data.ProjectionMatrix, s_Data.NearClip, s_Data.FarClip, s_Data.Lights);
+        const auto& clusterRanges = s_Data.Clusters->GetClusterRanges();
+        const auto& lightIndices = s_Data.Clusters->GetLightIndices();
+
+        // Empty ranges can't be bound, so every buffer holds at least one element
+        const FrameAllocation lightsAllocation = s_Data.FrameData->AllocateStorage(std::max<size_t>(s_Data.Lights.size(), 1) * sizeof(LightData));
+        const FrameAllocation rangesAllocation = s_Data.FrameData->AllocateStorage(clusterRanges.size() * sizeof(ClusterRange));
+        const FrameAllocation indicesAllocation = s_Data.FrameData->AllocateStorage(std::max<size_t>(lightIndices.size(), 1) * sizeof(uint32_t));
+        const FrameAllocation gridAllocation = s_Data.FrameData->AllocateUniform(sizeof(LightGridData));
+        if (!gridAllocation)
+            return;
+
+        // Out of frame memory, an empty grid makes the shader skip local lights rather than read stale lists
+        const bool listsFit = lightsAllocation && rangesAllocation && indicesAllocation;
+        if (!listsFit)
+            BH_LOG_WARN("Light lists don't fit into the frame buffer, skipping local lights");
+
+        auto* const grid = static_cast<LightGridData*>(gridAllocation.Data);
+        grid->ClusterCounts = listsFit ? glm::uvec4(LightClusters::TilesX, LightClusters::TilesY, LightClusters::Slices, 0) : glm::uvec4(0);
+        grid->SliceScale = s_Data.Clusters->GetSliceScale();
+        grid->SliceBias = s_Data.Clusters->GetSliceBias();
+        s_Data.FrameData->BindUniformRange(BufferBinding::LightGrid, gridAllocation);
+
+        if (listsFit && !s_Data.Lights.empty())
+            s_Data.FrameModelFeatures |= ModelFeatureLocalLights;
+
+        if (listsFit)
+        {
+            std::memcpy(lightsAllocation.Data, s_Data.Lights.data(), s_Data.Lights.size() * sizeof(LightData));
+            std::memcpy(rangesAllocation.Data, clusterRanges.data(), clusterRanges.size() * sizeof(ClusterRange));
+            std::memcpy(indicesAllocation.Data, lightIndices.data(), lightIndices.size() * sizeof(uint32_t));
+
+            s_Data.FrameData->BindStorageRange(BufferBinding::Lights, lightsAllocation);
+            s_Data.FrameData->BindStorageRange(BufferBinding::LightClusters, rangesAllocation);
+            s_Data.FrameData->BindStorageRange(BufferBinding::LightIndices, indicesAllocation);
+        }
+
+        s_Data.Stats.LightCount = static_cast<uint32_t>(s_Data.Lights.size());
+        s_Data.Stats.LightClusteringTime = timer.ElapsedMillis();
+    }
+
+    // Refits the cascades and redraws the ones that need it, cached cascades only get static casters
+    static void RenderShadows()
+    {
+        const ShadowMap& shadowMap = s_Data.Shadows->GetShadowMap();
+        shadowMap.Bind(TextureUnit::ShadowMap);
+
+        const FrameAllocation shadowAllocation = s_Data.FrameData->AllocateUniform(sizeof(ShadowData));
+        if (!shadowAllocation)
+            return;
+
+        auto* const shadowData = static_cast<ShadowData*>(shadowAllocation.Data);
+        s_Data.FrameData->BindUniformRange(BufferBinding::Shadows, shadowAllocation);
+        if (!s_Data.ShadowsEnabled)
+        {
+            shadowData->Params = glm::vec4(0.0f);
+            return;
+        }
+        s_Data.FrameModelFeatures |= ModelFeatureShadows;
+
+        s_Data.Shadows->Update(s_Data.ViewMatrix, s_Data.ProjectionMatrix, s_Data.NearClip, s_Data.FarClip,
+            s_Data.SunLight.Direction, s_Data.StaticGeometryHash);
+
+        // Maps light clip space to texture coordinates and depth
+        const glm::mat4 clipToTexture = glm::scale(glm::translate(glm::mat4(1.0f), glm::vec3(0.5f)), glm::vec3(0.5f));
+        const glm::mat4 inverseView = glm::inverse(s_Data.ViewMatrix);
+        for (uint32_t index = 0; index < CascadedShadows::CascadeCount; ++index)
+        {
+            const auto& cascade = s_Data.Shadows->GetCascade(index);
+            shadowData->CascadeMatrices[index] = clipToTexture * cascade.ViewProjection * inverseView;
+            shadowData->CascadeSplits[index] = cascade.SplitDistance;
+        }
+        shadowData->Params = { static_cast<float>(CascadedShadows::CascadeCount), 1.0f / static_cast<float>(shadowMap.GetSize()), s_ShadowDepthBias, 0.0f };
+
+        GPUProfiler::BeginScope("Shadows");
+
+        int32_t previousFramebuffer = 0;
+        int32_t previousViewport[4];
+        glGetIntegerv(GL_DRAW_FRAMEBUFFER_BINDING, &previousFramebuffer);
+        glGetIntegerv(GL_VIEWPORT, previousViewport);
+
+        // Casters between the light and a cascade are flattened onto its near plane instead of being clipped
+        glEnable(GL_DEPTH_CLAMP);
+        glEnable(GL_POLYGON_OFFSET_FILL);
+        glPolygonOffset(2.0f, 4.0f);
+
+        s_Data.DepthShader->Bind();
+        const glm::mat4& lightView = s_Data.Shadows->GetLightView();
+        for (uint32_t index = 0; index < CascadedShadows::CascadeCount; ++index)
+        {
+            const auto& cascade = s_Data.Shadows->GetCascade(index);
+            if (!cascade.NeedsRender)
+                continue;
+
+            const FrameAllocation cascadeCameraAllocation = s_Data.FrameData->AllocateUniform(sizeof(CameraData));
+            if (!cascadeCameraAllocation)
+                break;
+
+            auto* const cascadeCamera = static_cast<CameraData*>(cascadeCameraAllocation.Data);
+            cascadeCamera->Projection = cascade.ViewProjection;
+            cascadeCamera->View = glm::mat4(1.0f);
+            s_Data.FrameData->BindUniformRange(BufferBinding::Matrices, cascadeCameraAllocation);
+
+            shadowMap.BindLayer(index);
+            shadowMap.ClearLayer(index);
+
+            const AABB& cascadeBounds = cascade.LightSpaceBounds;
+            for (const auto& command : s_Data.DrawQueue)
+            {
+                if (cascade.IsCached && !(command.Flags & SubmitFlagStatic))
+                    continue;
+
+                // Anything overlapping the cascade on screen and not behind it can cast into it
+                const AABB casterBounds = command.SubmittedModel->GetBoundingBox().Transform(lightView * command.Transform);
+                if (casterBounds.Max.x < cascadeBounds.Min.x || casterBounds.Min.x > cascadeBounds.Max.x
+                    || casterBounds.Max.y < cascadeBounds.Min.y || casterBounds.Min.y > cascadeBounds.Max.y
+                    || casterBounds.Max.z < cascadeBounds.Min.z)
+                    continue;
+
+                s_Data.FrameData->BindUniformRange(BufferBinding::Object, command.ObjectAllocation);
+                DrawModelMeshes(*command.SubmittedModel, MeshStream::PositionOnly);
+            }
+
+            ++s_Data.Stats.ShadowCascadesRendered;
+        }
+
+        glDisable(GL_POLYGON_OFFSET_FILL);
+        glDisable(GL_DEPTH_CLAMP);
+
+        glBindFramebuffer(GL_FRAMEBUFFER, static_cast<uint32_t>(previousFramebuffer));
+        glViewport(previousViewport[0], previousViewport[1], previousViewport[2], previousViewport[3]);
+        s_Data.FrameData->BindUniformRange(BufferBinding::Matrices, s_Data.CameraAllocation);
+
+        GPUProfiler::EndScope();
+    }
+
+    // Writes the bounds and indirect commands of every triangle range, returns false when there is nothing to cull
+    static bool PrepareOcclusionCulling()
+    {
+        auto& items = s_Data.CullItems;
+        items.clear();
+        for (uint32_t commandIndex = 0; commandIndex < s_Data.DrawQueue.size(); ++commandIndex)
+        {
+            if (!s_Data.DrawQueue[commandIndex].IsVisible)
+                continue;
+
+            const auto& meshes = s_Data.DrawQueue[commandIndex].SubmittedModel->GetMeshes();
+            for (uint32_t meshIndex = 0; meshIndex < meshes.size(); ++meshIndex)
+            {
+                if (meshes[meshIndex]->GetTriangleIndicesCount() && meshes[meshIndex]->GetBoundingBox().IsValid())
+                    items.push_back({ commandIndex, meshIndex });
+            }
+        }
+
+        if (items.empty())
+            return false;
+
+        const auto itemCount = static_cast<uint32_t>(items.size());
+        s_Data.CullBoundsAllocation = s_Data.FrameData->AllocateStorage(itemCount * sizeof(DrawBounds));
+        for (auto& allocation : s_Data.CullCommandAllocations)
+            allocation = s_Data.FrameData->AllocateStorage(itemCount * sizeof(DrawElementsIndirectCommand));
+
+        if (!s_Data.CullBoundsAllocation || !s_Data.CullCommandAllocations[0] || !s_Data.CullCommandAllocations[1])
+            return false;
+
+        auto* const bounds = static_cast<DrawBounds*>(s_Data.CullBoundsAllocation.Data);
+        auto* const firstPhaseCommands = static_cast<DrawElementsIndirectCommand*>(s_Data.CullCommandAllocations[0].Data);
+        auto* const secondPhaseCommands = static_cast<DrawElementsIndirectCommand*>(s_Data.CullCommandAllocations[1].Data);
+        for (uint32_t itemIndex = 0; itemIndex < itemCount; ++itemIndex)
+        {
+            const CullItem& item = items[itemIndex];
+            const DrawCommand& command = s_Data.DrawQueue[item.CommandIndex];
+            const auto& mesh = command.SubmittedModel->GetMeshes()[item.MeshIndex];
+
+            const AABB worldBounds = mesh->GetBoundingBox().Transform(command.Transform);
+            bounds[itemIndex] = { glm::vec4(worldBounds.Min, 1.0f), glm::vec4(worldBounds.Max, 1.0f) };
+
+            // Instance counts are written by the culling shader
+            const DrawElementsIndirectCommand indirectCommand = {
+                mesh->GetTriangleIndicesCount(),
+                0,
+                mesh->GetPointIndicesCount() + mesh->GetLineIndicesCount(),
+                0,
+                item.MeshIndex
+            };
+            firstPhaseCommands[itemIndex] = indirectCommand;
+            secondPhaseCommands[itemIndex] = indirectCommand;
+        }
+
+        // New items start out invisible, phase two picks them up on their first frame
+        if (itemCount > s_Data.VisibilityCapacity)
+        {
+            s_Data.VisibilityCapacity = std::max(itemCount, s_Data.VisibilityCapacity * 2);
+            const std::vector<uint32_t> visibility(s_Data.VisibilityCapacity, 0);
+            s_Data.VisibilityBuffer = CreateRef<ShaderStorageBuffer>(s_Data.VisibilityCapacity * sizeof(uint32_t), visibility.data(), BufferBinding::CullVisibility);
+        }
+
+        const auto& counterBuffer = s_Data.CullCounterBuffers[s_Data.CullCounterIndex];
+        s_Data.CullCounterIndex = (s_Data.CullCounterIndex + 1) % s_CullCounterLatency;
+
+        CullCounters counters;
+        counterBuffer->GetData(0, sizeof(CullCounters), &counters);
+        s_Data.Stats.OccludedObjects = counters.OccludedCount;
+        s_Data.Stats.FrustumCulledObjects = counters.FrustumCulledCount;
+        s_Data.Stats.TriangleCount += counters.VisibleTriangleCount;
+
+        constexpr CullCounters clearedCounters = {};
+        counterBuffer->SetData(0, sizeof(CullCounters), &clearedCounters);
+
+        s_Data.FrameData->BindStorageRange(BufferBinding::CullBounds, s_Data.CullBoundsAllocation);
+        s_Data.VisibilityBuffer->Bind();
+        counterBuffer->Bind();
+        glBindBuffer(GL_DRAW_INDIRECT_BUFFER, s_Data.FrameData->GetRendererID());
+
+        return true;
+    }
+
+    static void DispatchOcclusionCulling(uint32_t phase)
+    {
+        const auto itemCount = static_cast<uint32_t>(s_Data.CullItems.size());
+        const auto& shader = s_Data.OcclusionCullShader;
+
+        s_Data.FrameData->BindStorageRange(BufferBinding::CullCommands, s_Data.CullCommandAllocations[phase]);
+        s_Data.HiZ->Bind(TextureUnit::DepthPyramid);
+        shader->UploadUint(s_Data.CullPhaseUniform, phase);
+        shader->UploadUint(s_Data.CullDrawCountUniform, itemCount);
+        shader->Dispatch((itemCount + s_CullGroupSize - 1) / s_CullGroupSize);
+
+        glMemoryBarrier(GL_COMMAND_BARRIER_BIT | GL_SHADER_STORAGE_BARRIER_BIT);
+    }
+
+    static void DrawCulledMeshes(MeshStream stream, uint32_t phase)
+    {
+        const uint64_t commandsOffset = s_Data.CullCommandAllocations[phase].Offset;
+        const Shader* boundShader = nullptr;
+        uint32_t boundCommandIndex = ~0u;
+        for (uint32_t itemIndex = 0; itemIndex < s_Data.CullItems.size(); ++itemIndex)
+        {
+            const CullItem& item = s_Data.CullItems[itemIndex];
+            const DrawCommand& command = s_Data.DrawQueue[item.CommandIndex];
+            if (item.CommandIndex != boundCommandIndex)
+            {
+                BindDrawShader(command, stream, boundShader);
+                BindDrawResources(command, stream);
+                boundCommandIndex = item.CommandIndex;
+            }
+
+            const auto& mesh = command.SubmittedModel->GetMeshes()[item.MeshIndex];
+            if (stream == MeshStream::PositionOnly)
+                mesh->GetPositionVertexArray()->Bind();
+            else
+                mesh->GetVertexArray()->Bind();
+
+            // Culled ranges are still submitted, with an instance count of zero the GPU skips them
+            glDrawElementsIndirect(GL_TRIANGLES, GL_UNSIGNED_INT,
+                reinterpret_cast<const void*>(commandsOffset + itemIndex * sizeof(DrawElementsIndirectCommand)));
+            ++s_Data.Stats.DrawCalls;
+        }
+    }
+
+    // Draws last frame's visible set, builds the depth pyramid from it, then draws whatever became visible
+    static void CullAndDrawQueue(MeshStream stream)
+    {
+        DispatchOcclusionCulling(0);
+        DrawQueue(stream, false);
+        DrawCulledMeshes(stream, 0);
+
+        s_Data.HiZ->Build(s_Data.RenderTarget);
+
+        DispatchOcclusionCulling(1);
+        DrawCulledMeshes(stream, 1);
+    }
+}
+
 void Renderer::Init()
 {
-    s_Data.MatricesUniformBuffer = CreateRef<UniformBuffer>(2 * sizeof(glm::mat4), 0);
+    BH_PROFILE_FUNCTION();
+
+    s_Data.FrameData = CreateScope<FrameRingBuffer>(s_FrameRingBufferSize);
 
     ShaderSpecification modelShaderSpec;
     modelShaderSpec.VertexPath = Filesystem::GetShadersPath() / "model.vs.glsl";
     modelShaderSpec.FragmentPath = Filesystem::GetShadersPath() / "model.fs.glsl";
 
-    s_Data.ModelShader = CreateRef<Shader>("Model", modelShaderSpec);
-    s_Data.ModelShader->UploadInt("u_Material.Diffuse", 0);
-    s_Data.ModelShader->UploadInt("u_Material.Specular", 0);
-    s_Data.ModelShader->UploadFloat3("u_DirectionalLight.Direction", glm::vec3(0.0f, -1.0f, 0.0f));
-    s_Data.ModelShader->UploadFloat3("u_DirectionalLight.Diffuse"  , glm::vec3(0.5f));
-    s_Data.ModelShader->UploadFloat3("u_DirectionalLight.Specular" , glm::vec3(0.8f));
-    s_Data.ModelShader->UploadFloat("u_Material.Shininess", 32.0f);
+    // Variants compile as the renderer first needs them, the common one is built up front
+    s_Data.ModelShaders = CreateScope<ShaderVariants>("Model", modelShaderSpec,
+        std::vector<std::string>{ "FEATURE_SHADOWS", "FEATURE_LOCAL_LIGHTS", "FEATURE_SPECULAR_MAP" });
+    // The light is only uploaded when it changes, a reloaded variant would render without it
+    s_Data.ModelShaders->SetReloadCallback([](Shader& shader) { Utils::UploadDirectionalLight(shader); });
+    s_Data.ModelShaders->Get(ModelFeatureShadows | ModelFeatureSpecularMap);
+    // Stands in for the others while they build, so it builds in the background from the start
+    s_Data.ModelShaders->GetReadyOrClosest(ModelFeatureNone);
+    SetDirectionalLight(DirectionalLight());
+
+    s_Data.DepthShader = CreateRef<Shader>(Filesystem::GetShadersPath() / "depth.glsl");
+
+    s_Data.Workers = CreateScope<ThreadPool>();
+    s_Data.SoftwareCuller = CreateScope<SoftwareOcclusionCuller>(*s_Data.Workers);
+    s_Data.Clusters = CreateScope<LightClusters>(*s_Data.Workers);
+
+    s_Data.Shadows = CreateScope<CascadedShadows>();
+
+    s_Data.OcclusionCullShader = CreateRef<Shader>(Filesystem::GetShadersPath() / "occlusion_cull.glsl");
+    s_Data.CullPhaseUniform = s_Data.OcclusionCullShader->GetUniformHandle("u_Phase");
+    s_Data.CullDrawCountUniform = s_Data.OcclusionCullShader->GetUniformHandle("u_DrawCount");
+    s_Data.HiZ = CreateScope<DepthPyramid>();
+
+    constexpr CullCounters clearedCounters = {};
+    for (auto& counterBuffer : s_Data.CullCounterBuffers)
+        counterBuffer = CreateRef<ShaderStorageBuffer>(sizeof(CullCounters), &clearedCounters, BufferBinding::CullCounters);
 
     CubemapSpecification cbSpec;
     cbSpec.Right  = Filesystem::GetTexturesPath() / "skyboxes/space/blue/right.png";
@@ -48,7 +677,12 @@ void Renderer::Init()
 
     s_Data.SkyboxShader = CreateRef<Shader>(Filesystem::GetShadersPath() / "skybox.glsl");
     s_Data.SkyboxCubemap = CreateRef<Cubemap>(cbSpec);
-    s_Data.SkyboxCubemap->Bind();
+    s_Data.SkyboxCubemap->Bind(TextureUnit::Skybox);
+
+    s_Data.UpscaleShader = CreateRef<Shader>(Filesystem::GetShadersPath() / "upscale.glsl");
+    s_Data.UpscaleUVScaleUniform = s_Data.UpscaleShader->GetUniformHandle("u_UVScale");
+    s_Data.UpscaleSharpnessUniform = s_Data.UpscaleShader->GetUniformHandle("u_Sharpness");
+    s_Data.FullscreenVertexArray = CreateRef<VertexArray>();
 
     s_Data.SkyboxVertexArray = CreateRef<VertexArray>();
     {
@@ -97,6 +731,10 @@ void Renderer::Init()
 
 void Renderer::Shutdown()
 {
+    BH_PROFILE_FUNCTION();
+
+    // Release GL objects while the context is still alive
+    s_Data = RendererData();
 }
 
 void Renderer::SetViewport(uint32_t x, uint32_t y, uint32_t width, uint32_t height)
@@ -104,79 +742,267 @@ void Renderer::SetViewport(uint32_t x, uint32_t y, uint32_t width, uint32_t heig
     glViewport(static_cast<int32_t>(x), static_cast<int32_t>(y), static_cast<int32_t>(width), static_cast<int32_t>(height));
 }
 
-void Renderer::BeginScene(const PerspectiveCamera& camera)
+void Renderer::BeginScene(const PerspectiveCamera& camera, const Ref<Framebuffer>& renderTarget, CameraLatchFn cameraLatch)
 {
-    auto* const matricesUniformBufferRange = static_cast<glm::mat4*>(s_Data.MatricesUniformBuffer->Map(0, 2 * sizeof(glm::mat4)));
-    *matricesUniformBufferRange = camera.GetProjectionMatrix();
-    *(matricesUniformBufferRange + 1) = camera.GetViewMatrix();
-    s_Data.MatricesUniformBuffer->Unmap();
+    BH_PROFILE_FUNCTION();
+
+    s_Data.RenderTarget = renderTarget;
+    s_Data.CameraLatch = std::move(cameraLatch);
+    s_Data.FrameData->BeginFrame();
+    s_Data.DrawQueue.clear();
+    s_Data.DrawSkybox = false;
+    s_Data.Lights.clear();
+    s_Data.StaticGeometryHash = Hash::FNV1a64({});
+    s_Data.FrameModelFeatures = ModelFeatureNone;
+    s_Data.ModelShaders->Update();
+
+    s_Data.ViewMatrix = camera.GetViewMatrix();
+    s_Data.ProjectionMatrix = camera.GetProjectionMatrix();
+    s_Data.NearClip = camera.GetNearClip();
+    s_Data.FarClip = camera.GetFarClip();
+
+    if (s_Data.SoftwareOcclusionCullingEnabled)
+        s_Data.SoftwareCuller->BeginFrame(camera);
+
+    s_Data.CameraAllocation = s_Data.FrameData->AllocateUniform(sizeof(CameraData));
+    auto* const cameraData = static_cast<CameraData*>(s_Data.CameraAllocation.Data);
+    cameraData->Projection = s_Data.ProjectionMatrix;
+    cameraData->View = s_Data.ViewMatrix;
+    s_Data.FrameData->BindUniformRange(BufferBinding::Matrices, s_Data.CameraAllocation);
 }
 
 void Renderer::EndScene()
 {
-}
+    BH_PROFILE_FUNCTION();
 
-void Renderer::Submit(const Ref<Model>& model, const glm::mat4& transform)
-{
-    model->GetDiffuseMapArray()->Bind();
+    // As late as possible, everything below draws with the camera matrices
+    if (s_Data.CameraLatch && s_Data.CameraAllocation)
+        Utils::LatchCamera();
+
+    Utils::UploadLights();
+    Utils::RenderShadows();
 
-    for (const auto& mesh : model->GetMeshes())
+    // The depth pyramid is built from the render target, so culling needs one
+    const bool occlusionCulling = s_Data.OcclusionCullingEnabled && s_Data.RenderTarget && Utils::PrepareOcclusionCulling();
+
+    if (s_Data.DepthPrePassEnabled)
     {
-        const auto& vertexArray = mesh->GetVertexArray();
-        const uint32_t pointIndicesCount = mesh->GetPointIndicesCount();
-        const uint32_t lineIndicesCount = mesh->GetLineIndicesCount();
-        const uint32_t triangleIndicesCount = mesh->GetTriangleIndicesCount();
+        GPUProfiler::BeginScope("Depth Pre-Pass");
 
-        s_Data.ModelShader->UploadMat4("u_Model", transform);
-        s_Data.ModelShader->UploadUint("u_Material.DiffuseLayer", mesh->GetDiffuseTextureLayer());
-        s_Data.ModelShader->UploadUint("u_Material.SpecularLayer", mesh->GetSpecularTextureLayer());
+        glColorMask(GL_FALSE, GL_FALSE, GL_FALSE, GL_FALSE);
+        glDepthFunc(GL_LESS);
 
-        s_Data.ModelShader->Bind();
-        vertexArray->Bind();
-        if (pointIndicesCount)
-        {
-            glDrawRangeElements(GL_POINTS,
-                0,
-                pointIndicesCount - 1,
-                static_cast<int32_t>(pointIndicesCount),
-                GL_UNSIGNED_INT,
-                nullptr
-            );
-            ++s_Data.Stats.DrawCalls;
-            s_Data.Stats.PointsCount += pointIndicesCount;
-        }
-        if (lineIndicesCount)
+        if (occlusionCulling)
+            Utils::CullAndDrawQueue(Utils::MeshStream::PositionOnly);
+        else
+            Utils::DrawQueue(Utils::MeshStream::PositionOnly, true);
+
+        glColorMask(GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE);
+
+        // Only the nearest fragment of every pixel passes, so each visible pixel is shaded once
+        glDepthFunc(GL_EQUAL);
+        glDepthMask(GL_FALSE);
+
+        GPUProfiler::EndScope();
+    }
+
+    GPUProfiler::BeginScope("Opaque");
+
+    if (!occlusionCulling)
+    {
+        Utils::DrawQueue(Utils::MeshStream::Full, true);
+    }
+    else if (s_Data.DepthPrePassEnabled)
+    {
+        // The pre-pass already culled, both phases' results are final
+        Utils::DrawQueue(Utils::MeshStream::Full, false);
+        Utils::DrawCulledMeshes(Utils::MeshStream::Full, 0);
+        Utils::DrawCulledMeshes(Utils::MeshStream::Full, 1);
+    }
+    else
+    {
+        Utils::CullAndDrawQueue(Utils::MeshStream::Full);
+    }
+
+    GPUProfiler::EndScope();
+
+    glDepthFunc(GL_LEQUAL);
+    glDepthMask(GL_TRUE);
+
+    // Drawn last, so the depth test rejects it wherever geometry already covers the screen
+    if (s_Data.DrawSkybox)
+    {
+        BH_GPU_PROFILE_SCOPE("Skybox");
+
+        s_Data.SkyboxShader->Bind();
+        s_Data.SkyboxVertexArray->Bind();
+        glDrawElements(GL_TRIANGLES, static_cast<int32_t>(s_Data.SkyboxVertexArray->GetIndexBuffer()->GetCount()), GL_UNSIGNED_INT, nullptr);
+        ++s_Data.Stats.DrawCalls;
+    }
+
+    s_Data.DrawQueue.clear();
+    s_Data.RenderTarget = nullptr;
+    s_Data.CameraLatch = nullptr;
+    s_Data.FrameData->EndFrame();
+
+    s_Data.Stats.DepthPrePassTime = s_Data.DepthPrePassEnabled ? GPUProfiler::GetMilliseconds("Depth Pre-Pass") : 0.0f;
+    s_Data.Stats.OpaquePassTime = GPUProfiler::GetMilliseconds("Opaque");
+    s_Data.Stats.ShadowPassTime = s_Data.ShadowsEnabled ? GPUProfiler::GetMilliseconds("Shadows") : 0.0f;
+    s_Data.Stats.SoftwareOcclusionTime = s_Data.SoftwareOcclusionCullingEnabled ? s_Data.SoftwareCuller->GetElapsedMilliseconds() : 0.0f;
+}
+
+void Renderer::Submit(const Ref<Model>& model, const glm::mat4& transform, SubmitFlags flags)
+{
+    BH_PROFILE_FUNCTION();
+
+    bool isVisible = true;
+    if (s_Data.SoftwareOcclusionCullingEnabled)
+    {
+        // Occluders are always drawn, everything else has to pass the occluders submitted before it
+        if (flags & SubmitFlagOccluder)
         {
-            glDrawRangeElements(GL_LINES,
-                pointIndicesCount,
-                pointIndicesCount + lineIndicesCount - 1,
-                static_cast<int32_t>(lineIndicesCount),
-                GL_UNSIGNED_INT,
-                nullptr
-            );
-            ++s_Data.Stats.DrawCalls;
-            s_Data.Stats.LinesCount += lineIndicesCount / 2;
+            s_Data.SoftwareCuller->AddOccluder(model, transform);
         }
-        if (triangleIndicesCount)
+        else if (!s_Data.SoftwareCuller->IsVisible(model->GetBoundingBox().Transform(transform)))
         {
-            glDrawRangeElements(GL_TRIANGLES,
-                lineIndicesCount,
-                lineIndicesCount + triangleIndicesCount - 1,
-                static_cast<int32_t>(triangleIndicesCount),
-                GL_UNSIGNED_INT,
-                nullptr
-            );
-            ++s_Data.Stats.DrawCalls;
-            s_Data.Stats.TriangleCount += triangleIndicesCount / 3;
+            ++s_Data.Stats.SoftwareCulledObjects;
+            isVisible = false;
         }
     }
+
+    // Any change to what's static, or where it is, invalidates the cached shadow cascades
+    if (flags & SubmitFlagStatic)
+    {
+        const Model* const modelAddress = model.get();
+        s_Data.StaticGeometryHash = Hash::FNV1a64({ reinterpret_cast<const char*>(&modelAddress), sizeof(modelAddress) }, s_Data.StaticGeometryHash);
+        s_Data.StaticGeometryHash = Hash::FNV1a64({ reinterpret_cast<const char*>(&transform), sizeof(transform) }, s_Data.StaticGeometryHash);
+    }
+
+    const FrameAllocation objectAllocation = s_Data.FrameData->AllocateUniform(sizeof(ObjectData));
+    if (!objectAllocation)
+        return;
+
+    auto* const objectData = static_cast<ObjectData*>(objectAllocation.Data);
+    objectData->Model = transform;
+    objectData->NormalMatrix = glm::mat4(glm::inverseTranspose(glm::mat3(transform)));
+
+    s_Data.DrawQueue.push_back({ model, transform, objectAllocation, flags, isVisible });
+}
+
+void Renderer::SubmitLight(const PointLight& light)
+{
+    if (s_Data.Lights.size() >= s_MaxLights)
+        return;
+
+    const glm::vec3 position = glm::vec3(s_Data.ViewMatrix * glm::vec4(light.Position, 1.0f));
+    s_Data.Lights.push_back({
+        glm::vec4(position, light.Radius),
+        glm::vec4(light.Color * light.Intensity, 1.0f),
+        glm::vec4(0.0f)
+    });
+}
+
+void Renderer::SubmitLight(const SpotLight& light)
+{
+    if (s_Data.Lights.size() >= s_MaxLights)
+        return;
+
+    const glm::vec3 position = glm::vec3(s_Data.ViewMatrix * glm::vec4(light.Position, 1.0f));
+    const glm::vec3 direction = glm::normalize(glm::mat3(s_Data.ViewMatrix) * light.Direction);
+
+    // The cone falloff becomes saturate(cos(angle) * scale + offset) in the shader
+    const float cosInner = std::cos(glm::radians(light.InnerConeAngle));
+    const float cosOuter = std::cos(glm::radians(light.OuterConeAngle));
+    const float spotScale = 1.0f / std::max(cosInner - cosOuter, 1e-4f);
+    const float spotOffset = -cosOuter * spotScale;
+
+    // Clustered by the sphere around the whole range, which also holds the cone
+    s_Data.Lights.push_back({
+        glm::vec4(position, light.Radius),
+        glm::vec4(light.Color * light.Intensity, spotOffset),
+        glm::vec4(direction, spotScale)
+    });
+}
+
+void Renderer::SetDirectionalLight(const DirectionalLight& light)
+{
+    s_Data.SunLight = light;
+    s_Data.ModelShaders->ForEach([](uint32_t, const Ref<Shader>& shader) { Utils::UploadDirectionalLight(*shader); });
+}
+
+const DirectionalLight& Renderer::GetDirectionalLight()
+{
+    return s_Data.SunLight;
+}
+
+void Renderer::SetShadowsEnabled(bool enabled)
+{
+    // Cached cascades weren't kept up to date while disabled
+    if (enabled && !s_Data.ShadowsEnabled)
+        s_Data.Shadows->Invalidate();
+
+    s_Data.ShadowsEnabled = enabled;
+}
+
+bool Renderer::AreShadowsEnabled()
+{
+    return s_Data.ShadowsEnabled;
 }
 
 void Renderer::DrawSkybox()
 {
-    s_Data.SkyboxShader->Bind();
-    s_Data.SkyboxVertexArray->Bind();
-    glDrawElements(GL_TRIANGLES, static_cast<int32_t>(s_Data.SkyboxVertexArray->GetIndexBuffer()->GetCount()), GL_UNSIGNED_INT, nullptr);
+    s_Data.DrawSkybox = true;
+}
+
+void Renderer::Upscale(const Ref<Framebuffer>& source, float sharpness)
+{
+    BH_PROFILE_FUNCTION();
+
+    const auto& sourceSpec = source->GetSpecification();
+    const auto& sourceArea = source->GetRenderArea();
+    BH_ASSERT(sourceSpec.Samples == 1, "Upscaling needs a resolved source!");
+
+    BH_GPU_PROFILE_SCOPE("Upscale");
+
+    const glm::vec2 uvScale = glm::vec2(sourceArea) / glm::vec2(sourceSpec.Width, sourceSpec.Height);
+    s_Data.UpscaleShader->UploadFloat2(s_Data.UpscaleUVScaleUniform, uvScale);
+    s_Data.UpscaleShader->UploadFloat(s_Data.UpscaleSharpnessUniform, std::clamp(sharpness, 0.0f, 1.0f));
+
+    glBindTextureUnit(TextureUnit::PostProcessSource, source->GetColorAttachmentRendererID());
+    s_Data.UpscaleShader->Bind();
+    s_Data.FullscreenVertexArray->Bind();
+    glDrawArrays(GL_TRIANGLES, 0, 3);
+    ++s_Data.Stats.DrawCalls;
+}
+
+void Renderer::SetDepthPrePassEnabled(bool enabled)
+{
+    s_Data.DepthPrePassEnabled = enabled;
+}
+
+bool Renderer::IsDepthPrePassEnabled()
+{
+    return s_Data.DepthPrePassEnabled;
+}
+
+void Renderer::SetOcclusionCullingEnabled(bool enabled)
+{
+    s_Data.OcclusionCullingEnabled = enabled;
+}
+
+bool Renderer::IsOcclusionCullingEnabled()
+{
+    return s_Data.OcclusionCullingEnabled;
+}
+
+void Renderer::SetSoftwareOcclusionCullingEnabled(bool enabled)
+{
+    s_Data.SoftwareOcclusionCullingEnabled = enabled;
+}
+
+bool Renderer::IsSoftwareOcclusionCullingEnabled()
+{
+    return s_Data.SoftwareOcclusionCullingEnabled;
 }
 
 void Renderer::ResetStats()
@@ -1,7 +1,18 @@
 #pragma once
 #include "BlackHole/Renderer/Camera.h"
+#include "BlackHole/Renderer/Light.h"
 #include "BlackHole/Renderer/Model.h"
 
+#include "Platform/OpenGL/Framebuffer.h"
+
+enum SubmitFlags : uint32_t
+{
+    SubmitFlagNone     = 0,
+    SubmitFlagOccluder = BIT(0),
+    // Never moves, so cached shadow cascades can keep it until the static set changes
+    SubmitFlagStatic   = BIT(1)
+};
+
 class Renderer
 {
 public:
@@ -10,13 +21,46 @@ public:
 
     static void SetViewport(uint32_t x, uint32_t y, uint32_t width, uint32_t height);
 
-    static void BeginScene(const PerspectiveCamera& camera);
+    // Called by EndScene right before the first draw, returns the camera with the latest input applied
+    using CameraLatchFn = std::function<const PerspectiveCamera&()>;
+
+    // The render target is only needed by passes that read back its depth, such as occlusion culling.
+    // With a camera latch the matrices are rewritten from its camera when the scene is drawn, lights
+    // follow, culling against software occluders still uses the camera given here
+    static void BeginScene(const PerspectiveCamera& camera, const Ref<Framebuffer>& renderTarget = nullptr, CameraLatchFn cameraLatch = nullptr);
     static void EndScene();
 
-    static void Submit(const Ref<Model>& model, const glm::mat4& transform = glm::mat4(1.0f));
+    // With software occlusion culling, submit occluders first, later submissions are tested against them
+    static void Submit(const Ref<Model>& model, const glm::mat4& transform = glm::mat4(1.0f), SubmitFlags flags = SubmitFlagNone);
+
+    // Lights only last for the current scene, positions are taken to view space with its camera
+    static void SubmitLight(const PointLight& light);
+    static void SubmitLight(const SpotLight& light);
+
+    static void SetDirectionalLight(const DirectionalLight& light);
+    static const DirectionalLight& GetDirectionalLight();
+
+    // Cascaded shadow maps for the directional light
+    static void SetShadowsEnabled(bool enabled);
+    static bool AreShadowsEnabled();
 
     static void DrawSkybox();
 
+    // Stretches the render area of the source's color over the bound framebuffer, sharpness goes from 0 to 1
+    static void Upscale(const Ref<Framebuffer>& source, float sharpness);
+
+    // Lays down depth with a position-only pass first, then shades with GL_EQUAL depth testing
+    static void SetDepthPrePassEnabled(bool enabled);
+    static bool IsDepthPrePassEnabled();
+
+    // Two-phase GPU culling of every mesh against the frustum and a depth pyramid of the current frame
+    static void SetOcclusionCullingEnabled(bool enabled);
+    static bool IsOcclusionCullingEnabled();
+
+    // Culls submissions against a depth buffer rasterized on the CPU, for when GPU culling isn't an option
+    static void SetSoftwareOcclusionCullingEnabled(bool enabled);
+    static bool IsSoftwareOcclusionCullingEnabled();
+
     // Stats
     struct Statistics
     {
@@ -25,6 +69,23 @@ public:
         uint32_t LinesCount = 0;
         uint32_t TriangleCount = 0;
 
+        // GPU time in milliseconds, measured a few frames late
+        float DepthPrePassTime = 0.0f;
+        float OpaquePassTime = 0.0f;
+
+        // GPU culling results, read back a few frames late
+        uint32_t OccludedObjects = 0;
+        uint32_t FrustumCulledObjects = 0;
+
+        uint32_t SoftwareCulledObjects = 0;
+        float SoftwareOcclusionTime = 0.0f;
+
+        uint32_t LightCount = 0;
+        float LightClusteringTime = 0.0f;
+
+        uint32_t ShadowCascadesRendered = 0;
+        float ShadowPassTime = 0.0f;
+
         uint32_t GetTotalVertexCount() const { return TriangleCount * 3 + LinesCount * 2 + PointsCount; }
         uint32_t GetTotalIndexCount() const { return TriangleCount * 3 + LinesCount * 2 + PointsCount; }
     };
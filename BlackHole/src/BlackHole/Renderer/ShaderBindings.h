@@ -0,0 +1,34 @@
+#pragma once
+
+// Binding points shared with assets/shaders, keep in sync with the GLSL layout qualifiers
+namespace BufferBinding
+{
+    enum : uint32_t
+    {
+        Matrices       = 0,
+        Object         = 1,
+        Materials      = 2,
+        CullBounds     = 3,
+        CullVisibility = 4,
+        CullCommands   = 5,
+        CullCounters   = 6,
+        LightGrid      = 7,
+        Lights         = 8,
+        LightClusters  = 9,
+        LightIndices   = 10,
+        Shadows        = 11
+    };
+}
+
+namespace TextureUnit
+{
+    enum : uint32_t
+    {
+        Skybox            = 0,
+        PostProcessSource = 0,
+        DiffuseMaps       = 0,
+        SpecularMaps      = 1,
+        DepthPyramid      = 2,
+        ShadowMap         = 3
+    };
+}
\ No newline at end of file
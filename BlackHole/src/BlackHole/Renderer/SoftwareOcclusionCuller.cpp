@@ -0,0 +1,375 @@
+#include "bhpch.h"
+#include "BlackHole/Renderer/SoftwareOcclusionCuller.h"
+
+#include "BlackHole/Core/Timer.h"
+
+// The AVX2 paths are compiled for that target function by function and only taken when the CPU supports it,
+// so the rest of the engine keeps running on any x86-64 CPU and doesn't get its float math contracted to FMA
+#if defined(BH_ENABLE_AVX2) && (defined(_M_X64) || defined(__x86_64__))
+    #define BH_OCCLUSION_AVX2
+    #include <immintrin.h>
+    #if defined(_MSC_VER) && !defined(__clang__)
+        #include <intrin.h>
+        #define BH_TARGET_AVX2
+    #else
+        #define BH_TARGET_AVX2 __attribute__((target("avx2,fma")))
+    #endif
+#endif
+
+static constexpr uint32_t s_TileWidth = 64;
+static constexpr uint32_t s_TileHeight = 32;
+
+namespace Utils
+{
+    static bool CPUSupportsAVX2()
+    {
+#if defined(BH_OCCLUSION_AVX2) && defined(_MSC_VER) && !defined(__clang__)
+        int registers[4];
+        __cpuid(registers, 0);
+        if (registers[0] < 7)
+            return false;
+
+        // FMA and AVX, plus the OS saving the YMM registers on context switches
+        __cpuid(registers, 1);
+        const bool fma = (registers[2] & (1 << 12)) != 0;
+        const bool osxsave = (registers[2] & (1 << 27)) != 0;
+        const bool avx = (registers[2] & (1 << 28)) != 0;
+        if (!fma || !osxsave || !avx || (_xgetbv(0) & 0x6) != 0x6)
+            return false;
+
+        __cpuidex(registers, 7, 0);
+        return (registers[1] & (1 << 5)) != 0;
+#elif defined(BH_OCCLUSION_AVX2)
+        return __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma");
+#else
+        return false;
+#endif
+    }
+
+    // Index of the first pixel in [minX, maxX] at least as far as depth, or maxX + 1
+    static int32_t FindFartherPixel(const float* row, int32_t minX, int32_t maxX, float depth)
+    {
+        for (int32_t x = minX; x <= maxX; ++x)
+        {
+            if (row[x] >= depth)
+                return x;
+        }
+        return maxX + 1;
+    }
+
+    static void RasterizeRow(float* row, int32_t minX, int32_t maxX, float centerY,
+        const float edgeA[3], const float edgeB[3], const float edgeC[3], float depthA, float depthB, float depthC, float maxDepth)
+    {
+        for (int32_t x = minX; x <= maxX; ++x)
+        {
+            const float centerX = static_cast<float>(x) + 0.5f;
+
+            bool inside = true;
+            for (uint32_t edge = 0; edge < 3; ++edge)
+                inside = inside && edgeA[edge] * centerX + edgeB[edge] * centerY + edgeC[edge] >= 0.0f;
+
+            if (inside)
+            {
+                const float depth = std::min(depthA * centerX + depthB * centerY + depthC, maxDepth);
+                row[x] = std::min(row[x], depth);
+            }
+        }
+    }
+
+#if defined(BH_OCCLUSION_AVX2)
+    BH_TARGET_AVX2 static int32_t FindFartherPixelAVX2(const float* row, int32_t minX, int32_t maxX, float depth)
+    {
+        const __m256 reference = _mm256_set1_ps(depth);
+
+        int32_t x = minX;
+        for (; x + 8 <= maxX + 1; x += 8)
+        {
+            if (_mm256_movemask_ps(_mm256_cmp_ps(_mm256_loadu_ps(row + x), reference, _CMP_GE_OQ)))
+                return x;
+        }
+        return FindFartherPixel(row, x, maxX, depth);
+    }
+
+    // minX is 8-aligned and the width a multiple of 8, so the last block never reads past the row
+    BH_TARGET_AVX2 static void RasterizeRowAVX2(float* row, int32_t minX, int32_t maxX, float centerY,
+        const float edgeA[3], const float edgeB[3], const float edgeC[3], float depthA, float depthB, float depthC, float maxDepth)
+    {
+        const __m256 zero = _mm256_setzero_ps();
+        const __m256 maxDepthVector = _mm256_set1_ps(maxDepth);
+        const __m256 centerX = _mm256_add_ps(_mm256_set1_ps(static_cast<float>(minX)),
+            _mm256_setr_ps(0.5f, 1.5f, 2.5f, 3.5f, 4.5f, 5.5f, 6.5f, 7.5f));
+
+        __m256 edges[3], edgeSteps[3];
+        for (uint32_t edge = 0; edge < 3; ++edge)
+        {
+            edges[edge] = _mm256_fmadd_ps(_mm256_set1_ps(edgeA[edge]), centerX, _mm256_set1_ps(edgeB[edge] * centerY + edgeC[edge]));
+            edgeSteps[edge] = _mm256_set1_ps(edgeA[edge] * 8.0f);
+        }
+        __m256 depth = _mm256_fmadd_ps(_mm256_set1_ps(depthA), centerX, _mm256_set1_ps(depthB * centerY + depthC));
+        const __m256 depthStep = _mm256_set1_ps(depthA * 8.0f);
+
+        for (int32_t x = minX; x <= maxX; x += 8)
+        {
+            const __m256 inside = _mm256_and_ps(_mm256_and_ps(
+                _mm256_cmp_ps(edges[0], zero, _CMP_GE_OQ),
+                _mm256_cmp_ps(edges[1], zero, _CMP_GE_OQ)),
+                _mm256_cmp_ps(edges[2], zero, _CMP_GE_OQ));
+
+            if (!_mm256_testz_ps(inside, inside))
+            {
+                const __m256 stored = _mm256_loadu_ps(row + x);
+                const __m256 nearer = _mm256_min_ps(stored, _mm256_min_ps(depth, maxDepthVector));
+                _mm256_storeu_ps(row + x, _mm256_blendv_ps(stored, nearer, inside));
+            }
+
+            edges[0] = _mm256_add_ps(edges[0], edgeSteps[0]);
+            edges[1] = _mm256_add_ps(edges[1], edgeSteps[1]);
+            edges[2] = _mm256_add_ps(edges[2], edgeSteps[2]);
+            depth = _mm256_add_ps(depth, depthStep);
+        }
+    }
+#endif
+}
+
+SoftwareOcclusionCuller::SoftwareOcclusionCuller(ThreadPool& threadPool, uint32_t width, uint32_t height)
+    : m_ThreadPool(threadPool), m_Width(width), m_Height(height), m_UseAVX2(Utils::CPUSupportsAVX2())
+{
+    BH_ASSERT(width % 8 == 0, "Software occlusion buffer width must be a multiple of 8!");
+
+    m_TilesX = (m_Width + s_TileWidth - 1) / s_TileWidth;
+    m_TilesY = (m_Height + s_TileHeight - 1) / s_TileHeight;
+    m_DepthBuffer.resize(static_cast<size_t>(m_Width) * m_Height, 1.0f);
+}
+
+void SoftwareOcclusionCuller::BeginFrame(const PerspectiveCamera& camera)
+{
+    BH_PROFILE_FUNCTION();
+
+    m_ViewProjection = camera.GetProjectionMatrix() * camera.GetViewMatrix();
+    m_Occluders.clear();
+    m_OccludersDirty = false;
+    m_ElapsedMilliseconds = 0.0f;
+
+    std::ranges::fill(m_DepthBuffer, 1.0f);
+}
+
+void SoftwareOcclusionCuller::AddOccluder(const Ref<Model>& model, const glm::mat4& transform)
+{
+    for (const auto& mesh : model->GetMeshes())
+        m_Occluders.push_back({ model, &mesh->GetPositions(), &mesh->GetTriangleIndices(), transform });
+    m_OccludersDirty = true;
+}
+
+void SoftwareOcclusionCuller::AddOccluder(const std::vector<glm::vec3>& positions, const std::vector<uint32_t>& triangleIndices, const glm::mat4& transform)
+{
+    m_Occluders.push_back({ nullptr, &positions, &triangleIndices, transform });
+    m_OccludersDirty = true;
+}
+
+bool SoftwareOcclusionCuller::IsVisible(const AABB& bounds)
+{
+    if (m_OccludersDirty)
+        RasterizeOccluders();
+
+    const Timer timer;
+
+    glm::vec3 ndcMin = glm::vec3(std::numeric_limits<float>::max());
+    glm::vec3 ndcMax = glm::vec3(std::numeric_limits<float>::lowest());
+    for (uint32_t i = 0; i < 8; ++i)
+    {
+        const glm::vec4 corner = {
+            (i & 1) ? bounds.Max.x : bounds.Min.x,
+            (i & 2) ? bounds.Max.y : bounds.Min.y,
+            (i & 4) ? bounds.Max.z : bounds.Min.z,
+            1.0f
+        };
+        const glm::vec4 clip = m_ViewProjection * corner;
+
+        // Boxes reaching behind the camera have no usable screen rectangle
+        if (clip.w <= std::numeric_limits<float>::epsilon())
+        {
+            m_ElapsedMilliseconds += timer.ElapsedMillis();
+            return true;
+        }
+
+        const glm::vec3 ndc = glm::vec3(clip) / clip.w;
+        ndcMin = glm::min(ndcMin, ndc);
+        ndcMax = glm::max(ndcMax, ndc);
+    }
+
+    if (ndcMax.x < -1.0f || ndcMin.x > 1.0f || ndcMax.y < -1.0f || ndcMin.y > 1.0f || ndcMin.z > 1.0f)
+    {
+        m_ElapsedMilliseconds += timer.ElapsedMillis();
+        return false;
+    }
+
+    // Every pixel the rectangle touches counts, visible as soon as one of them isn't covered by a nearer occluder.
+    // A partly covered pixel always keeps the depth behind the occluder, so slivers past a silhouette stay visible
+    const auto toPixel = [](float ndc, uint32_t size)
+    {
+        return std::clamp(static_cast<int32_t>(std::floor((ndc * 0.5f + 0.5f) * static_cast<float>(size))), 0, static_cast<int32_t>(size) - 1);
+    };
+    const int32_t minX = toPixel(ndcMin.x, m_Width);
+    const int32_t maxX = toPixel(ndcMax.x, m_Width);
+    const int32_t minY = toPixel(ndcMin.y, m_Height);
+    const int32_t maxY = toPixel(ndcMax.y, m_Height);
+    const float nearestDepth = ndcMin.z * 0.5f + 0.5f;
+
+    bool visible = false;
+    for (int32_t y = minY; y <= maxY && !visible; ++y)
+    {
+        const float* row = m_DepthBuffer.data() + static_cast<size_t>(y) * m_Width;
+#if defined(BH_OCCLUSION_AVX2)
+        if (m_UseAVX2)
+        {
+            visible = Utils::FindFartherPixelAVX2(row, minX, maxX, nearestDepth) <= maxX;
+            continue;
+        }
+#endif
+        visible = Utils::FindFartherPixel(row, minX, maxX, nearestDepth) <= maxX;
+    }
+
+    m_ElapsedMilliseconds += timer.ElapsedMillis();
+    return visible;
+}
+
+void SoftwareOcclusionCuller::RasterizeOccluders()
+{
+    BH_PROFILE_FUNCTION();
+
+    const Timer timer;
+
+    m_Triangles.resize(m_Occluders.size());
+    m_ThreadPool.ParallelFor(static_cast<uint32_t>(m_Occluders.size()), [this](uint32_t occluderIndex) { SetupTriangles(occluderIndex); });
+
+    // Tiles own disjoint parts of the depth buffer, so they rasterize without synchronization
+    m_ThreadPool.ParallelFor(m_TilesX * m_TilesY, [this](uint32_t tileIndex) { RasterizeTile(tileIndex); });
+
+    m_OccludersDirty = false;
+    m_ElapsedMilliseconds += timer.ElapsedMillis();
+}
+
+void SoftwareOcclusionCuller::SetupTriangles(uint32_t occluderIndex)
+{
+    const Occluder& occluder = m_Occluders[occluderIndex];
+    auto& triangles = m_Triangles[occluderIndex];
+    triangles.clear();
+
+    const glm::mat4 modelViewProjection = m_ViewProjection * occluder.Transform;
+    const auto width = static_cast<float>(m_Width);
+    const auto height = static_cast<float>(m_Height);
+
+    const auto& positions = *occluder.Positions;
+    const auto& indices = *occluder.TriangleIndices;
+
+    thread_local std::vector<glm::vec4> clipPositions;
+    clipPositions.resize(positions.size());
+    for (size_t i = 0; i < positions.size(); ++i)
+        clipPositions[i] = modelViewProjection * glm::vec4(positions[i], 1.0f);
+
+    for (size_t i = 0; i + 2 < indices.size(); i += 3)
+    {
+        const glm::vec4 clip[3] = { clipPositions[indices[i]], clipPositions[indices[i + 1]], clipPositions[indices[i + 2]] };
+
+        // Triangles crossing the near plane are dropped, which only ever loses occlusion
+        if (clip[0].z < -clip[0].w || clip[1].z < -clip[1].w || clip[2].z < -clip[2].w)
+            continue;
+
+        float x[3], y[3], z[3];
+        for (uint32_t v = 0; v < 3; ++v)
+        {
+            x[v] = (clip[v].x / clip[v].w * 0.5f + 0.5f) * width;
+            y[v] = (clip[v].y / clip[v].w * 0.5f + 0.5f) * height;
+            z[v] = clip[v].z / clip[v].w * 0.5f + 0.5f;
+        }
+
+        // Counter-clockwise front faces have a positive area, back faces and slivers are skipped
+        const float area = (x[1] - x[0]) * (y[2] - y[0]) - (x[2] - x[0]) * (y[1] - y[0]);
+        if (area <= 0.0f)
+            continue;
+
+        ScreenTriangle triangle;
+
+        // Pixels whose centre lies inside the bounds of the triangle
+        triangle.MinX = std::max(static_cast<int32_t>(std::ceil(std::min({ x[0], x[1], x[2] }) - 0.5f)), 0);
+        triangle.MinY = std::max(static_cast<int32_t>(std::ceil(std::min({ y[0], y[1], y[2] }) - 0.5f)), 0);
+        triangle.MaxX = std::min(static_cast<int32_t>(std::floor(std::max({ x[0], x[1], x[2] }) - 0.5f)), static_cast<int32_t>(m_Width) - 1);
+        triangle.MaxY = std::min(static_cast<int32_t>(std::floor(std::max({ y[0], y[1], y[2] }) - 0.5f)), static_cast<int32_t>(m_Height) - 1);
+        if (triangle.MinX > triangle.MaxX || triangle.MinY > triangle.MaxY)
+            continue;
+
+        // Edge i is opposite vertex i, so normalized by the area it is that vertex's barycentric weight
+        for (uint32_t edge = 0; edge < 3; ++edge)
+        {
+            const uint32_t a = (edge + 1) % 3;
+            const uint32_t b = (edge + 2) % 3;
+            triangle.EdgeA[edge] = y[a] - y[b];
+            triangle.EdgeB[edge] = x[b] - x[a];
+            triangle.EdgeC[edge] = x[a] * y[b] - x[b] * y[a];
+        }
+
+        const float invArea = 1.0f / area;
+        triangle.DepthA = (triangle.EdgeA[0] * z[0] + triangle.EdgeA[1] * z[1] + triangle.EdgeA[2] * z[2]) * invArea;
+        triangle.DepthB = (triangle.EdgeB[0] * z[0] + triangle.EdgeB[1] * z[1] + triangle.EdgeB[2] * z[2]) * invArea;
+        triangle.DepthC = (triangle.EdgeC[0] * z[0] + triangle.EdgeC[1] * z[1] + triangle.EdgeC[2] * z[2]) * invArea;
+
+        // Stores the farthest depth the plane reaches within the pixel, so occludees are never rejected too eagerly
+        triangle.DepthC += 0.5f * (std::abs(triangle.DepthA) + std::abs(triangle.DepthB));
+        triangle.MaxDepth = std::max({ z[0], z[1], z[2] });
+
+        // Evaluated at the pixel centre, the edge now passes only if it passes at the pixel's worst corner too.
+        // Pixels on a silhouette are left alone, so an occludee showing past it by less than a pixel is kept
+        for (uint32_t edge = 0; edge < 3; ++edge)
+            triangle.EdgeC[edge] -= 0.5f * (std::abs(triangle.EdgeA[edge]) + std::abs(triangle.EdgeB[edge]));
+
+        triangles.push_back(triangle);
+    }
+}
+
+void SoftwareOcclusionCuller::RasterizeTile(uint32_t tileIndex)
+{
+    BH_PROFILE_FUNCTION();
+
+    const auto tileMinX = static_cast<int32_t>((tileIndex % m_TilesX) * s_TileWidth);
+    const auto tileMinY = static_cast<int32_t>((tileIndex / m_TilesX) * s_TileHeight);
+    const int32_t tileMaxX = std::min(tileMinX + static_cast<int32_t>(s_TileWidth), static_cast<int32_t>(m_Width)) - 1;
+    const int32_t tileMaxY = std::min(tileMinY + static_cast<int32_t>(s_TileHeight), static_cast<int32_t>(m_Height)) - 1;
+
+    for (int32_t y = tileMinY; y <= tileMaxY; ++y)
+    {
+        float* row = m_DepthBuffer.data() + static_cast<size_t>(y) * m_Width;
+        std::fill(row + tileMinX, row + tileMaxX + 1, 1.0f);
+    }
+
+    for (const auto& triangles : m_Triangles)
+    {
+        for (const ScreenTriangle& triangle : triangles)
+        {
+            if (triangle.MaxX < tileMinX || triangle.MinX > tileMaxX || triangle.MaxY < tileMinY || triangle.MinY > tileMaxY)
+                continue;
+
+            // Blocks start 8-aligned, tile edges are too, so a block never straddles two tiles
+            const int32_t minX = std::max(triangle.MinX, tileMinX) & ~7;
+            const int32_t maxX = std::min(triangle.MaxX, tileMaxX);
+            const int32_t minY = std::max(triangle.MinY, tileMinY);
+            const int32_t maxY = std::min(triangle.MaxY, tileMaxY);
+
+            for (int32_t y = minY; y <= maxY; ++y)
+            {
+                float* row = m_DepthBuffer.data() + static_cast<size_t>(y) * m_Width;
+                const float centerY = static_cast<float>(y) + 0.5f;
+
+#if defined(BH_OCCLUSION_AVX2)
+                if (m_UseAVX2)
+                {
+                    Utils::RasterizeRowAVX2(row, minX, maxX, centerY, triangle.EdgeA, triangle.EdgeB, triangle.EdgeC,
+                        triangle.DepthA, triangle.DepthB, triangle.DepthC, triangle.MaxDepth);
+                    continue;
+                }
+#endif
+                Utils::RasterizeRow(row, minX, maxX, centerY, triangle.EdgeA, triangle.EdgeB, triangle.EdgeC,
+                    triangle.DepthA, triangle.DepthB, triangle.DepthC, triangle.MaxDepth);
+            }
+        }
+    }
+}
\ No newline at end of file
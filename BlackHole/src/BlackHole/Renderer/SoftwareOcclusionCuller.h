@@ -0,0 +1,74 @@
+#pragma once
+#include "BlackHole/Core/ThreadPool.h"
+#include "BlackHole/Renderer/BoundingBox.h"
+#include "BlackHole/Renderer/Camera.h"
+#include "BlackHole/Renderer/Model.h"
+
+// Low resolution depth buffer rasterized on the CPU from a few large occluders,
+// so objects hidden behind them can be rejected before they are queued for drawing
+class SoftwareOcclusionCuller
+{
+public:
+    // The width has to be a multiple of 8, rows are rasterized 8 pixels at a time
+    explicit SoftwareOcclusionCuller(ThreadPool& threadPool, uint32_t width = 256, uint32_t height = 128);
+
+    void BeginFrame(const PerspectiveCamera& camera);
+
+    // Occluders are rasterized together, the first time a test needs the depth buffer
+    void AddOccluder(const Ref<Model>& model, const glm::mat4& transform);
+    // Counter-clockwise triangle list, the geometry has to stay alive until the next BeginFrame
+    void AddOccluder(const std::vector<glm::vec3>& positions, const std::vector<uint32_t>& triangleIndices, const glm::mat4& transform);
+
+    // False when the world space box is outside the frustum or entirely behind the occluders.
+    // Only pixels an occluder covers completely count, so an object is never hidden by less than a pixel
+    bool IsVisible(const AABB& bounds);
+
+    // CPU time spent rasterizing and testing since BeginFrame
+    float GetElapsedMilliseconds() const { return m_ElapsedMilliseconds; }
+
+    const std::vector<float>& GetDepthBuffer() const { return m_DepthBuffer; }
+    uint32_t GetWidth() const { return m_Width; }
+    uint32_t GetHeight() const { return m_Height; }
+private:
+    // One per mesh, the model reference keeps the geometry alive
+    struct Occluder
+    {
+        Ref<Model> SourceModel;
+        const std::vector<glm::vec3>* Positions;
+        const std::vector<uint32_t>* TriangleIndices;
+        glm::mat4 Transform;
+    };
+
+    // Edge functions and depth plane in pixel coordinates, evaluated at pixel centres.
+    // The edges are pulled in by half a pixel, so they only pass for pixels entirely inside the triangle
+    struct ScreenTriangle
+    {
+        int32_t MinX, MinY, MaxX, MaxY;
+        float EdgeA[3], EdgeB[3], EdgeC[3];
+        float DepthA, DepthB, DepthC;
+        float MaxDepth;
+    };
+
+    void RasterizeOccluders();
+    void SetupTriangles(uint32_t occluderIndex);
+    void RasterizeTile(uint32_t tileIndex);
+private:
+    ThreadPool& m_ThreadPool;
+
+    uint32_t m_Width, m_Height;
+    uint32_t m_TilesX, m_TilesY;
+
+    // Picked at runtime, the engine itself isn't built for AVX2
+    bool m_UseAVX2;
+
+    glm::mat4 m_ViewProjection = glm::mat4(1.0f);
+
+    std::vector<Occluder> m_Occluders;
+    std::vector<std::vector<ScreenTriangle>> m_Triangles;
+    bool m_OccludersDirty = false;
+
+    // Window space depth, 0 at the near plane and 1 at the far plane
+    std::vector<float> m_DepthBuffer;
+
+    float m_ElapsedMilliseconds = 0.0f;
+};
\ No newline at end of file
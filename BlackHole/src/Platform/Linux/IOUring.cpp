@@ -0,0 +1,158 @@
+#include "bhpch.h"
+#include "Platform/Linux/IOUring.h"
+
+#if BH_HAS_IO_URING
+
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+namespace Utils
+{
+    // The rings are written by the kernel, head and tail need acquire and release ordering
+    static uint32_t LoadAcquire(uint32_t* value)
+    {
+        return std::atomic_ref<uint32_t>(*value).load(std::memory_order_acquire);
+    }
+
+    static void StoreRelease(uint32_t* value, uint32_t newValue)
+    {
+        std::atomic_ref<uint32_t>(*value).store(newValue, std::memory_order_release);
+    }
+
+    template <typename T>
+    static T* Offset(void* base, uint32_t offset)
+    {
+        return reinterpret_cast<T*>(static_cast<uint8_t*>(base) + offset);
+    }
+}
+
+IOUring::IOUring(uint32_t entries)
+{
+    io_uring_params params = {};
+    const int ringFD = static_cast<int>(syscall(__NR_io_uring_setup, entries, &params));
+    if (ringFD < 0)
+        return;
+
+    m_SubmissionRingSize = params.sq_off.array + params.sq_entries * sizeof(uint32_t);
+    m_CompletionRingSize = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+
+    // Newer kernels map both rings with one call
+    const bool isSingleMap = params.features & IORING_FEAT_SINGLE_MMAP;
+    if (isSingleMap)
+        m_SubmissionRingSize = m_CompletionRingSize = std::max(m_SubmissionRingSize, m_CompletionRingSize);
+
+    m_SubmissionRing = mmap(nullptr, m_SubmissionRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ringFD, IORING_OFF_SQ_RING);
+    if (m_SubmissionRing == MAP_FAILED)
+    {
+        m_SubmissionRing = nullptr;
+        close(ringFD);
+        return;
+    }
+
+    if (isSingleMap)
+    {
+        m_CompletionRing = m_SubmissionRing;
+    }
+    else
+    {
+        m_CompletionRing = mmap(nullptr, m_CompletionRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ringFD, IORING_OFF_CQ_RING);
+        if (m_CompletionRing == MAP_FAILED)
+        {
+            m_CompletionRing = nullptr;
+            munmap(m_SubmissionRing, m_SubmissionRingSize);
+            m_SubmissionRing = nullptr;
+            close(ringFD);
+            return;
+        }
+    }
+
+    m_SubmissionEntriesSize = params.sq_entries * sizeof(io_uring_sqe);
+    void* submissionEntries = mmap(nullptr, m_SubmissionEntriesSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ringFD, IORING_OFF_SQES);
+    if (submissionEntries == MAP_FAILED)
+    {
+        if (!isSingleMap)
+            munmap(m_CompletionRing, m_CompletionRingSize);
+        munmap(m_SubmissionRing, m_SubmissionRingSize);
+        m_SubmissionRing = m_CompletionRing = nullptr;
+        close(ringFD);
+        return;
+    }
+    m_SubmissionEntries = static_cast<io_uring_sqe*>(submissionEntries);
+
+    m_SubmissionHead = Utils::Offset<uint32_t>(m_SubmissionRing, params.sq_off.head);
+    m_SubmissionTail = Utils::Offset<uint32_t>(m_SubmissionRing, params.sq_off.tail);
+    m_SubmissionMask = *Utils::Offset<uint32_t>(m_SubmissionRing, params.sq_off.ring_mask);
+    m_SubmissionEntryCount = params.sq_entries;
+    m_SubmissionArray = Utils::Offset<uint32_t>(m_SubmissionRing, params.sq_off.array);
+
+    m_CompletionHead = Utils::Offset<uint32_t>(m_CompletionRing, params.cq_off.head);
+    m_CompletionTail = Utils::Offset<uint32_t>(m_CompletionRing, params.cq_off.tail);
+    m_CompletionMask = *Utils::Offset<uint32_t>(m_CompletionRing, params.cq_off.ring_mask);
+    m_CompletionEntries = Utils::Offset<io_uring_cqe>(m_CompletionRing, params.cq_off.cqes);
+
+    m_LocalTail = m_PublishedTail = *m_SubmissionTail;
+    m_RingFD = ringFD;
+}
+
+IOUring::~IOUring()
+{
+    if (m_RingFD < 0)
+        return;
+
+    munmap(m_SubmissionEntries, m_SubmissionEntriesSize);
+    if (m_CompletionRing != m_SubmissionRing)
+        munmap(m_CompletionRing, m_CompletionRingSize);
+    munmap(m_SubmissionRing, m_SubmissionRingSize);
+    close(m_RingFD);
+}
+
+bool IOUring::RegisterBuffers(const iovec* buffers, uint32_t count)
+{
+    return syscall(__NR_io_uring_register, m_RingFD, IORING_REGISTER_BUFFERS, buffers, count) == 0;
+}
+
+io_uring_sqe* IOUring::GetSubmissionEntry()
+{
+    if (m_LocalTail - Utils::LoadAcquire(m_SubmissionHead) >= m_SubmissionEntryCount)
+        return nullptr;
+
+    const uint32_t index = m_LocalTail & m_SubmissionMask;
+    io_uring_sqe* entry = &m_SubmissionEntries[index];
+    std::memset(entry, 0, sizeof(*entry));
+    m_SubmissionArray[index] = index;
+    ++m_LocalTail;
+    return entry;
+}
+
+int IOUring::Submit(uint32_t minCompletions)
+{
+    const uint32_t submitCount = m_LocalTail - m_PublishedTail;
+    Utils::StoreRelease(m_SubmissionTail, m_LocalTail);
+    m_PublishedTail = m_LocalTail;
+
+    const uint32_t flags = minCompletions > 0 ? IORING_ENTER_GETEVENTS : 0;
+    while (true)
+    {
+        const long result = syscall(__NR_io_uring_enter, m_RingFD, submitCount, minCompletions, flags, nullptr, 0);
+        if (result >= 0)
+            return static_cast<int>(result);
+        if (errno != EINTR)
+            return -errno;
+    }
+}
+
+io_uring_cqe* IOUring::PeekCompletion()
+{
+    const uint32_t head = *m_CompletionHead;
+    if (head == Utils::LoadAcquire(m_CompletionTail))
+        return nullptr;
+    return &m_CompletionEntries[head & m_CompletionMask];
+}
+
+void IOUring::SeenCompletion()
+{
+    Utils::StoreRelease(m_CompletionHead, *m_CompletionHead + 1);
+}
+
+#endif
\ No newline at end of file
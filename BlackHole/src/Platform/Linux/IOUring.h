@@ -0,0 +1,71 @@
+#pragma once
+
+#if defined(__linux__) && __has_include(<linux/io_uring.h>)
+    #define BH_HAS_IO_URING 1
+#else
+    #define BH_HAS_IO_URING 0
+#endif
+
+#if BH_HAS_IO_URING
+
+#include <linux/io_uring.h>
+#include <sys/uio.h>
+
+// Submission and completion rings shared with the kernel, set up with the raw system calls.
+// Not thread-safe, one thread submits and reaps
+class IOUring
+{
+public:
+    explicit IOUring(uint32_t entries);
+    ~IOUring();
+
+    IOUring(const IOUring&) = delete;
+    IOUring& operator=(const IOUring&) = delete;
+
+    // False when the kernel has no io_uring or it's disabled, such as by a seccomp profile
+    bool IsValid() const { return m_RingFD >= 0; }
+
+    // Pins the buffers once for IORING_OP_READ_FIXED, indexed by their position
+    bool RegisterBuffers(const iovec* buffers, uint32_t count);
+
+    // Zeroed entry to fill in, nullptr when the submission ring is full
+    io_uring_sqe* GetSubmissionEntry();
+    // Hands the entries gotten since the last call to the kernel and waits for at least minCompletions
+    // completions, returns the number submitted or a negative errno
+    int Submit(uint32_t minCompletions = 0);
+
+    // Oldest unseen completion, nullptr when there is none
+    io_uring_cqe* PeekCompletion();
+    void SeenCompletion();
+private:
+    int m_RingFD = -1;
+
+    void* m_SubmissionRing = nullptr;
+    size_t m_SubmissionRingSize = 0;
+    void* m_CompletionRing = nullptr;
+    size_t m_CompletionRingSize = 0;
+    io_uring_sqe* m_SubmissionEntries = nullptr;
+    size_t m_SubmissionEntriesSize = 0;
+
+    uint32_t* m_SubmissionHead = nullptr;
+    uint32_t* m_SubmissionTail = nullptr;
+    uint32_t m_SubmissionMask = 0;
+    uint32_t m_SubmissionEntryCount = 0;
+    uint32_t* m_SubmissionArray = nullptr;
+
+    uint32_t* m_CompletionHead = nullptr;
+    uint32_t* m_CompletionTail = nullptr;
+    uint32_t m_CompletionMask = 0;
+    io_uring_cqe* m_CompletionEntries = nullptr;
+
+    // Entries gotten but not yet published to the kernel
+    uint32_t m_LocalTail = 0;
+    uint32_t m_PublishedTail = 0;
+};
+
+#else
+
+// Never created without io_uring, only here so owners of one compile everywhere
+class IOUring {};
+
+#endif
\ No newline at end of file
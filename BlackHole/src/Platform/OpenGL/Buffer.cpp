@@ -38,6 +38,16 @@ void Buffer::Unmap() const
     glUnmapNamedBuffer(m_RendererID);
 }
 
+void Buffer::SetData(uint64_t offset, uint64_t size, const void* data) const
+{
+    glNamedBufferSubData(m_RendererID, static_cast<int64_t>(offset), static_cast<int64_t>(size), data);
+}
+
+void Buffer::GetData(uint64_t offset, uint64_t size, void* data) const
+{
+    glGetNamedBufferSubData(m_RendererID, static_cast<int64_t>(offset), static_cast<int64_t>(size), data);
+}
+
 void Buffer::GetBufferParameterInt(uint32_t paramName, int32_t* params) const
 {
     glGetNamedBufferParameteriv(m_RendererID, paramName, params);
@@ -103,4 +113,18 @@ UniformBuffer::UniformBuffer(uint64_t size, uint32_t binding)
     : Buffer(size)
 {
     glBindBufferBase(GL_UNIFORM_BUFFER, binding, m_RendererID);
+}
+
+// Shader Storage Buffer
+
+ShaderStorageBuffer::ShaderStorageBuffer(uint64_t size, const void* data, uint32_t binding)
+    : Buffer(size, data)
+    , m_Binding(binding)
+{
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, m_Binding, m_RendererID);
+}
+
+void ShaderStorageBuffer::Bind() const
+{
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, m_Binding, m_RendererID);
 }
\ No newline at end of file
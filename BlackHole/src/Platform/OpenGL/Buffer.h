@@ -90,10 +90,15 @@ public:
     void* Map(uint64_t offset, uint64_t length) const;
     void Unmap() const;
 
+    void SetData(uint64_t offset, uint64_t size, const void* data) const;
+    void GetData(uint64_t offset, uint64_t size, void* data) const;
+
     void GetBufferParameterInt(uint32_t paramName, int32_t* params) const;
     void GetBufferParameterInt64(uint32_t paramName, int64_t* params) const;
 
     virtual void Bind() const = 0;
+
+    uint32_t GetRendererID() const { return m_RendererID; }
 protected:
     uint32_t m_RendererID;
 };
@@ -138,4 +143,16 @@ public:
     ~UniformBuffer() override = default;
 
     void Bind() const override {};
+};
+
+class ShaderStorageBuffer : public Buffer
+{
+public:
+    ShaderStorageBuffer(uint64_t size, const void* data, uint32_t binding);
+    ~ShaderStorageBuffer() override = default;
+
+    // Binds the whole buffer to its binding point, for buffers that share one binding point
+    void Bind() const override;
+private:
+    uint32_t m_Binding;
 };
\ No newline at end of file
@@ -4,6 +4,9 @@
 #include <glad/glad.h>
 #include <GLFW/glfw3.h>
 
+#include "Platform/OpenGL/ProgramBinaryCache.h"
+#include "Platform/OpenGL/Shader.h"
+
 static void APIENTRY OpenGLErrorCallback(
     GLenum source,
     GLenum type,
@@ -62,6 +65,8 @@ Context::Context(GLFWwindow* window)
 
 void Context::Init()
 {
+    BH_PROFILE_FUNCTION();
+
     glfwMakeContextCurrent(m_WindowHandle);
     const int status = gladLoadGLLoader(reinterpret_cast<GLADloadproc>(glfwGetProcAddress));
     BH_ASSERT(status, "Failed to initialize Glad!");
@@ -78,9 +83,13 @@ void Context::Init()
     glEnable(GL_TEXTURE_CUBE_MAP_SEAMLESS);
     glEnable(GL_MULTISAMPLE);
 
-    BH_LOG_INFO("[OpenGL] Vendor: {0}", reinterpret_cast<const char*>(glGetString(GL_VENDOR)));
-    BH_LOG_INFO("[OpenGL] Renderer: {0}", reinterpret_cast<const char*>(glGetString(GL_RENDERER)));
-    BH_LOG_INFO("[OpenGL] Version: {0}", reinterpret_cast<const char*>(glGetString(GL_VERSION)));
+    m_Info.Vendor = reinterpret_cast<const char*>(glGetString(GL_VENDOR));
+    m_Info.Renderer = reinterpret_cast<const char*>(glGetString(GL_RENDERER));
+    m_Info.Version = reinterpret_cast<const char*>(glGetString(GL_VERSION));
+
+    BH_LOG_INFO("[OpenGL] Vendor: {0}", m_Info.Vendor);
+    BH_LOG_INFO("[OpenGL] Renderer: {0}", m_Info.Renderer);
+    BH_LOG_INFO("[OpenGL] Version: {0}", m_Info.Version);
 
 #ifdef BH_DEBUG
     int flags; glGetIntegerv(GL_CONTEXT_FLAGS, &flags);
@@ -93,9 +102,72 @@ void Context::Init()
         BH_LOG_DEBUG("[OpenGL] Debug context: Initialized successfully.");
     }
 #endif
+
+    ProgramBinaryCache::Init(Filesystem::GetCachePath() / "shaders", m_Info);
+    InitParallelShaderCompile();
+    InitSpirvShaders();
+}
+
+void Context::InitParallelShaderCompile()
+{
+    // GL_KHR_parallel_shader_compile and its ARB predecessor are missing from the loader, so look them up by hand
+    using MaxShaderCompilerThreadsFn = void (APIENTRY*)(GLuint count);
+
+    GLint extensionCount = 0;
+    glGetIntegerv(GL_NUM_EXTENSIONS, &extensionCount);
+
+    MaxShaderCompilerThreadsFn maxShaderCompilerThreads = nullptr;
+    for (GLint i = 0; i < extensionCount && !maxShaderCompilerThreads; ++i)
+    {
+        const std::string_view extension = reinterpret_cast<const char*>(glGetStringi(GL_EXTENSIONS, i));
+        if (extension == "GL_KHR_parallel_shader_compile")
+            maxShaderCompilerThreads = reinterpret_cast<MaxShaderCompilerThreadsFn>(glfwGetProcAddress("glMaxShaderCompilerThreadsKHR"));
+        else if (extension == "GL_ARB_parallel_shader_compile")
+            maxShaderCompilerThreads = reinterpret_cast<MaxShaderCompilerThreadsFn>(glfwGetProcAddress("glMaxShaderCompilerThreadsARB"));
+    }
+
+    m_Info.ParallelShaderCompile = maxShaderCompilerThreads != nullptr;
+    Shader::SetCompletionStatusSupported(m_Info.ParallelShaderCompile);
+    if (!m_Info.ParallelShaderCompile)
+    {
+        BH_LOG_INFO("[OpenGL] No parallel shader compilation, shader reloads finish on the main thread");
+        return;
+    }
+
+    // All ones lets the driver pick how many threads to use
+    maxShaderCompilerThreads(0xFFFFFFFF);
+    BH_LOG_INFO("[OpenGL] Parallel shader compilation enabled");
+}
+
+void Context::InitSpirvShaders()
+{
+    // Core in 4.6, still listed among the binary formats only when the driver actually takes SPIR-V
+    GLint formatCount = 0;
+    if (GLAD_GL_VERSION_4_6)
+        glGetIntegerv(GL_NUM_SHADER_BINARY_FORMATS, &formatCount);
+
+    std::vector<GLint> formats(formatCount);
+    if (formatCount > 0)
+        glGetIntegerv(GL_SHADER_BINARY_FORMATS, formats.data());
+
+    m_Info.SpirvShaders = std::ranges::find(formats, GL_SHADER_BINARY_FORMAT_SPIR_V) != formats.end();
+    if (!m_Info.SpirvShaders)
+    {
+        BH_LOG_INFO("[OpenGL] No SPIR-V support, shaders compile from GLSL");
+        return;
+    }
+
+#ifdef BH_SPIRV_DIRECTORY
+    Shader::SetSpirvDirectory(BH_SPIRV_DIRECTORY);
+    BH_LOG_INFO("[OpenGL] SPIR-V shaders enabled");
+#else
+    BH_LOG_INFO("[OpenGL] Built without SPIR-V shaders, shaders compile from GLSL");
+#endif
 }
 
 void Context::SwapBuffers()
 {
+    BH_PROFILE_FUNCTION();
+
     glfwSwapBuffers(m_WindowHandle);
 }
\ No newline at end of file
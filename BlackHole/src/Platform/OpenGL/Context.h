@@ -2,6 +2,17 @@
 
 struct GLFWwindow;
 
+struct ContextInfo
+{
+    std::string Vendor;
+    std::string Renderer;
+    std::string Version;
+    // Shaders compile on driver threads and report completion without blocking
+    bool ParallelShaderCompile = false;
+    // Shader stages can be loaded from SPIR-V modules
+    bool SpirvShaders = false;
+};
+
 class Context
 {
 public:
@@ -10,6 +21,12 @@ public:
 
     void Init();
     void SwapBuffers();
+
+    const ContextInfo& GetInfo() const { return m_Info; }
+private:
+    void InitParallelShaderCompile();
+    void InitSpirvShaders();
 private:
     GLFWwindow* m_WindowHandle;
+    ContextInfo m_Info;
 };
\ No newline at end of file
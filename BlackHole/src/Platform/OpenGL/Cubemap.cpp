@@ -1,30 +1,33 @@
 #include "bhpch.h"
 #include "Platform/OpenGL/Cubemap.h"
 
-#include <stb_image.h>
 #include <glad/glad.h>
 #include <glm/common.hpp>
 #include <glm/exponential.hpp>
 
+#include "BlackHole/Renderer/Image.h"
+
 Cubemap::Cubemap(const CubemapSpecification& specification)
 {
-    std::array<std::string, 6> faces;
+    BH_PROFILE_FUNCTION();
+
+    std::vector<std::filesystem::path> faces(6);
 
-    faces[0] = specification.Right.string();
-    faces[1] = specification.Left.string();
-    faces[2] = specification.Top.string();
-    faces[3] = specification.Bottom.string();
-    faces[4] = specification.Front.string();
-    faces[5] = specification.Back.string();
+    faces[0] = specification.Right;
+    faces[1] = specification.Left;
+    faces[2] = specification.Top;
+    faces[3] = specification.Bottom;
+    faces[4] = specification.Front;
+    faces[5] = specification.Back;
 
-    int width, height, channels;
-    stbi_uc* rightFacePixels = stbi_load(faces[0].c_str() , &width, &height, &channels, 0);
-    BH_ASSERT(rightFacePixels, "Failed to load image!");
+    const std::vector<Image> images = Image::LoadAll(faces);
+    const Image& rightFace = images[0];
+    BH_ASSERT(rightFace.IsValid(), "Failed to load image!");
 
-    if (rightFacePixels)
+    if (rightFace.IsValid())
     {
         GLenum internalFormat = 0, dataFormat = 0;
-        switch (channels)
+        switch (rightFace.GetChannels())
         {
         case 1:
             internalFormat = GL_R8;
@@ -49,23 +52,17 @@ Cubemap::Cubemap(const CubemapSpecification& specification)
         m_InternalFormat = internalFormat;
         m_DataFormat = dataFormat;
 
-        m_Length = static_cast<uint32_t>(glm::min(width, height));
+        m_Length = glm::min(rightFace.GetWidth(), rightFace.GetHeight());
 
         glCreateTextures(GL_TEXTURE_CUBE_MAP, 1, &m_RendererID);
         glTextureStorage2D(m_RendererID, static_cast<int32_t>(glm::log2(static_cast<float>(static_cast<int32_t>(m_Length))) + 1), m_InternalFormat, static_cast<int32_t>(m_Length), static_cast<int32_t>(m_Length));
-        glTextureSubImage3D(m_RendererID, 0, 0, 0, 0, static_cast<int32_t>(m_Length), static_cast<int32_t>(m_Length), 1, m_DataFormat, GL_UNSIGNED_BYTE, rightFacePixels);
-
-        stbi_image_free(rightFacePixels);
+        glTextureSubImage3D(m_RendererID, 0, 0, 0, 0, static_cast<int32_t>(m_Length), static_cast<int32_t>(m_Length), 1, m_DataFormat, GL_UNSIGNED_BYTE, rightFace.GetPixels());
 
         for (int32_t i = 1; i < 6; ++i)
         {
-            stbi_uc* pixels = stbi_load(faces[i].c_str() , &width, &height, &channels, 0);
-            BH_ASSERT(pixels, "Failed to load image!");
-            if (pixels)
-            {
-                glTextureSubImage3D(m_RendererID, 0, 0, 0, i, static_cast<int32_t>(m_Length), static_cast<int32_t>(m_Length), 1, m_DataFormat, GL_UNSIGNED_BYTE, pixels);
-                stbi_image_free(pixels);
-            }
+            BH_ASSERT(images[i].IsValid(), "Failed to load image!");
+            if (images[i].IsValid())
+                glTextureSubImage3D(m_RendererID, 0, 0, 0, i, static_cast<int32_t>(m_Length), static_cast<int32_t>(m_Length), 1, m_DataFormat, GL_UNSIGNED_BYTE, images[i].GetPixels());
         }
 
         glGenerateTextureMipmap(m_RendererID);
@@ -0,0 +1,86 @@
+#include "bhpch.h"
+#include "Platform/OpenGL/DepthPyramid.h"
+
+#include <glad/glad.h>
+
+static constexpr uint32_t s_GroupSize = 8;
+
+DepthPyramid::DepthPyramid()
+{
+    m_CopyShader = CreateRef<Shader>(Filesystem::GetShadersPath() / "hiz_copy.glsl");
+    m_ReduceShader = CreateRef<Shader>(Filesystem::GetShadersPath() / "hiz_reduce.glsl");
+}
+
+DepthPyramid::~DepthPyramid()
+{
+    glDeleteTextures(1, &m_RendererID);
+}
+
+void DepthPyramid::Build(const Ref<Framebuffer>& source)
+{
+    BH_PROFILE_FUNCTION();
+
+    // The pyramid covers only the render area, so culling maps the screen onto it unchanged
+    const auto& sourceArea = source->GetRenderArea();
+    if (sourceArea.x != m_Width || sourceArea.y != m_Height)
+        Resize(sourceArea.x, sourceArea.y);
+
+    uint32_t depthTexture = source->GetDepthAttachmentRendererID();
+    const auto& sourceSpec = source->GetSpecification();
+    if (sourceSpec.Samples > 1)
+    {
+        // Sized like the source's attachments, so render area changes don't reallocate it
+        FramebufferSpecification depthSpec;
+        depthSpec.Width = sourceSpec.Width;
+        depthSpec.Height = sourceSpec.Height;
+        depthSpec.Samples = 1;
+        if (!m_DepthFramebuffer)
+            m_DepthFramebuffer = CreateRef<Framebuffer>(depthSpec);
+        else if (m_DepthFramebuffer->GetSpecification().Width != depthSpec.Width || m_DepthFramebuffer->GetSpecification().Height != depthSpec.Height)
+            m_DepthFramebuffer->Resize(depthSpec.Width, depthSpec.Height);
+
+        m_DepthFramebuffer->SetRenderArea(sourceArea.x, sourceArea.y);
+        m_DepthFramebuffer->BlitDepthAttachment(source);
+        depthTexture = m_DepthFramebuffer->GetDepthAttachmentRendererID();
+    }
+
+    glMemoryBarrier(GL_FRAMEBUFFER_BARRIER_BIT);
+
+    glBindTextureUnit(0, depthTexture);
+    glBindImageTexture(1, m_RendererID, 0, GL_FALSE, 0, GL_WRITE_ONLY, GL_R32F);
+    m_CopyShader->Dispatch((m_Width + s_GroupSize - 1) / s_GroupSize, (m_Height + s_GroupSize - 1) / s_GroupSize);
+
+    for (uint32_t level = 1; level < m_LevelCount; ++level)
+    {
+        const uint32_t levelWidth = std::max(m_Width >> level, 1u);
+        const uint32_t levelHeight = std::max(m_Height >> level, 1u);
+
+        glMemoryBarrier(GL_SHADER_IMAGE_ACCESS_BARRIER_BIT);
+
+        glBindImageTexture(0, m_RendererID, static_cast<int32_t>(level - 1), GL_FALSE, 0, GL_READ_ONLY, GL_R32F);
+        glBindImageTexture(1, m_RendererID, static_cast<int32_t>(level), GL_FALSE, 0, GL_WRITE_ONLY, GL_R32F);
+        m_ReduceShader->Dispatch((levelWidth + s_GroupSize - 1) / s_GroupSize, (levelHeight + s_GroupSize - 1) / s_GroupSize);
+    }
+
+    glMemoryBarrier(GL_TEXTURE_FETCH_BARRIER_BIT);
+}
+
+void DepthPyramid::Bind(uint32_t slot) const
+{
+    glBindTextureUnit(slot, m_RendererID);
+}
+
+void DepthPyramid::Resize(uint32_t width, uint32_t height)
+{
+    m_Width = width;
+    m_Height = height;
+    m_LevelCount = static_cast<uint32_t>(std::floor(std::log2(static_cast<float>(std::max(width, height))))) + 1;
+
+    glDeleteTextures(1, &m_RendererID);
+    glCreateTextures(GL_TEXTURE_2D, 1, &m_RendererID);
+    glTextureStorage2D(m_RendererID, static_cast<int32_t>(m_LevelCount), GL_R32F, static_cast<int32_t>(width), static_cast<int32_t>(height));
+    glTextureParameteri(m_RendererID, GL_TEXTURE_MIN_FILTER, GL_NEAREST_MIPMAP_NEAREST);
+    glTextureParameteri(m_RendererID, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    glTextureParameteri(m_RendererID, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTextureParameteri(m_RendererID, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+}
@@ -0,0 +1,36 @@
+#pragma once
+#include "Platform/OpenGL/Framebuffer.h"
+#include "Platform/OpenGL/Shader.h"
+
+// Hierarchical depth buffer: every mip stores the farthest depth of the 2x2 texels below it,
+// so one texel fetch bounds the depth of a whole screen region
+class DepthPyramid
+{
+public:
+    DepthPyramid();
+    ~DepthPyramid();
+
+    DepthPyramid(const DepthPyramid&) = delete;
+    DepthPyramid& operator=(const DepthPyramid&) = delete;
+
+    // Rebuilds all levels from the depth attachment of the framebuffer
+    void Build(const Ref<Framebuffer>& source);
+
+    void Bind(uint32_t slot) const;
+
+    uint32_t GetWidth() const { return m_Width; }
+    uint32_t GetHeight() const { return m_Height; }
+    uint32_t GetLevelCount() const { return m_LevelCount; }
+private:
+    void Resize(uint32_t width, uint32_t height);
+private:
+    uint32_t m_RendererID = 0;
+    uint32_t m_Width = 0, m_Height = 0;
+    uint32_t m_LevelCount = 0;
+
+    // Single-sampled copy of the source depth, multisampled depth can't be read by the reduction
+    Ref<Framebuffer> m_DepthFramebuffer;
+
+    Ref<Shader> m_CopyShader;
+    Ref<Shader> m_ReduceShader;
+};
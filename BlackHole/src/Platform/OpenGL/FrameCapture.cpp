@@ -0,0 +1,242 @@
+#include "bhpch.h"
+#include "Platform/OpenGL/FrameCapture.h"
+
+#include <glad/glad.h>
+
+#define STB_IMAGE_WRITE_IMPLEMENTATION
+#include <stb_image_write.h>
+
+static constexpr GLbitfield s_MappingFlags = GL_MAP_READ_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+static constexpr uint32_t s_BytesPerPixel = 4;
+
+namespace Utils
+{
+    // GL rows go bottom-up, image files top-down
+    static void FlipRows(std::vector<uint8_t>& pixels, uint32_t width, uint32_t height)
+    {
+        const size_t stride = static_cast<size_t>(width) * s_BytesPerPixel;
+        for (uint32_t top = 0, bottom = height - 1; top < bottom; ++top, --bottom)
+            std::swap_ranges(pixels.begin() + top * stride, pixels.begin() + (top + 1) * stride, pixels.begin() + bottom * stride);
+    }
+}
+
+FrameCapture::FrameCapture(const FrameCaptureSpecification& specification)
+    : m_Specification(specification)
+    , m_Slots(std::max(specification.ReadbackSlots, 1u))
+{
+    BH_PROFILE_FUNCTION();
+
+    if (m_Specification.Format == CaptureFormat::PNGSequence)
+    {
+        std::error_code error;
+        std::filesystem::create_directories(m_Specification.OutputPath, error);
+        if (error)
+            BH_LOG_ERROR("Could not create capture directory '{0}': {1}", m_Specification.OutputPath.string(), error.message());
+    }
+    else
+    {
+        m_VideoFile.open(m_Specification.OutputPath, std::ios::out | std::ios::binary | std::ios::trunc);
+        if (!m_VideoFile.is_open())
+            BH_LOG_ERROR("Could not open file '{0}'", m_Specification.OutputPath.string());
+    }
+
+    m_EncoderThread = std::thread(&FrameCapture::EncoderLoop, this);
+}
+
+FrameCapture::~FrameCapture()
+{
+    BH_PROFILE_FUNCTION();
+
+    CollectReadbacks(true);
+
+    {
+        std::lock_guard lock(m_Mutex);
+        m_Stopping = true;
+    }
+    m_FrameQueued.notify_one();
+    m_EncoderThread.join();
+
+    for (ReadbackSlot& slot : m_Slots)
+    {
+        if (slot.RendererID == 0)
+            continue;
+
+        glUnmapNamedBuffer(slot.RendererID);
+        glDeleteBuffers(1, &slot.RendererID);
+    }
+
+    if (m_Specification.Format == CaptureFormat::RawVideo && m_VideoSize.x != 0)
+    {
+        BH_LOG_INFO("Captured {0} frames to '{1}', convert with: ffmpeg -f rawvideo -pixel_format rgba -video_size {2}x{3} -framerate 60 -i {1} capture.mp4",
+            m_EncodedFrameCount.load(), m_Specification.OutputPath.string(), m_VideoSize.x, m_VideoSize.y);
+    }
+    else
+    {
+        BH_LOG_INFO("Captured {0} frames to '{1}'", m_EncodedFrameCount.load(), m_Specification.OutputPath.string());
+    }
+    if (GetDroppedFrameCount() != 0)
+        BH_LOG_WARN("Frame capture dropped {0} frames", GetDroppedFrameCount());
+}
+
+void FrameCapture::Capture(uint32_t textureID, uint32_t width, uint32_t height)
+{
+    BH_PROFILE_FUNCTION();
+
+    CollectReadbacks(false);
+
+    const uint64_t frameIndex = m_FrameIndex++;
+    if (width == 0 || height == 0)
+        return;
+
+    // Waiting here would stall on the GPU, so a frame without a free slot is skipped instead
+    ReadbackSlot& slot = m_Slots[m_NextSlot];
+    if (slot.Fence)
+    {
+        ++m_DroppedFrameCount;
+        return;
+    }
+    m_NextSlot = (m_NextSlot + 1) % static_cast<uint32_t>(m_Slots.size());
+
+    const uint64_t size = static_cast<uint64_t>(width) * height * s_BytesPerPixel;
+    if (size > slot.Capacity)
+        ResizeSlot(slot, size);
+
+    slot.Width = width;
+    slot.Height = height;
+    slot.FrameIndex = frameIndex;
+
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, slot.RendererID);
+    glPixelStorei(GL_PACK_ALIGNMENT, 1);
+    glGetTextureSubImage(textureID, 0, 0, 0, 0, static_cast<int32_t>(width), static_cast<int32_t>(height), 1,
+        GL_RGBA, GL_UNSIGNED_BYTE, static_cast<int32_t>(size), nullptr);
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+
+    glMemoryBarrier(GL_CLIENT_MAPPED_BUFFER_BARRIER_BIT);
+    slot.Fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    ++m_CapturedFrameCount;
+}
+
+void FrameCapture::Capture(const Ref<Framebuffer>& source)
+{
+    BH_ASSERT(source->GetSpecification().Samples == 1, "Capturing needs a resolved source!");
+
+    const glm::uvec2& renderArea = source->GetRenderArea();
+    Capture(source->GetColorAttachmentRendererID(), renderArea.x, renderArea.y);
+}
+
+void FrameCapture::CollectReadbacks(bool wait)
+{
+    // Oldest copy first, so frames reach the encoder in order
+    for (uint32_t i = 0; i < m_Slots.size(); ++i)
+    {
+        ReadbackSlot& slot = m_Slots[(m_NextSlot + i) % m_Slots.size()];
+        if (!slot.Fence)
+            continue;
+
+        GLenum result = glClientWaitSync(slot.Fence, GL_SYNC_FLUSH_COMMANDS_BIT, 0);
+        while (wait && result == GL_TIMEOUT_EXPIRED)
+            result = glClientWaitSync(slot.Fence, GL_SYNC_FLUSH_COMMANDS_BIT, 1'000'000);
+        if (result == GL_TIMEOUT_EXPIRED)
+            break;
+
+        BH_ASSERT(result != GL_WAIT_FAILED, "Failed to wait for frame capture fence!");
+        glDeleteSync(slot.Fence);
+        slot.Fence = nullptr;
+
+        EncodedFrame frame = { slot.FrameIndex, slot.Width, slot.Height };
+        {
+            std::lock_guard lock(m_Mutex);
+            if (m_Queue.size() >= m_Specification.MaxQueuedFrames)
+            {
+                ++m_EncoderDroppedFrameCount;
+                continue;
+            }
+
+            if (!m_FreePixels.empty())
+            {
+                frame.Pixels = std::move(m_FreePixels.back());
+                m_FreePixels.pop_back();
+            }
+        }
+
+        // Copied out under no lock, the encoder keeps working meanwhile
+        frame.Pixels.assign(slot.MappedData, slot.MappedData + static_cast<size_t>(slot.Width) * slot.Height * s_BytesPerPixel);
+        {
+            std::lock_guard lock(m_Mutex);
+            m_Queue.push_back(std::move(frame));
+        }
+        m_FrameQueued.notify_one();
+    }
+}
+
+void FrameCapture::ResizeSlot(ReadbackSlot& slot, uint64_t size)
+{
+    if (slot.RendererID != 0)
+    {
+        glUnmapNamedBuffer(slot.RendererID);
+        glDeleteBuffers(1, &slot.RendererID);
+    }
+
+    glCreateBuffers(1, &slot.RendererID);
+    glNamedBufferStorage(slot.RendererID, static_cast<int64_t>(size), nullptr, s_MappingFlags | GL_CLIENT_STORAGE_BIT);
+    slot.MappedData = static_cast<uint8_t*>(glMapNamedBufferRange(slot.RendererID, 0, static_cast<int64_t>(size), s_MappingFlags));
+    BH_ASSERT(slot.MappedData != nullptr, "Failed to map frame capture buffer!");
+    slot.Capacity = size;
+}
+
+void FrameCapture::EncoderLoop()
+{
+    std::vector<EncodedFrame> frames;
+    while (true)
+    {
+        {
+            std::unique_lock lock(m_Mutex);
+            m_FrameQueued.wait(lock, [this] { return m_Stopping || !m_Queue.empty(); });
+            if (m_Queue.empty())
+                return;
+
+            std::swap(frames, m_Queue);
+        }
+
+        for (EncodedFrame& frame : frames)
+            Encode(frame);
+
+        std::lock_guard lock(m_Mutex);
+        for (EncodedFrame& frame : frames)
+            m_FreePixels.push_back(std::move(frame.Pixels));
+        frames.clear();
+    }
+}
+
+void FrameCapture::Encode(EncodedFrame& frame)
+{
+    BH_PROFILE_FUNCTION();
+
+    Utils::FlipRows(frame.Pixels, frame.Width, frame.Height);
+
+    if (m_Specification.Format == CaptureFormat::PNGSequence)
+    {
+        const std::filesystem::path filepath = m_Specification.OutputPath / fmt::format("frame_{:06}.png", frame.FrameIndex);
+        const int32_t stride = static_cast<int32_t>(frame.Width * s_BytesPerPixel);
+        if (!stbi_write_png(filepath.string().c_str(), static_cast<int32_t>(frame.Width), static_cast<int32_t>(frame.Height), s_BytesPerPixel, frame.Pixels.data(), stride))
+        {
+            BH_LOG_ERROR("Could not write '{0}'", filepath.string());
+            return;
+        }
+        ++m_EncodedFrameCount;
+        return;
+    }
+
+    // Raw video has no per-frame header, every frame has to match the size of the first
+    if (m_VideoSize.x == 0)
+        m_VideoSize = { frame.Width, frame.Height };
+
+    if (frame.Width != m_VideoSize.x || frame.Height != m_VideoSize.y)
+    {
+        ++m_EncoderDroppedFrameCount;
+        return;
+    }
+
+    m_VideoFile.write(reinterpret_cast<const char*>(frame.Pixels.data()), static_cast<std::streamsize>(frame.Pixels.size()));
+    ++m_EncodedFrameCount;
+}
\ No newline at end of file
@@ -0,0 +1,99 @@
+#pragma once
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+#include "Platform/OpenGL/Framebuffer.h"
+
+typedef struct __GLsync* GLsync;
+
+enum class CaptureFormat
+{
+    // One PNG per frame in the output directory
+    PNGSequence,
+    // Top-down RGBA8 frames back to back in the output file, e.g. for ffmpeg -f rawvideo
+    RawVideo
+};
+
+struct FrameCaptureSpecification
+{
+    std::filesystem::path OutputPath;
+    CaptureFormat Format = CaptureFormat::PNGSequence;
+    // Copies in flight on the GPU, a frame is dropped when all of them are still busy
+    uint32_t ReadbackSlots = 3;
+    // Frames read back but not yet encoded, a frame is dropped when the encoder falls this far behind
+    uint32_t MaxQueuedFrames = 16;
+};
+
+// Records color output without stalling the render loop. Frames are copied into persistently
+// mapped pixel pack buffers, read once their fence has signaled a few frames later, and written
+// out by a background encoder thread
+class FrameCapture
+{
+public:
+    explicit FrameCapture(const FrameCaptureSpecification& specification);
+    // Waits for the copies in flight and everything queued to be written
+    ~FrameCapture();
+
+    FrameCapture(const FrameCapture&) = delete;
+    FrameCapture& operator=(const FrameCapture&) = delete;
+
+    // Once per frame. Queues a copy of the lower-left width by height pixels of an RGBA8 texture,
+    // and hands the copies that finished since to the encoder
+    void Capture(uint32_t textureID, uint32_t width, uint32_t height);
+    // Copies the render area of a single-sampled framebuffer
+    void Capture(const Ref<Framebuffer>& source);
+
+    uint64_t GetCapturedFrameCount() const { return m_CapturedFrameCount; }
+    uint64_t GetDroppedFrameCount() const { return m_DroppedFrameCount + m_EncoderDroppedFrameCount; }
+    uint64_t GetEncodedFrameCount() const { return m_EncodedFrameCount; }
+
+    const FrameCaptureSpecification& GetSpecification() const { return m_Specification; }
+private:
+    struct ReadbackSlot
+    {
+        uint32_t RendererID = 0;
+        uint8_t* MappedData = nullptr;
+        uint64_t Capacity = 0;
+        uint32_t Width = 0, Height = 0;
+        uint64_t FrameIndex = 0;
+        GLsync Fence = nullptr;
+    };
+
+    struct EncodedFrame
+    {
+        uint64_t FrameIndex = 0;
+        uint32_t Width = 0, Height = 0;
+        std::vector<uint8_t> Pixels;
+    };
+private:
+    // Reads back every slot whose copy finished, or waits for all of them
+    void CollectReadbacks(bool wait);
+    void ResizeSlot(ReadbackSlot& slot, uint64_t size);
+
+    void EncoderLoop();
+    void Encode(EncodedFrame& frame);
+private:
+    FrameCaptureSpecification m_Specification;
+
+    std::vector<ReadbackSlot> m_Slots;
+    uint32_t m_NextSlot = 0;
+    uint64_t m_FrameIndex = 0;
+    uint64_t m_CapturedFrameCount = 0;
+    uint64_t m_DroppedFrameCount = 0;
+
+    std::thread m_EncoderThread;
+    std::mutex m_Mutex;
+    std::condition_variable m_FrameQueued;
+    std::vector<EncodedFrame> m_Queue;
+    // Pixel storage of encoded frames, reused so capturing doesn't allocate every frame
+    std::vector<std::vector<uint8_t>> m_FreePixels;
+    bool m_Stopping = false;
+
+    std::atomic<uint64_t> m_EncodedFrameCount = 0;
+    std::atomic<uint64_t> m_EncoderDroppedFrameCount = 0;
+
+    // Encoder thread only
+    std::ofstream m_VideoFile;
+    glm::uvec2 m_VideoSize = { 0, 0 };
+};
\ No newline at end of file
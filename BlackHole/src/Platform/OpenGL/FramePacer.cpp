@@ -0,0 +1,98 @@
+#include "bhpch.h"
+#include "Platform/OpenGL/FramePacer.h"
+
+#include <glad/glad.h>
+#include <thread>
+
+#include "BlackHole/Core/Clock.h"
+
+FramePacer::FramePacer(const FramePacerSpecification& specification)
+    : m_Specification(specification)
+{
+}
+
+FramePacer::~FramePacer()
+{
+    for (const FrameInFlight& frame : m_FramesInFlight)
+        glDeleteSync(frame.Fence);
+}
+
+void FramePacer::BeginFrame()
+{
+    BH_PROFILE_FUNCTION();
+
+    const int64_t capWaitStart = Clock::Now();
+    if (m_Specification.MaxFrameRate > 0.0f)
+    {
+        const int64_t framePeriod = Clock::FromMilliseconds(1000.0 / m_Specification.MaxFrameRate);
+        // A frame that ran long moves the schedule instead of letting the next ones catch up in a burst
+        if (m_NextFrameTime < capWaitStart - framePeriod)
+            m_NextFrameTime = capWaitStart;
+
+        WaitUntil(m_NextFrameTime);
+        m_NextFrameTime += framePeriod;
+    }
+    else
+    {
+        m_NextFrameTime = capWaitStart;
+    }
+
+    const int64_t gpuWaitStart = Clock::Now();
+    // Frames finished by now only need their latency recorded
+    while (!m_FramesInFlight.empty() && RetireFrame(false)) {}
+    while (m_FramesInFlight.size() >= std::max(m_Specification.MaxFramesInFlight, 1u))
+        RetireFrame(true);
+    const int64_t gpuWaitEnd = Clock::Now();
+
+    m_Stats.FrameCapWaitTime = Clock::ToMilliseconds(gpuWaitStart - capWaitStart);
+    m_Stats.GPUWaitTime = Clock::ToMilliseconds(gpuWaitEnd - gpuWaitStart);
+}
+
+void FramePacer::EndFrame()
+{
+    m_FramesInFlight.push_back({ glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0), m_InputTime });
+}
+
+bool FramePacer::RetireFrame(bool wait)
+{
+    const FrameInFlight& frame = m_FramesInFlight.front();
+
+    GLenum result = glClientWaitSync(frame.Fence, GL_SYNC_FLUSH_COMMANDS_BIT, 0);
+    while (wait && result == GL_TIMEOUT_EXPIRED)
+        result = glClientWaitSync(frame.Fence, 0, 1'000'000);
+
+    if (result == GL_TIMEOUT_EXPIRED)
+        return false;
+
+    BH_ASSERT(result != GL_WAIT_FAILED, "Failed to wait for frame fence!");
+
+    // Seen signaled now, so without a wait this is an upper bound by however long ago it finished
+    if (frame.InputTime != 0)
+    {
+        m_LatencyHistory[m_LatencyHistoryIndex] = Clock::ToMilliseconds(Clock::Now() - frame.InputTime);
+        m_LatencyHistoryIndex = (m_LatencyHistoryIndex + 1) % s_LatencyHistorySize;
+        m_LatencyHistoryCount = std::min(m_LatencyHistoryCount + 1, s_LatencyHistorySize);
+
+        float sum = 0.0f;
+        for (uint32_t i = 0; i < m_LatencyHistoryCount; ++i)
+            sum += m_LatencyHistory[i];
+        m_Stats.InputLatency = sum / static_cast<float>(m_LatencyHistoryCount);
+    }
+
+    glDeleteSync(frame.Fence);
+    m_FramesInFlight.pop_front();
+    return true;
+}
+
+void FramePacer::WaitUntil(int64_t time) const
+{
+    BH_PROFILE_FUNCTION();
+
+    const int64_t spinThreshold = Clock::FromMilliseconds(m_Specification.SpinThreshold);
+    const int64_t remaining = time - Clock::Now();
+    if (remaining > spinThreshold)
+        std::this_thread::sleep_for(std::chrono::nanoseconds(remaining - spinThreshold));
+
+    while (Clock::Now() < time)
+        std::this_thread::yield();
+}
\ No newline at end of file
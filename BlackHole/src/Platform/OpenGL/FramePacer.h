@@ -0,0 +1,72 @@
+#pragma once
+#include <deque>
+
+typedef struct __GLsync* GLsync;
+
+struct FramePacerSpecification
+{
+    // Frames per second to stay under, 0 leaves the rate to vsync
+    float MaxFrameRate = 0.0f;
+    // Frames the GPU may still be working on when the next one starts. 1 gives the lowest latency
+    // but stops the CPU from recording while the GPU renders, 2 keeps them overlapped
+    uint32_t MaxFramesInFlight = 2;
+    // Waits sleep until this many milliseconds are left and spin the rest, sleeps overshoot by up to about that
+    float SpinThreshold = 1.5f;
+};
+
+// Paces frames on the CPU side. The driver may otherwise queue several frames behind vsync, and input
+// sampled for a frame waits for all of them, so a fence placed after every swap caps the frames in
+// flight and waiting on the fences measures when a frame has finished on the GPU
+class FramePacer
+{
+public:
+    struct Statistics
+    {
+        // Milliseconds from sampling input to the GPU finishing the frame that used it, averaged over the last frames
+        float InputLatency = 0.0f;
+        // Milliseconds spent in the last BeginFrame waiting for the cap and for the GPU
+        float FrameCapWaitTime = 0.0f;
+        float GPUWaitTime = 0.0f;
+    };
+public:
+    explicit FramePacer(const FramePacerSpecification& specification = FramePacerSpecification());
+    ~FramePacer();
+
+    FramePacer(const FramePacer&) = delete;
+    FramePacer& operator=(const FramePacer&) = delete;
+
+    // Waits for the frame cap and until fewer than MaxFramesInFlight frames are left on the GPU
+    void BeginFrame();
+    // Called right after input is sampled, in Clock time
+    void SetInputTime(int64_t time) { m_InputTime = time; }
+    // Called after the swap, fences everything submitted for the frame
+    void EndFrame();
+
+    FramePacerSpecification& GetSpecification() { return m_Specification; }
+    const FramePacerSpecification& GetSpecification() const { return m_Specification; }
+
+    const Statistics& GetStats() const { return m_Stats; }
+private:
+    // Retires the oldest frame, blocking until its fence signals or only when it already has
+    bool RetireFrame(bool wait);
+    void WaitUntil(int64_t time) const;
+private:
+    struct FrameInFlight
+    {
+        GLsync Fence = nullptr;
+        int64_t InputTime = 0;
+    };
+
+    FramePacerSpecification m_Specification;
+    std::deque<FrameInFlight> m_FramesInFlight;
+
+    int64_t m_NextFrameTime = 0;
+    int64_t m_InputTime = 0;
+
+    static constexpr uint32_t s_LatencyHistorySize = 64;
+    std::array<float, s_LatencyHistorySize> m_LatencyHistory = {};
+    uint32_t m_LatencyHistoryIndex = 0;
+    uint32_t m_LatencyHistoryCount = 0;
+
+    Statistics m_Stats;
+};
\ No newline at end of file
@@ -0,0 +1,98 @@
+#include "bhpch.h"
+#include "Platform/OpenGL/FrameRingBuffer.h"
+
+#include <glad/glad.h>
+
+static constexpr GLbitfield s_MappingFlags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+
+FrameRingBuffer::FrameRingBuffer(uint64_t frameSize, uint32_t framesInFlight)
+    : m_FramesInFlight(framesInFlight)
+    , m_Fences(framesInFlight, nullptr)
+{
+    GLint uniformAlignment = 0, storageAlignment = 0;
+    glGetIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &uniformAlignment);
+    glGetIntegerv(GL_SHADER_STORAGE_BUFFER_OFFSET_ALIGNMENT, &storageAlignment);
+    m_UniformAlignment = static_cast<uint64_t>(std::max(uniformAlignment, 1));
+    m_StorageAlignment = static_cast<uint64_t>(std::max(storageAlignment, 1));
+
+    // Keep every section start aligned for both kinds of bindings
+    const uint64_t sectionAlignment = std::max(m_UniformAlignment, m_StorageAlignment);
+    m_FrameSize = (frameSize + sectionAlignment - 1) / sectionAlignment * sectionAlignment;
+
+    const auto totalSize = static_cast<int64_t>(m_FrameSize * m_FramesInFlight);
+    glCreateBuffers(1, &m_RendererID);
+    glNamedBufferStorage(m_RendererID, totalSize, nullptr, s_MappingFlags);
+    m_MappedData = static_cast<uint8_t*>(glMapNamedBufferRange(m_RendererID, 0, totalSize, s_MappingFlags));
+    BH_ASSERT(m_MappedData != nullptr, "Failed to map frame ring buffer!");
+}
+
+FrameRingBuffer::~FrameRingBuffer()
+{
+    for (const GLsync fence : m_Fences)
+    {
+        if (fence)
+            glDeleteSync(fence);
+    }
+
+    glUnmapNamedBuffer(m_RendererID);
+    glDeleteBuffers(1, &m_RendererID);
+}
+
+void FrameRingBuffer::BeginFrame()
+{
+    BH_PROFILE_FUNCTION();
+
+    m_FrameIndex = (m_FrameIndex + 1) % m_FramesInFlight;
+    m_FrameOffset = 0;
+
+    GLsync& fence = m_Fences[m_FrameIndex];
+    if (!fence)
+        return;
+
+    // Normally signaled long ago, only blocks when the CPU is a full ring ahead of the GPU
+    GLenum result = glClientWaitSync(fence, 0, 0);
+    while (result == GL_TIMEOUT_EXPIRED)
+        result = glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, 1'000'000);
+
+    BH_ASSERT(result != GL_WAIT_FAILED, "Failed to wait for frame ring buffer fence!");
+
+    glDeleteSync(fence);
+    fence = nullptr;
+}
+
+void FrameRingBuffer::EndFrame()
+{
+    GLsync& fence = m_Fences[m_FrameIndex];
+    if (fence)
+        glDeleteSync(fence);
+
+    fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+}
+
+FrameAllocation FrameRingBuffer::Allocate(uint64_t size, uint64_t alignment)
+{
+    const uint64_t alignedOffset = (m_FrameOffset + alignment - 1) / alignment * alignment;
+    if (alignedOffset + size > m_FrameSize)
+    {
+        BH_LOG_ERROR("Frame ring buffer is out of memory ({0} of {1} bytes used, {2} requested)", m_FrameOffset, m_FrameSize, size);
+        return {};
+    }
+
+    m_FrameOffset = alignedOffset + size;
+
+    FrameAllocation allocation;
+    allocation.Offset = m_FrameIndex * m_FrameSize + alignedOffset;
+    allocation.Data = m_MappedData + allocation.Offset;
+    allocation.Size = size;
+    return allocation;
+}
+
+void FrameRingBuffer::BindUniformRange(uint32_t binding, const FrameAllocation& allocation) const
+{
+    glBindBufferRange(GL_UNIFORM_BUFFER, binding, m_RendererID, static_cast<int64_t>(allocation.Offset), static_cast<int64_t>(allocation.Size));
+}
+
+void FrameRingBuffer::BindStorageRange(uint32_t binding, const FrameAllocation& allocation) const
+{
+    glBindBufferRange(GL_SHADER_STORAGE_BUFFER, binding, m_RendererID, static_cast<int64_t>(allocation.Offset), static_cast<int64_t>(allocation.Size));
+}
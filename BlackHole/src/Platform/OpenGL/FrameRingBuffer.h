@@ -0,0 +1,51 @@
+#pragma once
+
+typedef struct __GLsync* GLsync;
+
+struct FrameAllocation
+{
+    void* Data = nullptr;
+    uint64_t Offset = 0;
+    uint64_t Size = 0;
+
+    explicit operator bool() const { return Data != nullptr; }
+};
+
+// Persistently mapped buffer split into one section per frame in flight.
+// A section is only rewritten after the fence placed when it was last used has signaled,
+// so per-frame data can be written from the CPU without racing the GPU.
+class FrameRingBuffer
+{
+public:
+    explicit FrameRingBuffer(uint64_t frameSize, uint32_t framesInFlight = 3);
+    ~FrameRingBuffer();
+
+    FrameRingBuffer(const FrameRingBuffer&) = delete;
+    FrameRingBuffer& operator=(const FrameRingBuffer&) = delete;
+
+    void BeginFrame();
+    void EndFrame();
+
+    FrameAllocation Allocate(uint64_t size, uint64_t alignment);
+    FrameAllocation AllocateUniform(uint64_t size) { return Allocate(size, m_UniformAlignment); }
+    FrameAllocation AllocateStorage(uint64_t size) { return Allocate(size, m_StorageAlignment); }
+
+    void BindUniformRange(uint32_t binding, const FrameAllocation& allocation) const;
+    void BindStorageRange(uint32_t binding, const FrameAllocation& allocation) const;
+
+    uint32_t GetRendererID() const { return m_RendererID; }
+    uint64_t GetFrameSize() const { return m_FrameSize; }
+private:
+    uint32_t m_RendererID = 0;
+    uint8_t* m_MappedData = nullptr;
+
+    uint64_t m_FrameSize;
+    uint32_t m_FramesInFlight;
+    uint32_t m_FrameIndex = 0;
+    uint64_t m_FrameOffset = 0;
+
+    uint64_t m_UniformAlignment = 256;
+    uint64_t m_StorageAlignment = 256;
+
+    std::vector<GLsync> m_Fences;
+};
@@ -27,17 +27,23 @@ namespace Utils
         }
     }
 
-    static void AttachDepthStencilRenderBuffer(uint32_t* depthStencilAttachmentID, FramebufferSpecification spec)
+    static void AttachDepthStencilTexture(uint32_t* depthStencilAttachmentID, FramebufferSpecification spec)
     {
-        glCreateRenderbuffers(1, depthStencilAttachmentID);
-
+        // A texture rather than a renderbuffer, so depth can be blitted out and sampled by later passes
         if (spec.Samples > 1)
         {
-            glNamedRenderbufferStorageMultisample(*depthStencilAttachmentID, spec.Samples, GL_DEPTH24_STENCIL8, static_cast<int32_t>(spec.Width), static_cast<int32_t>(spec.Height));
+            glCreateTextures(GL_TEXTURE_2D_MULTISAMPLE, 1, depthStencilAttachmentID);
+            glTextureStorage2DMultisample(*depthStencilAttachmentID, spec.Samples, GL_DEPTH24_STENCIL8, static_cast<int32_t>(spec.Width), static_cast<int32_t>(spec.Height), GL_TRUE);
         }
         else
         {
-            glNamedRenderbufferStorage(*depthStencilAttachmentID, GL_DEPTH24_STENCIL8, static_cast<int32_t>(spec.Width), static_cast<int32_t>(spec.Height));
+            glCreateTextures(GL_TEXTURE_2D, 1, depthStencilAttachmentID);
+            glTextureStorage2D(*depthStencilAttachmentID, 1, GL_DEPTH24_STENCIL8, static_cast<int32_t>(spec.Width), static_cast<int32_t>(spec.Height));
+
+            glTextureParameteri(*depthStencilAttachmentID, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+            glTextureParameteri(*depthStencilAttachmentID, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+            glTextureParameteri(*depthStencilAttachmentID, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+            glTextureParameteri(*depthStencilAttachmentID, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
         }
     }
 }
@@ -48,38 +54,70 @@ Framebuffer::Framebuffer(const FramebufferSpecification& specification)
     Invalidate();
 }
 
+Framebuffer::Framebuffer(const FramebufferSpecification& specification, uint32_t colorAttachment, uint32_t depthStencilAttachment)
+    : m_Specification(specification)
+    , m_DepthStencilAttachment(depthStencilAttachment)
+    , m_ColorAttachment(colorAttachment)
+    , m_OwnsAttachments(false)
+{
+    m_RenderArea = { m_Specification.Width, m_Specification.Height };
+    glCreateFramebuffers(1, &m_RendererID);
+
+    if (m_ColorAttachment)
+        glNamedFramebufferTexture(m_RendererID, GL_COLOR_ATTACHMENT0, m_ColorAttachment, 0);
+    else
+        glNamedFramebufferDrawBuffer(m_RendererID, GL_NONE);
+
+    if (m_DepthStencilAttachment)
+        glNamedFramebufferTexture(m_RendererID, GL_DEPTH_STENCIL_ATTACHMENT, m_DepthStencilAttachment, 0);
+
+    BH_ASSERT(glCheckNamedFramebufferStatus(m_RendererID, GL_FRAMEBUFFER) == GL_FRAMEBUFFER_COMPLETE, "Failed to complete Framebuffer!");
+}
+
 Framebuffer::~Framebuffer()
 {
     glDeleteFramebuffers(1, &m_RendererID);
-    glDeleteTextures(1, &m_ColorAttachment);
-    glDeleteRenderbuffers(1, &m_DepthStencilAttachment);
+    if (m_OwnsAttachments)
+    {
+        glDeleteTextures(1, &m_ColorAttachment);
+        glDeleteTextures(1, &m_DepthStencilAttachment);
+    }
 }
 
 void Framebuffer::Invalidate()
 {
+    BH_PROFILE_FUNCTION();
+
     if (m_RendererID)
     {
         glDeleteFramebuffers(1, &m_RendererID);
         glDeleteTextures(1, &m_ColorAttachment);
-        glDeleteRenderbuffers(1, &m_DepthStencilAttachment);
+        glDeleteTextures(1, &m_DepthStencilAttachment);
 
         m_ColorAttachment = 0;
         m_DepthStencilAttachment = 0;
     }
 
+    m_RenderArea = { m_Specification.Width, m_Specification.Height };
     glCreateFramebuffers(1, &m_RendererID);
 
     Utils::AttachColorTexture(&m_ColorAttachment, m_Specification);
     glNamedFramebufferTexture(m_RendererID, GL_COLOR_ATTACHMENT0, m_ColorAttachment, 0);
 
-    Utils::AttachDepthStencilRenderBuffer(&m_DepthStencilAttachment, m_Specification);
-    glNamedFramebufferRenderbuffer(m_RendererID, GL_DEPTH_STENCIL_ATTACHMENT, GL_RENDERBUFFER, m_DepthStencilAttachment);
+    Utils::AttachDepthStencilTexture(&m_DepthStencilAttachment, m_Specification);
+    glNamedFramebufferTexture(m_RendererID, GL_DEPTH_STENCIL_ATTACHMENT, m_DepthStencilAttachment, 0);
 
-    BH_ASSERT(glCheckFramebufferStatus(GL_FRAMEBUFFER) == GL_FRAMEBUFFER_COMPLETE, "Failed to complete Framebuffer!");
+    BH_ASSERT(glCheckNamedFramebufferStatus(m_RendererID, GL_FRAMEBUFFER) == GL_FRAMEBUFFER_COMPLETE, "Failed to complete Framebuffer!");
 }
 
 void Framebuffer::Resize(uint32_t width, uint32_t height)
 {
+    if (!m_OwnsAttachments)
+    {
+        BH_ASSERT(false, "Can't resize a framebuffer wrapping external attachments!");
+        return;
+    }
+
     if (width == 0 || height == 0 || width > s_MaxFramebufferSize || height > s_MaxFramebufferSize)
     {
         BH_LOG_WARN("Attempted to rezize framebuffer to {0}, {1}", width, height);
@@ -92,18 +130,32 @@ void Framebuffer::Resize(uint32_t width, uint32_t height)
     Invalidate();
 }
 
+void Framebuffer::SetRenderArea(uint32_t width, uint32_t height)
+{
+    m_RenderArea.x = std::clamp(width, 1u, m_Specification.Width);
+    m_RenderArea.y = std::clamp(height, 1u, m_Specification.Height);
+}
+
 void Framebuffer::BlitFramebuffer(const Ref<Framebuffer>& framebuffer) const
 {
     glBlitNamedFramebuffer(framebuffer->m_RendererID, m_RendererID,
-        0, 0, static_cast<int32_t>(framebuffer->m_Specification.Width), static_cast<int32_t>(framebuffer->m_Specification.Height),
-        0, 0, static_cast<int32_t>(m_Specification.Width), static_cast<int32_t>(m_Specification.Height),
+        0, 0, static_cast<int32_t>(framebuffer->m_RenderArea.x), static_cast<int32_t>(framebuffer->m_RenderArea.y),
+        0, 0, static_cast<int32_t>(m_RenderArea.x), static_cast<int32_t>(m_RenderArea.y),
         GL_COLOR_BUFFER_BIT, GL_LINEAR);
 }
 
+void Framebuffer::BlitDepthAttachment(const Ref<Framebuffer>& framebuffer) const
+{
+    glBlitNamedFramebuffer(framebuffer->m_RendererID, m_RendererID,
+        0, 0, static_cast<int32_t>(framebuffer->m_RenderArea.x), static_cast<int32_t>(framebuffer->m_RenderArea.y),
+        0, 0, static_cast<int32_t>(m_RenderArea.x), static_cast<int32_t>(m_RenderArea.y),
+        GL_DEPTH_BUFFER_BIT, GL_NEAREST);
+}
+
 void Framebuffer::Bind() const
 {
     glBindFramebuffer(GL_FRAMEBUFFER, m_RendererID);
-    glViewport(0, 0, static_cast<int32_t>(m_Specification.Width), static_cast<int32_t>(m_Specification.Height));
+    glViewport(0, 0, static_cast<int32_t>(m_RenderArea.x), static_cast<int32_t>(m_RenderArea.y));
 }
 
 void Framebuffer::Unbind()
@@ -131,6 +183,19 @@ void Framebuffer::ClearDepthStencilAttachment(float d, int32_t s) const
     glClearNamedFramebufferfi(m_RendererID, GL_DEPTH_STENCIL, 0, d, s);
 }
 
+void Framebuffer::DiscardAttachments(bool color, bool depthStencil) const
+{
+    std::array<uint32_t, 2> attachments;
+    int32_t attachmentCount = 0;
+    if (color && m_ColorAttachment)
+        attachments[attachmentCount++] = GL_COLOR_ATTACHMENT0;
+    if (depthStencil && m_DepthStencilAttachment)
+        attachments[attachmentCount++] = GL_DEPTH_STENCIL_ATTACHMENT;
+
+    if (attachmentCount)
+        glInvalidateNamedFramebufferData(m_RendererID, attachmentCount, attachments.data());
+}
+
 void Framebuffer::ClearDefaultFramebufferColorAttachment(const glm::vec4& color)
 {
     glClearNamedFramebufferfv(0, GL_COLOR, 0, glm::value_ptr(color));
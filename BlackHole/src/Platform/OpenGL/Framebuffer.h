@@ -1,4 +1,5 @@
 #pragma once
+#include <glm/vec2.hpp>
 #include <glm/vec4.hpp>
 
 struct FramebufferSpecification
@@ -11,6 +12,8 @@ class Framebuffer
 {
 public:
     Framebuffer(const FramebufferSpecification& specification);
+    // Wraps attachments owned by someone else, either may be 0; such framebuffers can't be resized
+    Framebuffer(const FramebufferSpecification& specification, uint32_t colorAttachment, uint32_t depthStencilAttachment);
     ~Framebuffer();
 
     void Bind() const;
@@ -21,12 +24,24 @@ public:
     void ClearStencilAttachment(int32_t value = 0.0f) const;
     void ClearDepthStencilAttachment(float d = 1.0f, int32_t s = 0.0f) const;
 
+    // Tells the driver the contents are dead, so they are neither resolved nor written back to memory
+    void DiscardAttachments(bool color, bool depthStencil) const;
+
     void Invalidate();
     void Resize(uint32_t width, uint32_t height);
 
+    // Rendering and blits only touch the lower-left corner of this size, so the resolution
+    // can change every frame without reallocating attachments. Resizing resets it to the full size
+    void SetRenderArea(uint32_t width, uint32_t height);
+    const glm::uvec2& GetRenderArea() const { return m_RenderArea; }
+
+    // Copies between the render areas of both framebuffers
     void BlitFramebuffer(const Ref<Framebuffer>& framebuffer) const;
+    // Resolves when the source is multisampled, render areas must match in that case
+    void BlitDepthAttachment(const Ref<Framebuffer>& framebuffer) const;
 
     uint32_t GetColorAttachmentRendererID() const { return m_ColorAttachment; }
+    uint32_t GetDepthAttachmentRendererID() const { return m_DepthStencilAttachment; }
     const FramebufferSpecification& GetSpecification() const { return m_Specification; }
 
     static void ClearDefaultFramebufferColorAttachment(const glm::vec4& color = glm::vec4(0.0f));
@@ -38,7 +53,10 @@ private:
     uint32_t m_RendererID = 0;
 
     FramebufferSpecification m_Specification;
-    
+    glm::uvec2 m_RenderArea = { 0, 0 };
+
     uint32_t m_DepthStencilAttachment = 0;
     uint32_t m_ColorAttachment = 0;
+
+    bool m_OwnsAttachments = true;
 };
\ No newline at end of file
@@ -0,0 +1,139 @@
+#include "bhpch.h"
+#include "Platform/OpenGL/GPUProfiler.h"
+
+#include "BlackHole/Core/Hash.h"
+
+#include "Platform/OpenGL/TimerQuery.h"
+
+#include <glad/glad.h>
+
+static constexpr uint32_t s_AverageFrameCount = 64;
+
+struct ProfilerScope
+{
+    std::string Name;
+    Scope<TimerQuery> Query;
+    uint32_t Depth = 0;
+
+    std::array<float, s_AverageFrameCount> History = {};
+    uint32_t HistoryIndex = 0;
+    uint32_t HistoryCount = 0;
+    // Frame of the last result folded into the history, a result is only counted once
+    uint64_t HistoryTag = UINT64_MAX;
+};
+
+struct GPUProfilerData
+{
+    std::vector<ProfilerScope> Scopes;
+    // Keyed by FNV-1a hash of the scope name
+    std::unordered_map<uint32_t, uint32_t> ScopeIndices;
+
+    std::vector<uint32_t> ScopeStack;
+    std::vector<uint32_t> FrameScopes;
+
+    std::vector<GPUProfiler::ScopeResult> Results;
+    uint64_t FrameIndex = 0;
+} static s_Data;
+
+void GPUProfiler::Shutdown()
+{
+    // Queries belong to the context, so they go before it does
+    s_Data = GPUProfilerData();
+}
+
+void GPUProfiler::BeginScope(std::string_view name)
+{
+    const uint32_t nameHash = Hash::FNV1a32(name);
+    auto [it, inserted] = s_Data.ScopeIndices.try_emplace(nameHash, static_cast<uint32_t>(s_Data.Scopes.size()));
+    if (inserted)
+    {
+        auto& scope = s_Data.Scopes.emplace_back();
+        scope.Name = name;
+        scope.Query = CreateScope<TimerQuery>();
+    }
+
+    const uint32_t scopeIndex = it->second;
+    auto& scope = s_Data.Scopes[scopeIndex];
+    scope.Depth = static_cast<uint32_t>(s_Data.ScopeStack.size());
+
+    s_Data.ScopeStack.push_back(scopeIndex);
+    s_Data.FrameScopes.push_back(scopeIndex);
+
+    glPushDebugGroup(GL_DEBUG_SOURCE_APPLICATION, nameHash, static_cast<int32_t>(name.size()), name.data());
+    scope.Query->Begin(s_Data.FrameIndex);
+}
+
+void GPUProfiler::EndScope()
+{
+    BH_ASSERT(!s_Data.ScopeStack.empty(), "GPU profiler scope ended without being begun!");
+
+    s_Data.Scopes[s_Data.ScopeStack.back()].Query->End();
+    s_Data.ScopeStack.pop_back();
+    glPopDebugGroup();
+}
+
+void GPUProfiler::EndFrame()
+{
+    BH_ASSERT(s_Data.ScopeStack.empty(), "GPU profiler scopes still open at the end of the frame!");
+
+    s_Data.Results.clear();
+    for (const uint32_t scopeIndex : s_Data.FrameScopes)
+    {
+        auto& scope = s_Data.Scopes[scopeIndex];
+
+        const float milliseconds = scope.Query->GetElapsedMilliseconds();
+        if (scope.Query->HasResult() && scope.Query->GetElapsedTag() != scope.HistoryTag)
+        {
+            scope.HistoryTag = scope.Query->GetElapsedTag();
+            scope.History[scope.HistoryIndex] = milliseconds;
+            scope.HistoryIndex = (scope.HistoryIndex + 1) % s_AverageFrameCount;
+            scope.HistoryCount = std::min(scope.HistoryCount + 1, s_AverageFrameCount);
+        }
+
+        float sum = 0.0f;
+        for (uint32_t i = 0; i < scope.HistoryCount; ++i)
+            sum += scope.History[i];
+
+        auto& result = s_Data.Results.emplace_back();
+        result.Name = scope.Name;
+        result.Depth = scope.Depth;
+        result.Milliseconds = milliseconds;
+        result.AverageMilliseconds = scope.HistoryCount ? sum / static_cast<float>(scope.HistoryCount) : 0.0f;
+    }
+    s_Data.FrameScopes.clear();
+    ++s_Data.FrameIndex;
+}
+
+float GPUProfiler::GetMilliseconds(std::string_view name)
+{
+    const auto it = s_Data.ScopeIndices.find(Hash::FNV1a32(name));
+    if (it == s_Data.ScopeIndices.end())
+        return 0.0f;
+
+    return s_Data.Scopes[it->second].Query->GetElapsedMilliseconds();
+}
+
+bool GPUProfiler::GetLatestResult(std::string_view name, float& milliseconds, uint64_t& frameIndex)
+{
+    const auto it = s_Data.ScopeIndices.find(Hash::FNV1a32(name));
+    if (it == s_Data.ScopeIndices.end())
+        return false;
+
+    const TimerQuery& query = *s_Data.Scopes[it->second].Query;
+    if (!query.HasResult())
+        return false;
+
+    milliseconds = query.GetElapsedMilliseconds();
+    frameIndex = query.GetElapsedTag();
+    return true;
+}
+
+uint64_t GPUProfiler::GetFrameIndex()
+{
+    return s_Data.FrameIndex;
+}
+
+const std::vector<GPUProfiler::ScopeResult>& GPUProfiler::GetResults()
+{
+    return s_Data.Results;
+}
\ No newline at end of file
@@ -0,0 +1,48 @@
+#pragma once
+
+// Named GPU timings for the passes of a frame. Each scope owns a ring of timestamp queries, so results
+// are read back a few frames late without stalling, and is wrapped in a debug group so frame captures
+// in external tools show the same names. A scope is expected to run at most once per frame
+class GPUProfiler
+{
+public:
+    struct ScopeResult
+    {
+        std::string Name;
+        // Nesting level, for indenting
+        uint32_t Depth = 0;
+        // Latest available measurement and its rolling average, in milliseconds
+        float Milliseconds = 0.0f;
+        float AverageMilliseconds = 0.0f;
+    };
+
+    static void Shutdown();
+
+    static void BeginScope(std::string_view name);
+    static void EndScope();
+
+    // Folds the results read back since the last frame into the averages of the scopes that ran this frame
+    static void EndFrame();
+
+    // Latest result of the scope, 0 until one is available
+    static float GetMilliseconds(std::string_view name);
+    // Latest result of the scope with the frame it was measured in, a few frames before the current one.
+    // False until one is available
+    static bool GetLatestResult(std::string_view name, float& milliseconds, uint64_t& frameIndex);
+    // Frames are counted by EndFrame, this is the one being recorded
+    static uint64_t GetFrameIndex();
+    // Scopes that ran in the last frame, in the order they began
+    static const std::vector<ScopeResult>& GetResults();
+};
+
+class GPUProfileScope
+{
+public:
+    explicit GPUProfileScope(std::string_view name) { GPUProfiler::BeginScope(name); }
+    ~GPUProfileScope() { GPUProfiler::EndScope(); }
+
+    GPUProfileScope(const GPUProfileScope&) = delete;
+    GPUProfileScope& operator=(const GPUProfileScope&) = delete;
+};
+
+#define BH_GPU_PROFILE_SCOPE(name) const GPUProfileScope BH_CONCAT(gpuProfileScope, __LINE__)(name)
\ No newline at end of file
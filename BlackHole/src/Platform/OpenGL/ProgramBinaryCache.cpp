@@ -0,0 +1,159 @@
+#include "bhpch.h"
+#include "Platform/OpenGL/ProgramBinaryCache.h"
+
+#include <glad/glad.h>
+
+#include "BlackHole/Core/Hash.h"
+
+static constexpr uint32_t s_FileMagic = 0x42504842; // "BHPB"
+// Bump when the file layout or the way sources are hashed changes
+static constexpr uint32_t s_FileVersion = 1;
+
+struct ProgramBinaryCacheData
+{
+    std::filesystem::path Directory;
+    uint64_t ContextHash = 0;
+    bool IsEnabled = false;
+} static s_Data;
+
+struct ProgramBinaryFileHeader
+{
+    uint32_t Magic;
+    uint32_t Version;
+    uint64_t ContextHash;
+    uint64_t SourceHash;
+    uint32_t BinaryFormat;
+    uint32_t BinarySize;
+    uint32_t UniformCount;
+    uint32_t Reserved;
+};
+
+namespace Utils
+{
+    static std::filesystem::path GetCacheFilePath(uint64_t sourceHash)
+    {
+        return s_Data.Directory / fmt::format("{:016x}.bin", sourceHash);
+    }
+}
+
+void ProgramBinaryCache::Init(const std::filesystem::path& directory, const ContextInfo& contextInfo)
+{
+    GLint formatCount = 0;
+    glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &formatCount);
+    if (formatCount == 0)
+    {
+        BH_LOG_WARN("Driver offers no program binary formats, shaders are compiled on every launch");
+        return;
+    }
+
+    std::error_code error;
+    std::filesystem::create_directories(directory, error);
+    if (error)
+    {
+        BH_LOG_WARN("Could not create program binary cache directory '{0}': {1}", directory.string(), error.message());
+        return;
+    }
+
+    s_Data.Directory = directory;
+    s_Data.ContextHash = Hash::FNV1a64(contextInfo.Version, Hash::FNV1a64(contextInfo.Renderer, Hash::FNV1a64(contextInfo.Vendor)));
+    s_Data.IsEnabled = true;
+}
+
+bool ProgramBinaryCache::IsEnabled()
+{
+    return s_Data.IsEnabled;
+}
+
+uint32_t ProgramBinaryCache::Load(uint64_t sourceHash, std::vector<UniformEntry>& uniforms)
+{
+    BH_PROFILE_FUNCTION();
+
+    if (!s_Data.IsEnabled)
+        return 0;
+
+    const std::filesystem::path filepath = Utils::GetCacheFilePath(sourceHash);
+    std::ifstream file(filepath, std::ios::in | std::ios::binary);
+    if (!file.is_open())
+        return 0;
+
+    ProgramBinaryFileHeader header = {};
+    file.read(reinterpret_cast<char*>(&header), sizeof(header));
+    if (!file || header.Magic != s_FileMagic || header.Version != s_FileVersion ||
+        header.ContextHash != s_Data.ContextHash || header.SourceHash != sourceHash)
+    {
+        return 0;
+    }
+
+    std::vector<UniformEntry> cachedUniforms(header.UniformCount);
+    std::vector<char> binary(header.BinarySize);
+    file.read(reinterpret_cast<char*>(cachedUniforms.data()), static_cast<std::streamsize>(cachedUniforms.size() * sizeof(UniformEntry)));
+    file.read(binary.data(), static_cast<std::streamsize>(binary.size()));
+    if (!file)
+        return 0;
+
+    const uint32_t programID = glCreateProgram();
+    glProgramParameteri(programID, GL_PROGRAM_SEPARABLE, GL_TRUE);
+    glProgramBinary(programID, header.BinaryFormat, binary.data(), static_cast<GLsizei>(binary.size()));
+
+    // Drivers may reject binaries they wrote themselves, after an update that kept the version string
+    GLint isLinked = GL_FALSE;
+    glGetProgramiv(programID, GL_LINK_STATUS, &isLinked);
+    if (isLinked == GL_FALSE)
+    {
+        glDeleteProgram(programID);
+        return 0;
+    }
+
+    uniforms = std::move(cachedUniforms);
+    return programID;
+}
+
+void ProgramBinaryCache::Save(uint64_t sourceHash, uint32_t programID, const std::vector<UniformEntry>& uniforms)
+{
+    BH_PROFILE_FUNCTION();
+
+    if (!s_Data.IsEnabled)
+        return;
+
+    GLint binarySize = 0;
+    glGetProgramiv(programID, GL_PROGRAM_BINARY_LENGTH, &binarySize);
+    if (binarySize <= 0)
+        return;
+
+    std::vector<char> binary(binarySize);
+    GLenum binaryFormat = GL_NONE;
+    glGetProgramBinary(programID, binarySize, &binarySize, &binaryFormat, binary.data());
+
+    ProgramBinaryFileHeader header = {};
+    header.Magic = s_FileMagic;
+    header.Version = s_FileVersion;
+    header.ContextHash = s_Data.ContextHash;
+    header.SourceHash = sourceHash;
+    header.BinaryFormat = binaryFormat;
+    header.BinarySize = static_cast<uint32_t>(binarySize);
+    header.UniformCount = static_cast<uint32_t>(uniforms.size());
+
+    // Written next to the entry and renamed over it, so a crash never leaves a torn file behind
+    const std::filesystem::path filepath = Utils::GetCacheFilePath(sourceHash);
+    std::filesystem::path temporaryPath = filepath;
+    temporaryPath += ".tmp";
+    {
+        std::ofstream file(temporaryPath, std::ios::out | std::ios::binary | std::ios::trunc);
+        if (!file.is_open())
+        {
+            BH_LOG_WARN("Could not write program binary '{0}'", temporaryPath.string());
+            return;
+        }
+
+        file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        file.write(reinterpret_cast<const char*>(uniforms.data()), static_cast<std::streamsize>(uniforms.size() * sizeof(UniformEntry)));
+        file.write(binary.data(), binarySize);
+        if (!file)
+            return;
+    }
+
+    std::error_code error;
+    std::filesystem::rename(temporaryPath, filepath, error);
+    if (error)
+        BH_LOG_WARN("Could not store program binary '{0}': {1}", filepath.string(), error.message());
+}
\ No newline at end of file
@@ -0,0 +1,29 @@
+#pragma once
+#include <filesystem>
+
+#include "Platform/OpenGL/Context.h"
+
+// Linked programs saved to disk with glGetProgramBinary, so later launches skip the GLSL compiler.
+// Entries are keyed by a hash of the source and are only used with the driver that wrote them,
+// binaries from another vendor, GPU or driver version are ignored and recompiled
+class ProgramBinaryCache
+{
+public:
+    // Reflected uniform of the cached program, so loading doesn't query them all again
+    struct UniformEntry
+    {
+        uint32_t NameHash;
+        int32_t Location;
+        int32_t Count;
+    };
+
+    static void Init(const std::filesystem::path& directory, const ContextInfo& contextInfo);
+
+    // False when the driver offers no binary formats
+    static bool IsEnabled();
+
+    // Creates a separable program from the cached binary, 0 on a miss or when the driver rejects it
+    static uint32_t Load(uint64_t sourceHash, std::vector<UniformEntry>& uniforms);
+    // The program should be linked with GL_PROGRAM_BINARY_RETRIEVABLE_HINT set
+    static void Save(uint64_t sourceHash, uint32_t programID, const std::vector<UniformEntry>& uniforms);
+};
\ No newline at end of file
@@ -4,34 +4,17 @@
 #include <glad/glad.h>
 #include <glm/gtc/type_ptr.hpp>
 
+#include "BlackHole/Core/VirtualFilesystem.h"
+
+#include "Platform/OpenGL/ProgramBinaryCache.h"
+#include "Platform/OpenGL/ShaderWatcher.h"
+
 namespace Utils
 {
     static std::string ReadFile(const std::string& filepath)
     {
-        std::ifstream shaderFile(filepath, std::ios::in | std::ios::binary);
-        std::string shaderSrc;
-
-        if (shaderFile.is_open())
-	    {
-		    shaderFile.seekg(0, std::ios::end);
-		    const size_t size = shaderFile.tellg();
-		    if (size != static_cast<size_t>(-1))
-		    {
-			    shaderSrc.resize(size);
-			    shaderFile.seekg(0, std::ios::beg);
-			    shaderFile.read(shaderSrc.data(), static_cast<std::streamsize>(size));
-		    }
-		    else
-		    {
-			    BH_LOG_ERROR("Could not read from file '{0}'", filepath);
-		    }
-	    }
-	    else
-	    {
-		    BH_LOG_ERROR("Could not open file '{0}'", filepath);
-	    }
-
-        return shaderSrc;
+        const FileData file = VirtualFilesystem::ReadFile(filepath);
+        return std::string(file.GetText());
     }
 
     static uint32_t ShaderTypeFromStringKeyword(const std::string& keyword)
@@ -42,6 +25,8 @@ namespace Utils
             return GL_FRAGMENT_SHADER;
         if (keyword == "geometry")
             return GL_GEOMETRY_SHADER;
+        if (keyword == "compute")
+            return GL_COMPUTE_SHADER;
 
         BH_ASSERT(false, "Unknown shader type keyword!");
         return 0;
@@ -54,43 +39,211 @@ namespace Utils
         case GL_VERTEX_SHADER: return GL_VERTEX_SHADER_BIT;
         case GL_FRAGMENT_SHADER: return GL_FRAGMENT_SHADER_BIT;
         case GL_GEOMETRY_SHADER: return GL_GEOMETRY_SHADER_BIT;
+        case GL_COMPUTE_SHADER: return GL_COMPUTE_SHADER_BIT;
         }
 
         BH_ASSERT(false, "Unknown Shader type!");
         return 0;
     }
+
+    // Identifies the stage's program in the binary cache
+    static uint64_t HashStageSource(uint32_t type, const std::string& source)
+    {
+        const uint64_t typeHash = Hash::FNV1a64(std::string_view(reinterpret_cast<const char*>(&type), sizeof(type)));
+        return Hash::FNV1a64(source, typeHash);
+    }
+
+    static const char* SpirvStageExtension(uint32_t type)
+    {
+        switch (type)
+        {
+        case GL_VERTEX_SHADER: return "vert";
+        case GL_FRAGMENT_SHADER: return "frag";
+        case GL_GEOMETRY_SHADER: return "geom";
+        case GL_COMPUTE_SHADER: return "comp";
+        }
+
+        BH_ASSERT(false, "Unknown Shader type!");
+        return "";
+    }
+
+    // SpecId decorations of the module, the driver rejects specializing constants the module doesn't declare
+    static std::vector<uint32_t> GetSpecializationConstantIDs(const std::string& spirv)
+    {
+        static constexpr uint32_t headerWordCount = 5;
+        static constexpr uint32_t opDecorate = 71;
+        static constexpr uint32_t decorationSpecId = 1;
+
+        std::vector<uint32_t> words(spirv.size() / sizeof(uint32_t));
+        std::memcpy(words.data(), spirv.data(), words.size() * sizeof(uint32_t));
+
+        std::vector<uint32_t> constantIDs;
+        for (size_t i = headerWordCount; i < words.size();)
+        {
+            const uint32_t wordCount = words[i] >> 16;
+            const uint32_t opcode = words[i] & 0xFFFF;
+            if (wordCount == 0 || i + wordCount > words.size())
+                break;
+
+            if (opcode == opDecorate && wordCount == 4 && words[i + 2] == decorationSpecId)
+                constantIDs.push_back(words[i + 3]);
+            i += wordCount;
+        }
+        return constantIDs;
+    }
+
+    // Some drivers don't reflect names from SPIR-V, uniforms couldn't be found by name then
+    static bool AreUniformNamesReflected(uint32_t program)
+    {
+        GLint uniformCount = 0;
+        glGetProgramiv(program, GL_ACTIVE_UNIFORMS, &uniformCount);
+        for (GLint i = 0; i < uniformCount; ++i)
+        {
+            GLint nameLength = 0;
+            const GLuint index = static_cast<GLuint>(i);
+            glGetActiveUniformsiv(program, 1, &index, GL_UNIFORM_NAME_LENGTH, &nameLength);
+            if (nameLength <= 1)
+                return false;
+        }
+        return true;
+    }
+
+    // Replaces #include "file" lines with the file, resolved relative to the including file.
+    // A file already included in this stage is skipped, which also breaks include cycles
+    static std::string ResolveIncludes(const std::string& source, const std::filesystem::path& filepath,
+        std::vector<std::filesystem::path>& includedPaths, uint32_t depth)
+    {
+        static constexpr std::string_view includeToken = "#include";
+        static constexpr uint32_t maxIncludeDepth = 16;
+
+        std::string result;
+        result.reserve(source.size());
+
+        size_t lineStart = 0;
+        uint32_t lineNumber = 1;
+        while (lineStart < source.size())
+        {
+            size_t lineEnd = source.find('\n', lineStart);
+            if (lineEnd == std::string::npos)
+                lineEnd = source.size();
+
+            const std::string_view line(source.data() + lineStart, lineEnd - lineStart);
+            const size_t firstChar = line.find_first_not_of(" \t");
+            if (firstChar == std::string_view::npos || !line.substr(firstChar).starts_with(includeToken))
+            {
+                result.append(line);
+                result += '\n';
+                lineStart = lineEnd + 1;
+                ++lineNumber;
+                continue;
+            }
+
+            const size_t nameBegin = line.find('"', firstChar + includeToken.size());
+            const size_t nameEnd = nameBegin == std::string_view::npos ? nameBegin : line.find('"', nameBegin + 1);
+            if (nameEnd == std::string_view::npos)
+            {
+                BH_LOG_ERROR("Malformed #include in '{0}' on line {1}", filepath.string(), lineNumber);
+                result += '\n';
+            }
+            else
+            {
+                const std::filesystem::path includePath = (filepath.parent_path() / line.substr(nameBegin + 1, nameEnd - nameBegin - 1)).lexically_normal();
+                const bool isIncluded = std::ranges::find(includedPaths, includePath) != includedPaths.end();
+                if (depth >= maxIncludeDepth)
+                {
+                    BH_LOG_ERROR("Includes nested too deep in '{0}'", filepath.string());
+                }
+                else if (!isIncluded)
+                {
+                    includedPaths.push_back(includePath);
+                    result += "#line 1\n";
+                    result += ResolveIncludes(ReadFile(includePath.string()), includePath, includedPaths, depth + 1);
+                }
+                result += "#line " + std::to_string(lineNumber + 1) + "\n";
+            }
+
+            lineStart = lineEnd + 1;
+            ++lineNumber;
+        }
+
+        return result;
+    }
+
+    static std::string GetInfoLog(uint32_t program, uint32_t shader)
+    {
+        // A stage that failed to compile leaves the more useful log on the shader
+        GLint isCompiled = GL_TRUE;
+        if (shader != 0)
+            glGetShaderiv(shader, GL_COMPILE_STATUS, &isCompiled);
+
+        GLint maxLength = 0;
+        if (isCompiled == GL_FALSE)
+            glGetShaderiv(shader, GL_INFO_LOG_LENGTH, &maxLength);
+        else
+            glGetProgramiv(program, GL_INFO_LOG_LENGTH, &maxLength);
+
+        std::vector<GLchar> infoLog(maxLength + 1, '\0');
+        if (isCompiled == GL_FALSE)
+            glGetShaderInfoLog(shader, maxLength, &maxLength, infoLog.data());
+        else
+            glGetProgramInfoLog(program, maxLength, &maxLength, infoLog.data());
+        return infoLog.data();
+    }
 }
 
-Shader::Shader(const std::filesystem::path& filepath)
+// GL_COMPLETION_STATUS_KHR from GL_KHR_parallel_shader_compile, the loader predates it
+static constexpr GLenum s_CompletionStatus = 0x91B1;
+static bool s_CompletionStatusSupported = false;
+static constexpr uint32_t s_SpirvMagicNumber = 0x07230203;
+static std::filesystem::path s_SpirvDirectory;
+
+Shader::Shader(const std::filesystem::path& filepath, std::vector<std::string> defines)
     : m_RendererID(0)
+    , m_Filepath(filepath)
 {
-    const std::string shaderFileSrc = Utils::ReadFile(filepath.string());
-    ProcessShaderFile(shaderFileSrc);
+    BH_PROFILE_FUNCTION();
 
-    CreateProgram();
+    m_Specification.Defines = std::move(defines);
 
     m_Name = filepath.filename().stem().string();
+
+    LoadSources();
+    BeginBuild();
+    const bool isBuilt = FinishBuild();
+    BH_ASSERT(isBuilt, "Failed to build shader!");
+
+    ShaderWatcher::Register(this);
 }
 
 Shader::Shader(std::string name, const ShaderSpecification& spec)
     : m_RendererID(0)
     , m_Name(std::move(name))
+    , m_Specification(spec)
 {
+    BH_PROFILE_FUNCTION();
+
     BH_ASSERT(spec.VertexPath.has_filename(), "Can't create shade without Vertex Shader!");
     BH_ASSERT(spec.FragmentPath.has_filename(), "Can't create shade without Fragment Shader!");
 
-    m_ShaderSourceCode[GL_VERTEX_SHADER]   = Utils::ReadFile(spec.VertexPath.string());
-    m_ShaderSourceCode[GL_FRAGMENT_SHADER] = Utils::ReadFile(spec.FragmentPath.string());
-
-    if (spec.GeometryPath.has_filename())
-        m_ShaderSourceCode[GL_GEOMETRY_SHADER] = Utils::ReadFile(spec.GeometryPath.string());
+    LoadSources();
+    BeginBuild();
+    if (!spec.BuildInBackground)
+    {
+        const bool isBuilt = FinishBuild();
+        BH_ASSERT(isBuilt, "Failed to build shader!");
+    }
 
-    CreateProgram();
+    ShaderWatcher::Register(this);
 }
 
 Shader::~Shader()
 {
+    ShaderWatcher::Unregister(this);
+    DeletePendingStages();
+
     glDeleteProgramPipelines(1, &m_RendererID);
+    for (const auto& [shaderType, programID] : m_ProgramIDs)
+        glDeleteProgram(programID);
 }
 
 void Shader::Bind() const
@@ -98,42 +251,300 @@ void Shader::Bind() const
     glBindProgramPipeline(m_RendererID);
 }
 
-void Shader::UploadInt(const std::string& name, int32_t value) const
+void Shader::Dispatch(uint32_t groupsX, uint32_t groupsY, uint32_t groupsZ) const
+{
+    BH_ASSERT(m_ProgramIDs.contains(GL_COMPUTE_SHADER), "Shader has no compute stage!");
+    glBindProgramPipeline(m_RendererID);
+    glDispatchCompute(groupsX, groupsY, groupsZ);
+}
+
+UniformHandle Shader::GetUniformHandle(const UniformName& name)
+{
+    for (uint32_t i = 0; i < m_UniformHandles.size(); ++i)
+    {
+        if (m_UniformHandles[i].NameHash == name.NameHash)
+            return { i };
+    }
+
+    const UniformInfo uniformInfo = GetUniformInfo(name);
+    if (uniformInfo.Location == -1)
+    {
+        BH_LOG_WARN("Uniform '{0}' is not active in shader '{1}'", name.Name, m_Name);
+        return {};
+    }
+
+    m_UniformHandles.push_back(uniformInfo);
+    m_UniformHandleNames.emplace_back(name.Name);
+    return { static_cast<uint32_t>(m_UniformHandles.size() - 1) };
+}
+
+void Shader::UploadInt(UniformHandle handle, int32_t value) const
 {
-    const auto& uniformInfo = GetUniformInfo(name);
+    BH_ASSERT(handle.IsValid(), "Invalid uniform handle!");
+    const auto& uniformInfo = m_UniformHandles[handle.Index];
     glProgramUniform1i(uniformInfo.ProgramID, uniformInfo.Location, value);
 }
 
-void Shader::UploadIntArray(const std::string& name, uint32_t count, const int32_t* values) const
+void Shader::UploadIntArray(UniformHandle handle, uint32_t count, const int32_t* values) const
 {
-    const auto& uniformInfo = GetUniformInfo(name);
-    glProgramUniform1iv(uniformInfo.ProgramID, uniformInfo.Location, count, values);
+    BH_ASSERT(handle.IsValid(), "Invalid uniform handle!");
+    const auto& uniformInfo = m_UniformHandles[handle.Index];
+    glProgramUniform1iv(uniformInfo.ProgramID, uniformInfo.Location, static_cast<int32_t>(count), values);
 }
 
-void Shader::UploadUint(const std::string& name, uint32_t value) const
+void Shader::UploadUint(UniformHandle handle, uint32_t value) const
 {
-    const auto& uniformInfo = GetUniformInfo(name);
+    BH_ASSERT(handle.IsValid(), "Invalid uniform handle!");
+    const auto& uniformInfo = m_UniformHandles[handle.Index];
     glProgramUniform1ui(uniformInfo.ProgramID, uniformInfo.Location, value);
 }
 
-void Shader::UploadFloat(const std::string& name, float value) const
+void Shader::UploadFloat(UniformHandle handle, float value) const
 {
-    const auto& uniformInfo = GetUniformInfo(name);
+    BH_ASSERT(handle.IsValid(), "Invalid uniform handle!");
+    const auto& uniformInfo = m_UniformHandles[handle.Index];
     glProgramUniform1f(uniformInfo.ProgramID, uniformInfo.Location, value);
 }
 
-void Shader::UploadFloat3(const std::string& name, const glm::vec3& vector) const
+void Shader::UploadFloat2(UniformHandle handle, const glm::vec2& vector) const
+{
+    BH_ASSERT(handle.IsValid(), "Invalid uniform handle!");
+    const auto& uniformInfo = m_UniformHandles[handle.Index];
+    glProgramUniform2f(uniformInfo.ProgramID, uniformInfo.Location, vector.x, vector.y);
+}
+
+void Shader::UploadFloat3(UniformHandle handle, const glm::vec3& vector) const
 {
-    const auto& uniformInfo = GetUniformInfo(name);
+    BH_ASSERT(handle.IsValid(), "Invalid uniform handle!");
+    const auto& uniformInfo = m_UniformHandles[handle.Index];
     glProgramUniform3f(uniformInfo.ProgramID, uniformInfo.Location, vector.x, vector.y, vector.z);
 }
 
-void Shader::UploadMat4(const std::string& name, const glm::mat4& matrix) const
+void Shader::UploadMat4(UniformHandle handle, const glm::mat4& matrix) const
 {
-    const auto& uniformInfo = GetUniformInfo(name);
+    BH_ASSERT(handle.IsValid(), "Invalid uniform handle!");
+    const auto& uniformInfo = m_UniformHandles[handle.Index];
     glProgramUniformMatrix4fv(uniformInfo.ProgramID, uniformInfo.Location, 1, GL_FALSE, glm::value_ptr(matrix));
 }
 
+void Shader::UploadInt(std::string_view name, int32_t value) const
+{
+    const auto& uniformInfo = GetUniformInfo(UniformName(name));
+    glProgramUniform1i(uniformInfo.ProgramID, uniformInfo.Location, value);
+}
+
+void Shader::UploadIntArray(std::string_view name, uint32_t count, const int32_t* values) const
+{
+    const auto& uniformInfo = GetUniformInfo(UniformName(name));
+    glProgramUniform1iv(uniformInfo.ProgramID, uniformInfo.Location, static_cast<int32_t>(count), values);
+}
+
+void Shader::UploadUint(std::string_view name, uint32_t value) const
+{
+    const auto& uniformInfo = GetUniformInfo(UniformName(name));
+    glProgramUniform1ui(uniformInfo.ProgramID, uniformInfo.Location, value);
+}
+
+void Shader::UploadFloat(std::string_view name, float value) const
+{
+    const auto& uniformInfo = GetUniformInfo(UniformName(name));
+    glProgramUniform1f(uniformInfo.ProgramID, uniformInfo.Location, value);
+}
+
+void Shader::UploadFloat2(std::string_view name, const glm::vec2& vector) const
+{
+    const auto& uniformInfo = GetUniformInfo(UniformName(name));
+    glProgramUniform2f(uniformInfo.ProgramID, uniformInfo.Location, vector.x, vector.y);
+}
+
+void Shader::UploadFloat3(std::string_view name, const glm::vec3& vector) const
+{
+    const auto& uniformInfo = GetUniformInfo(UniformName(name));
+    glProgramUniform3f(uniformInfo.ProgramID, uniformInfo.Location, vector.x, vector.y, vector.z);
+}
+
+void Shader::UploadMat4(std::string_view name, const glm::mat4& matrix) const
+{
+    const auto& uniformInfo = GetUniformInfo(UniformName(name));
+    glProgramUniformMatrix4fv(uniformInfo.ProgramID, uniformInfo.Location, 1, GL_FALSE, glm::value_ptr(matrix));
+}
+
+std::vector<std::filesystem::path> Shader::GetSourcePaths() const
+{
+    std::vector<std::filesystem::path> paths;
+    if (!m_Filepath.empty())
+    {
+        paths.push_back(m_Filepath);
+    }
+    else
+    {
+        paths.push_back(m_Specification.VertexPath);
+        paths.push_back(m_Specification.FragmentPath);
+        if (m_Specification.GeometryPath.has_filename())
+            paths.push_back(m_Specification.GeometryPath);
+    }
+
+    paths.insert(paths.end(), m_IncludedPaths.begin(), m_IncludedPaths.end());
+    return paths;
+}
+
+void Shader::Reload()
+{
+    BH_PROFILE_FUNCTION();
+
+    LoadSources();
+    BeginBuild();
+}
+
+bool Shader::UpdateReload(bool wait)
+{
+    if (m_PendingStages.empty() || (!wait && !IsBuildComplete()))
+        return false;
+
+    BH_PROFILE_FUNCTION();
+
+    const bool isFirstBuild = !IsReady();
+    if (!FinishBuild())
+        return false;
+
+    if (isFirstBuild)
+        BH_LOG_INFO("Built shader '{0}'", m_Name);
+    else
+        BH_LOG_INFO("Reloaded shader '{0}'", m_Name);
+    if (m_ReloadCallback)
+        m_ReloadCallback(*this);
+    return true;
+}
+
+void Shader::SetCompletionStatusSupported(bool supported)
+{
+    s_CompletionStatusSupported = supported;
+}
+
+void Shader::SetSpirvDirectory(std::filesystem::path directory)
+{
+    s_SpirvDirectory = std::move(directory);
+}
+
+void Shader::LoadSources()
+{
+    BH_PROFILE_FUNCTION();
+
+    m_ShaderSourceCode.clear();
+    m_IncludedPaths.clear();
+
+    if (!m_Filepath.empty())
+    {
+        ProcessShaderFile(Utils::ReadFile(m_Filepath.string()));
+        for (auto& [shaderType, shaderSource] : m_ShaderSourceCode)
+            PreprocessStage(shaderSource, m_Filepath);
+        LoadSpirv();
+        return;
+    }
+
+    const auto loadStage = [this](uint32_t shaderType, const std::filesystem::path& filepath)
+    {
+        std::string& source = m_ShaderSourceCode[shaderType];
+        source = Utils::ReadFile(filepath.string());
+        PreprocessStage(source, filepath);
+    };
+
+    loadStage(GL_VERTEX_SHADER, m_Specification.VertexPath);
+    loadStage(GL_FRAGMENT_SHADER, m_Specification.FragmentPath);
+
+    if (m_Specification.GeometryPath.has_filename())
+        loadStage(GL_GEOMETRY_SHADER, m_Specification.GeometryPath);
+
+    LoadSpirv();
+}
+
+void Shader::LoadSpirv()
+{
+    m_SpirvCode.clear();
+    if (s_SpirvDirectory.empty())
+        return;
+
+    // Modules older than any source or include would be missing the latest edits
+    std::filesystem::file_time_type sourceWriteTime;
+    for (const auto& path : GetSourcePaths())
+    {
+        std::error_code error;
+        sourceWriteTime = std::max(sourceWriteTime, VirtualFilesystem::GetLastWriteTime(path, error));
+    }
+
+    for (const auto& [shaderType, shaderSource] : m_ShaderSourceCode)
+    {
+        const std::filesystem::path spirvPath = s_SpirvDirectory / fmt::format("{0}.{1}.spv", GetStagePath(shaderType).filename().string(), Utils::SpirvStageExtension(shaderType));
+
+        std::error_code error;
+        const auto spirvWriteTime = VirtualFilesystem::GetLastWriteTime(spirvPath, error);
+        if (error || spirvWriteTime < sourceWriteTime)
+        {
+            m_SpirvCode.clear();
+            return;
+        }
+
+        std::string spirv = Utils::ReadFile(spirvPath.string());
+        uint32_t magicNumber = 0;
+        if (spirv.size() >= sizeof(magicNumber))
+            std::memcpy(&magicNumber, spirv.data(), sizeof(magicNumber));
+
+        if (magicNumber != s_SpirvMagicNumber || spirv.size() % sizeof(uint32_t) != 0)
+        {
+            BH_LOG_WARN("'{0}' is not a SPIR-V module, compiling shader '{1}' from GLSL", spirvPath.string(), m_Name);
+            m_SpirvCode.clear();
+            return;
+        }
+        m_SpirvCode[shaderType] = std::move(spirv);
+    }
+}
+
+const std::filesystem::path& Shader::GetStagePath(uint32_t shaderType) const
+{
+    if (!m_Filepath.empty())
+        return m_Filepath;
+
+    switch (shaderType)
+    {
+    case GL_VERTEX_SHADER: return m_Specification.VertexPath;
+    case GL_FRAGMENT_SHADER: return m_Specification.FragmentPath;
+    case GL_GEOMETRY_SHADER: return m_Specification.GeometryPath;
+    }
+
+    BH_ASSERT(false, "Unknown Shader type!");
+    return m_Filepath;
+}
+
+void Shader::PreprocessStage(std::string& source, const std::filesystem::path& filepath)
+{
+    std::vector<std::filesystem::path> stageIncludes;
+    source = Utils::ResolveIncludes(source, filepath, stageIncludes, 0);
+
+    for (auto& path : stageIncludes)
+    {
+        if (std::ranges::find(m_IncludedPaths, path) == m_IncludedPaths.end())
+            m_IncludedPaths.push_back(std::move(path));
+    }
+
+    if (m_Specification.Defines.empty())
+        return;
+
+    // #version has to stay the first statement, the defines go right after it
+    const size_t versionPos = source.find("#version");
+    const size_t insertPos = versionPos == std::string::npos ? 0 : source.find('\n', versionPos);
+
+    std::string defines = "\n";
+    for (const auto& define : m_Specification.Defines)
+        defines += "#define " + define + "\n";
+    // Keeps compiler messages on the line numbers of the file
+    defines += "#line 2\n";
+
+    if (insertPos == std::string::npos)
+        source += defines;
+    else
+        source.insert(insertPos, defines);
+}
+
 void Shader::ProcessShaderFile(const std::string& shaderSources)
 {
     const char* typeToken = "#type";
@@ -159,47 +570,211 @@ void Shader::ProcessShaderFile(const std::string& shaderSources)
     }
 }
 
-void Shader::CreateProgram()
+void Shader::BeginBuild()
 {
-    glCreateProgramPipelines(1, &m_RendererID);
+    BH_PROFILE_FUNCTION();
+
+    DeletePendingStages();
 
+    // Nothing in here asks for a status, so drivers with parallel compilation work on all stages at once
     for (const auto& [shaderType, shaderSource] : m_ShaderSourceCode)
     {
+        const auto spirvIt = m_SpirvCode.find(shaderType);
+
+        PendingStage& stage = m_PendingStages.emplace_back();
+        stage.Type = shaderType;
+        stage.IsSpirv = spirvIt != m_SpirvCode.end();
+        if (stage.IsSpirv)
+        {
+            const auto& constants = m_Specification.SpecializationConstants;
+            stage.SourceHash = Utils::HashStageSource(shaderType, spirvIt->second);
+            stage.SourceHash = Hash::FNV1a64({ reinterpret_cast<const char*>(constants.data()), constants.size() * sizeof(uint32_t) }, stage.SourceHash);
+        }
+        else
+        {
+            stage.SourceHash = Utils::HashStageSource(shaderType, shaderSource);
+        }
+
+        stage.ProgramID = ProgramBinaryCache::Load(stage.SourceHash, stage.CachedUniforms);
+        if (stage.ProgramID != 0)
+        {
+            stage.IsCached = true;
+            continue;
+        }
+
+        stage.ShaderID = glCreateShader(shaderType);
+        if (stage.IsSpirv)
+        {
+            const std::string& spirv = spirvIt->second;
+            glShaderBinary(1, &stage.ShaderID, GL_SHADER_BINARY_FORMAT_SPIR_V, spirv.data(), static_cast<GLsizei>(spirv.size()));
+
+            std::vector<uint32_t> constantIDs;
+            std::vector<uint32_t> constantValues;
+            for (const uint32_t constantID : Utils::GetSpecializationConstantIDs(spirv))
+            {
+                if (constantID >= m_Specification.SpecializationConstants.size())
+                    continue;
+                constantIDs.push_back(constantID);
+                constantValues.push_back(m_Specification.SpecializationConstants[constantID]);
+            }
+            glSpecializeShader(stage.ShaderID, "main", static_cast<GLuint>(constantIDs.size()), constantIDs.data(), constantValues.data());
+            continue;
+        }
+
         const GLchar* const source = shaderSource.data();
-        const uint32_t shaderProgram = glCreateShaderProgramv(shaderType, 1, &source);
+        const GLint sourceLength = static_cast<GLint>(shaderSource.size());
+        glShaderSource(stage.ShaderID, 1, &source, &sourceLength);
+        glCompileShader(stage.ShaderID);
+    }
+
+    // What glCreateShaderProgramv does, with the chance to ask for a retrievable binary before linking
+    for (PendingStage& stage : m_PendingStages)
+    {
+        if (stage.IsCached)
+            continue;
+
+        stage.ProgramID = glCreateProgram();
+        glProgramParameteri(stage.ProgramID, GL_PROGRAM_SEPARABLE, GL_TRUE);
+        if (ProgramBinaryCache::IsEnabled())
+            glProgramParameteri(stage.ProgramID, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+
+        glAttachShader(stage.ProgramID, stage.ShaderID);
+        glLinkProgram(stage.ProgramID);
+    }
+}
+
+bool Shader::IsBuildComplete() const
+{
+    if (!s_CompletionStatusSupported)
+        return true;
+
+    for (const PendingStage& stage : m_PendingStages)
+    {
+        GLint isComplete = GL_TRUE;
+        if (!stage.IsCached)
+            glGetProgramiv(stage.ProgramID, s_CompletionStatus, &isComplete);
+        if (isComplete == GL_FALSE)
+            return false;
+    }
+    return true;
+}
+
+bool Shader::FinishBuild()
+{
+    BH_PROFILE_FUNCTION();
+
+    for (const PendingStage& stage : m_PendingStages)
+    {
+        GLint isLinked = GL_TRUE;
+        if (!stage.IsCached)
+            glGetProgramiv(stage.ProgramID, GL_LINK_STATUS, &isLinked);
+
+        // A bad module or a driver that loses the uniform names shouldn't cost the shader, GLSL still works
+        if (stage.IsSpirv && !stage.IsCached && (isLinked == GL_FALSE || !Utils::AreUniformNamesReflected(stage.ProgramID)))
+        {
+            if (isLinked == GL_FALSE)
+            {
+                BH_LOG_WARN("Shader '{0}' failed to build from SPIR-V, compiling it from GLSL: {1}", m_Name, Utils::GetInfoLog(stage.ProgramID, stage.ShaderID));
+            }
+            else
+            {
+                BH_LOG_WARN("The driver doesn't reflect uniform names from SPIR-V, compiling shaders from GLSL");
+                s_SpirvDirectory.clear();
+            }
+
+            m_SpirvCode.clear();
+            BeginBuild();
+            return FinishBuild();
+        }
 
-        GLint isLinked = 0;
-        glGetProgramiv(shaderProgram, GL_LINK_STATUS, &isLinked);
         if (isLinked == GL_FALSE)
         {
-	        GLint maxLength = 0;
-	        glGetProgramiv(shaderProgram, GL_INFO_LOG_LENGTH, &maxLength);
+            BH_LOG_ERROR("Shader '{0}' failed to build: {1}", m_Name, Utils::GetInfoLog(stage.ProgramID, stage.ShaderID));
+            DeletePendingStages();
+            return false;
+        }
+    }
 
-	        std::vector<GLchar> infoLog(maxLength);
-	        glGetProgramInfoLog(shaderProgram, maxLength, &maxLength, infoLog.data());
+    // Everything linked, retire the old pipeline
+    glDeleteProgramPipelines(1, &m_RendererID);
+    for (const auto& [shaderType, programID] : m_ProgramIDs)
+        glDeleteProgram(programID);
 
-	        glDeleteProgram(shaderProgram);
+    m_ProgramIDs.clear();
+    m_UniformLocationCache.clear();
+    glCreateProgramPipelines(1, &m_RendererID);
 
-            BH_ASSERT(false, std::string("Shader link error: ") + infoLog.data());
-	        return;
+    for (PendingStage& stage : m_PendingStages)
+    {
+        if (stage.ShaderID != 0)
+        {
+            glDetachShader(stage.ProgramID, stage.ShaderID);
+            glDeleteShader(stage.ShaderID);
         }
 
-        m_ProgramIDs[shaderType] = shaderProgram;
+        m_ProgramIDs[stage.Type] = stage.ProgramID;
+        glUseProgramStages(m_RendererID, Utils::ShaderStageFromShaderType(stage.Type), stage.ProgramID);
 
-        CollectUniformLocations(shaderProgram);
+        if (stage.IsCached)
+        {
+            for (const auto& uniform : stage.CachedUniforms)
+                m_UniformLocationCache.emplace(uniform.NameHash, UniformInfo{ uniform.NameHash, stage.ProgramID, uniform.Location, uniform.Count });
+            continue;
+        }
 
-        glUseProgramStages(m_RendererID, Utils::ShaderStageFromShaderType(shaderType), shaderProgram);
+        CollectUniformLocations(stage.ProgramID);
+
+        std::vector<ProgramBinaryCache::UniformEntry> uniforms;
+        for (const auto& [nameHash, uniformInfo] : m_UniformLocationCache)
+        {
+            if (uniformInfo.ProgramID == stage.ProgramID)
+                uniforms.push_back({ nameHash, uniformInfo.Location, uniformInfo.Count });
+        }
+        ProgramBinaryCache::Save(stage.SourceHash, stage.ProgramID, uniforms);
     }
+    m_PendingStages.clear();
+
+    // Handles stay valid across reloads, a uniform the new sources dropped turns into a no-op
+    for (size_t i = 0; i < m_UniformHandles.size(); ++i)
+    {
+        UniformInfo uniformInfo = GetUniformInfo(UniformName(m_UniformHandleNames[i]));
+        if (uniformInfo.Location == -1)
+        {
+            BH_LOG_WARN("Uniform '{0}' is no longer active in shader '{1}'", m_UniformHandleNames[i], m_Name);
+            uniformInfo.ProgramID = m_ProgramIDs.begin()->second;
+        }
+        m_UniformHandles[i] = uniformInfo;
+    }
+
+    return true;
 }
 
-Shader::UniformInfo Shader::GetUniformInfo(const std::string& name) const
+void Shader::DeletePendingStages()
 {
-    const auto& it = m_UniformLocationCache.find(name);
+    for (const PendingStage& stage : m_PendingStages)
+    {
+        glDeleteProgram(stage.ProgramID);
+        glDeleteShader(stage.ShaderID);
+    }
+    m_PendingStages.clear();
+}
+
+Shader::UniformInfo Shader::GetUniformInfo(const UniformName& name) const
+{
+    const auto& it = m_UniformLocationCache.find(name.NameHash);
     if (it != m_UniformLocationCache.end())
-        return  it->second;
-    
-    const GLint location = glGetUniformLocation(m_ProgramIDs.at(GL_VERTEX_SHADER), name.data());
-    return m_UniformLocationCache[name] = { m_ProgramIDs.at(GL_VERTEX_SHADER), location, 0 };
+        return it->second;
+
+    // Not reflected as active, so look it up in every stage, not just the vertex one
+    const std::string nullTerminatedName(name.Name);
+    for (const auto& [shaderType, programID] : m_ProgramIDs)
+    {
+        const GLint location = glGetUniformLocation(programID, nullTerminatedName.c_str());
+        if (location != -1)
+            return m_UniformLocationCache[name.NameHash] = { name.NameHash, programID, location, 1 };
+    }
+
+    return m_UniformLocationCache[name.NameHash] = { name.NameHash, 0, -1, 0 };
 }
 
 void Shader::CollectUniformLocations(uint32_t programID) const
@@ -223,11 +798,12 @@ void Shader::CollectUniformLocations(uint32_t programID) const
 		    glGetActiveUniform(programID, i, maxNameLength, &length, &count, &type, uniformName);
 
             UniformInfo uniformInfo = {};
+            uniformInfo.NameHash = Hash::FNV1a32(uniformName);
             uniformInfo.ProgramID = programID;
             uniformInfo.Location = glGetUniformLocation(programID, uniformName);
             uniformInfo.Count = count;
 
-		    m_UniformLocationCache.emplace(std::make_pair(std::string(uniformName), uniformInfo));
+		    m_UniformLocationCache.emplace(uniformInfo.NameHash, uniformInfo);
 	    }
 
         delete[] uniformName;
@@ -1,51 +1,163 @@
 #pragma once
+#include <glm/vec2.hpp>
 #include <glm/vec3.hpp>
 #include <glm/mat4x4.hpp>
 
+#include "BlackHole/Core/Hash.h"
+#include "Platform/OpenGL/ProgramBinaryCache.h"
+
 struct ShaderSpecification
 {
     std::filesystem::path VertexPath = "";
     std::filesystem::path FragmentPath = "";
     std::filesystem::path GeometryPath = "";
+
+    // Inserted as "#define <entry>" after the #version line of every stage, e.g. "FEATURE_SHADOWS 1"
+    std::vector<std::string> Defines;
+    // Values by constant_id, for stages loaded from SPIR-V where the defines were fixed at build time
+    std::vector<uint32_t> SpecializationConstants;
+
+    // The constructor returns with the build in flight, and the shader can be used once IsReady.
+    // Finished like a reload, by UpdateReload
+    bool BuildInBackground = false;
+};
+
+// Uniform name with its hash; string literals are hashed at compile time
+struct UniformName
+{
+    template <size_t N>
+    consteval UniformName(const char (&name)[N])
+        : Name(name, N - 1), NameHash(Hash::FNV1a32(std::string_view(name, N - 1))) {}
+
+    explicit constexpr UniformName(std::string_view name)
+        : Name(name), NameHash(Hash::FNV1a32(name)) {}
+
+    std::string_view Name;
+    uint32_t NameHash;
+};
+
+// Index into the shader's table of resolved uniforms, valid for the lifetime of the shader
+struct UniformHandle
+{
+    static constexpr uint32_t InvalidIndex = ~0u;
+
+    uint32_t Index = InvalidIndex;
+
+    bool IsValid() const { return Index != InvalidIndex; }
 };
 
 class Shader
 {
 public:
-    explicit Shader(const std::filesystem::path& filepath);
+    // Stage sources may #include "file" relative to the including file, each file is included once
+    explicit Shader(const std::filesystem::path& filepath, std::vector<std::string> defines = {});
     explicit Shader(std::string name, const ShaderSpecification& spec);
     ~Shader();
 
     void Bind() const;
+    // For shaders with a compute stage
+    void Dispatch(uint32_t groupsX, uint32_t groupsY = 1, uint32_t groupsZ = 1) const;
+
+    UniformHandle GetUniformHandle(const UniformName& name);
+
+    void UploadInt(UniformHandle handle, int32_t value) const;
+    void UploadIntArray(UniformHandle handle, uint32_t count, const int32_t* values) const;
+    void UploadUint(UniformHandle handle, uint32_t value) const;
+    void UploadFloat(UniformHandle handle, float value) const;
+    void UploadFloat2(UniformHandle handle, const glm::vec2& vector) const;
+    void UploadFloat3(UniformHandle handle, const glm::vec3& vector) const;
+    void UploadMat4(UniformHandle handle, const glm::mat4& matrix) const;
 
-    void UploadInt(const std::string& name, int32_t value) const;
-    void UploadIntArray(const std::string& name, uint32_t count, const int32_t* values) const;
-    void UploadUint(const std::string& name, uint32_t value) const;
-    void UploadFloat(const std::string& name, float value) const;
-    void UploadFloat3(const std::string& name, const glm::vec3& vector) const;
-    void UploadMat4(const std::string& name, const glm::mat4& matrix) const;
+    void UploadInt(std::string_view name, int32_t value) const;
+    void UploadIntArray(std::string_view name, uint32_t count, const int32_t* values) const;
+    void UploadUint(std::string_view name, uint32_t value) const;
+    void UploadFloat(std::string_view name, float value) const;
+    void UploadFloat2(std::string_view name, const glm::vec2& vector) const;
+    void UploadFloat3(std::string_view name, const glm::vec3& vector) const;
+    void UploadMat4(std::string_view name, const glm::mat4& matrix) const;
 
     const std::string& GetName() const { return m_Name; }
+
+    // Files the stages are read from, includes too, for watching them
+    std::vector<std::filesystem::path> GetSourcePaths() const;
+
+    // Starts compiling the current sources in the background, the pipeline in use keeps
+    // rendering until UpdateReload swaps the new one in. A reload still in flight is dropped
+    void Reload();
+    // Swaps the reloaded pipeline in once the driver is done, or right away waiting for it, true when it did.
+    // A reload that fails to compile is logged and the old pipeline stays
+    bool UpdateReload(bool wait = false);
+    bool IsReloading() const { return !m_PendingStages.empty(); }
+    // False until a shader built in the background has its first pipeline, or forever if that failed to build
+    bool IsReady() const { return m_RendererID != 0; }
+    // Called once a pipeline built in the background is swapped in, after a reload or a first build.
+    // Its programs start with every uniform zeroed, so whatever was uploaded once rather than every frame
+    // has to be uploaded again here
+    void SetReloadCallback(std::function<void(Shader&)> callback) { m_ReloadCallback = std::move(callback); }
+
+    // Set by the context when the driver can report compile completion without blocking,
+    // otherwise reloads finish on the first UpdateReload
+    static void SetCompletionStatusSupported(bool supported);
+    // Directory with the SPIR-V modules built from the shader sources, loaded instead of the GLSL
+    // when they're newer than it. Empty when the driver can't ingest SPIR-V
+    static void SetSpirvDirectory(std::filesystem::path directory);
 private:
     struct UniformInfo
     {
+        uint32_t NameHash;
         uint32_t ProgramID;
         int32_t Location;
         int32_t Count;
     };
+
+    // Stage of a build in flight, cached stages are linked already
+    struct PendingStage
+    {
+        uint32_t Type = 0;
+        uint64_t SourceHash = 0;
+        uint32_t ShaderID = 0;
+        uint32_t ProgramID = 0;
+        bool IsCached = false;
+        bool IsSpirv = false;
+        std::vector<ProgramBinaryCache::UniformEntry> CachedUniforms;
+    };
 private:
+    void LoadSources();
     void ProcessShaderFile(const std::string& shaderSources);
-    void CreateProgram();
+    // Resolves includes and adds the defines
+    void PreprocessStage(std::string& source, const std::filesystem::path& filepath);
+    // Picks up up to date SPIR-V for every stage, or for none of them
+    void LoadSpirv();
+    const std::filesystem::path& GetStagePath(uint32_t shaderType) const;
 
-    UniformInfo GetUniformInfo(const std::string& name) const;
+    // Issues compiles and links for every stage at once, without waiting on any of them
+    void BeginBuild();
+    bool IsBuildComplete() const;
+    // Waits for whatever is still compiling and replaces the pipeline on success
+    bool FinishBuild();
+    void DeletePendingStages();
+
+    UniformInfo GetUniformInfo(const UniformName& name) const;
     void CollectUniformLocations(uint32_t programID) const;
 private:
     uint32_t m_RendererID;
     std::string m_Name;
 
+    std::filesystem::path m_Filepath;
+    ShaderSpecification m_Specification;
+    std::vector<std::filesystem::path> m_IncludedPaths;
+
     std::unordered_map<uint32_t, uint32_t> m_ProgramIDs;
     std::unordered_map<uint32_t, std::string> m_ShaderSourceCode;
-    mutable std::unordered_map<std::string, UniformInfo> m_UniformLocationCache;
+    std::unordered_map<uint32_t, std::string> m_SpirvCode;
+    std::vector<PendingStage> m_PendingStages;
+    // Keyed by FNV-1a hash of the uniform name
+    mutable std::unordered_map<uint32_t, UniformInfo> m_UniformLocationCache;
+    std::vector<UniformInfo> m_UniformHandles;
+    // Kept to resolve the handles again after a reload
+    std::vector<std::string> m_UniformHandleNames;
+
+    std::function<void(Shader&)> m_ReloadCallback;
 };
 
 class ShaderLibrary
@@ -0,0 +1,98 @@
+#include "bhpch.h"
+#include "Platform/OpenGL/ShaderVariants.h"
+
+#include <bit>
+
+ShaderVariants::ShaderVariants(std::string name, const ShaderSpecification& spec, std::vector<std::string> features)
+    : m_Name(std::move(name))
+    , m_Specification(spec)
+    , m_Features(std::move(features))
+{
+    BH_ASSERT(m_Features.size() <= 32, "Variant keys have room for 32 features!");
+}
+
+const Ref<Shader>& ShaderVariants::Get(uint32_t key)
+{
+    if (const auto it = m_Variants.find(key); it != m_Variants.end())
+    {
+        // Requested in the background before, the caller can't go on without it
+        if (it->second->IsReloading() && !it->second->IsReady())
+            it->second->UpdateReload(true);
+        return it->second;
+    }
+
+    return m_Variants[key] = CreateVariant(key, false);
+}
+
+Shader* ShaderVariants::GetReadyOrClosest(uint32_t key)
+{
+    if (const auto it = m_Variants.find(key); it == m_Variants.end())
+    {
+        m_Variants[key] = CreateVariant(key, true);
+        m_PendingKeys.push_back(key);
+    }
+    else if (it->second->IsReady())
+    {
+        return it->second.get();
+    }
+
+    // Only variants without extra features stand in, an extra one may read resources that aren't bound.
+    // Missing features render less than asked for, so the one missing the fewest is closest
+    Shader* closest = nullptr;
+    int closestFeatureCount = -1;
+    for (const auto& [variantKey, shader] : m_Variants)
+    {
+        if ((variantKey & ~key) != 0 || !shader->IsReady())
+            continue;
+
+        const int featureCount = std::popcount(variantKey);
+        if (featureCount > closestFeatureCount)
+        {
+            closest = shader.get();
+            closestFeatureCount = featureCount;
+        }
+    }
+    return closest;
+}
+
+void ShaderVariants::Update()
+{
+    // A variant that failed to build stops pending, its sources being edited restarts it like any reload
+    std::erase_if(m_PendingKeys, [this](uint32_t key)
+    {
+        Shader& shader = *m_Variants.at(key);
+        shader.UpdateReload();
+        return !shader.IsReloading();
+    });
+}
+
+void ShaderVariants::SetReloadCallback(std::function<void(Shader&)> callback)
+{
+    m_ReloadCallback = std::move(callback);
+    for (const auto& [key, shader] : m_Variants)
+        shader->SetReloadCallback(m_ReloadCallback);
+}
+
+Ref<Shader> ShaderVariants::CreateVariant(uint32_t key, bool buildInBackground)
+{
+    BH_PROFILE_FUNCTION();
+
+    ShaderSpecification spec = m_Specification;
+    spec.BuildInBackground = buildInBackground;
+
+    std::string enabledFeatures;
+    for (uint32_t index = 0; index < m_Features.size(); ++index)
+    {
+        const bool isEnabled = key & BIT(index);
+        spec.Defines.push_back(m_Features[index] + (isEnabled ? " true" : " false"));
+        spec.SpecializationConstants.push_back(isEnabled ? 1 : 0);
+
+        if (isEnabled)
+            enabledFeatures += enabledFeatures.empty() ? m_Features[index] : ", " + m_Features[index];
+    }
+
+    BH_LOG_INFO("Compiling variant [{0}] of shader '{1}'", enabledFeatures, m_Name);
+    Ref<Shader> shader = CreateRef<Shader>(fmt::format("{0}[{1}]", m_Name, enabledFeatures), spec);
+    shader->SetReloadCallback(m_ReloadCallback);
+    return shader;
+}
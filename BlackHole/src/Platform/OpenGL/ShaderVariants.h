@@ -0,0 +1,50 @@
+#pragma once
+#include "Platform/OpenGL/Shader.h"
+
+// Permutations of one shader, specialized at compile time by features.
+// Each feature is a bit of the variant key and becomes "#define <feature> true" or "false" for GLSL,
+// or the specialization constant with the feature's index as constant_id for SPIR-V.
+// Either way the value is constant, so every variant runs without the branches of the others
+class ShaderVariants
+{
+public:
+    ShaderVariants(std::string name, const ShaderSpecification& spec, std::vector<std::string> features);
+
+    // Compiles the variant on first use and waits for it, later calls return the cached one
+    const Ref<Shader>& Get(uint32_t key);
+    // Never waits: a variant used for the first time starts building in the background, and until it's
+    // ready the ready variant with the most of its features and no others stands in. Null when not even
+    // the variant without features is ready
+    Shader* GetReadyOrClosest(uint32_t key);
+    bool Contains(uint32_t key) const { return m_Variants.contains(key); }
+
+    // Once per frame, swaps in the variants that finished building in the background
+    void Update();
+
+    // Set on every variant, the compiled ones and those compiled later
+    void SetReloadCallback(std::function<void(Shader&)> callback);
+
+    // Variants still building in the background are skipped
+    template <typename Function>
+    void ForEach(Function&& function) const
+    {
+        for (const auto& [key, shader] : m_Variants)
+        {
+            if (shader->IsReady())
+                function(key, shader);
+        }
+    }
+
+    uint32_t GetVariantCount() const { return static_cast<uint32_t>(m_Variants.size()); }
+    const std::string& GetName() const { return m_Name; }
+private:
+    Ref<Shader> CreateVariant(uint32_t key, bool buildInBackground);
+private:
+    std::string m_Name;
+    ShaderSpecification m_Specification;
+    std::vector<std::string> m_Features;
+
+    std::unordered_map<uint32_t, Ref<Shader>> m_Variants;
+    std::vector<uint32_t> m_PendingKeys;
+    std::function<void(Shader&)> m_ReloadCallback;
+};
@@ -0,0 +1,66 @@
+#include "bhpch.h"
+#include "Platform/OpenGL/ShaderWatcher.h"
+
+#include "BlackHole/Core/Timer.h"
+#include "Platform/OpenGL/Shader.h"
+
+// Seconds between checks of the source files' write times
+static constexpr float s_CheckInterval = 0.5f;
+
+struct ShaderWatcherData
+{
+    std::unordered_map<Shader*, std::vector<std::filesystem::file_time_type>> WriteTimes;
+    Timer CheckTimer;
+} static s_Data;
+
+namespace Utils
+{
+    static std::vector<std::filesystem::file_time_type> GetWriteTimes(const Shader& shader)
+    {
+        std::vector<std::filesystem::file_time_type> writeTimes;
+        for (const auto& path : shader.GetSourcePaths())
+        {
+            // Editors may replace the file while saving, a missing file just reads as unchanged until it's back
+            std::error_code error;
+            writeTimes.push_back(std::filesystem::last_write_time(path, error));
+        }
+        return writeTimes;
+    }
+}
+
+void ShaderWatcher::Register(Shader* shader)
+{
+    s_Data.WriteTimes[shader] = Utils::GetWriteTimes(*shader);
+}
+
+void ShaderWatcher::Unregister(Shader* shader)
+{
+    s_Data.WriteTimes.erase(shader);
+}
+
+void ShaderWatcher::Update()
+{
+    BH_PROFILE_FUNCTION();
+
+    for (const auto& [shader, writeTimes] : s_Data.WriteTimes)
+        shader->UpdateReload();
+
+    if (s_Data.CheckTimer.Elapsed() < s_CheckInterval)
+        return;
+    s_Data.CheckTimer.Reset();
+
+    for (auto& [shader, writeTimes] : s_Data.WriteTimes)
+    {
+        std::vector<std::filesystem::file_time_type> currentWriteTimes = Utils::GetWriteTimes(*shader);
+        if (currentWriteTimes == writeTimes)
+            continue;
+
+        const bool isMissing = std::ranges::find(currentWriteTimes, std::filesystem::file_time_type::min()) != currentWriteTimes.end();
+        if (isMissing)
+            continue;
+
+        writeTimes = std::move(currentWriteTimes);
+        BH_LOG_INFO("Reloading shader '{0}'", shader->GetName());
+        shader->Reload();
+    }
+}
\ No newline at end of file
@@ -0,0 +1,16 @@
+#pragma once
+
+class Shader;
+
+// Hot reload for every live shader: sources are checked for changes every now and then, and changed shaders
+// recompile in the background while their current pipeline keeps rendering
+class ShaderWatcher
+{
+public:
+    // Called by shaders themselves on creation and destruction
+    static void Register(Shader* shader);
+    static void Unregister(Shader* shader);
+
+    // Once per frame, from whatever wants hot reload, such as the editor
+    static void Update();
+};
\ No newline at end of file
@@ -0,0 +1,56 @@
+#include "bhpch.h"
+#include "Platform/OpenGL/ShadowMap.h"
+
+#include <glad/glad.h>
+
+ShadowMap::ShadowMap(uint32_t size, uint32_t layerCount)
+    : m_Size(size), m_LayerCount(layerCount)
+{
+    glCreateTextures(GL_TEXTURE_2D_ARRAY, 1, &m_RendererID);
+    glTextureStorage3D(m_RendererID, 1, GL_DEPTH_COMPONENT32F, static_cast<int32_t>(size), static_cast<int32_t>(size), static_cast<int32_t>(layerCount));
+
+    // Linear filtering with comparison gives 2x2 PCF for free on every fetch
+    glTextureParameteri(m_RendererID, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    glTextureParameteri(m_RendererID, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glTextureParameteri(m_RendererID, GL_TEXTURE_COMPARE_MODE, GL_COMPARE_REF_TO_TEXTURE);
+    glTextureParameteri(m_RendererID, GL_TEXTURE_COMPARE_FUNC, GL_LEQUAL);
+
+    // Outside the map counts as lit
+    constexpr float borderColor[] = { 1.0f, 1.0f, 1.0f, 1.0f };
+    glTextureParameteri(m_RendererID, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_BORDER);
+    glTextureParameteri(m_RendererID, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_BORDER);
+    glTextureParameterfv(m_RendererID, GL_TEXTURE_BORDER_COLOR, borderColor);
+
+    m_LayerFramebuffers.resize(layerCount);
+    glCreateFramebuffers(static_cast<int32_t>(layerCount), m_LayerFramebuffers.data());
+    for (uint32_t layer = 0; layer < layerCount; ++layer)
+    {
+        glNamedFramebufferTextureLayer(m_LayerFramebuffers[layer], GL_DEPTH_ATTACHMENT, m_RendererID, 0, static_cast<int32_t>(layer));
+        glNamedFramebufferDrawBuffer(m_LayerFramebuffers[layer], GL_NONE);
+        glNamedFramebufferReadBuffer(m_LayerFramebuffers[layer], GL_NONE);
+
+        BH_ASSERT(glCheckNamedFramebufferStatus(m_LayerFramebuffers[layer], GL_FRAMEBUFFER) == GL_FRAMEBUFFER_COMPLETE, "Shadow map framebuffer is incomplete!");
+    }
+}
+
+ShadowMap::~ShadowMap()
+{
+    glDeleteFramebuffers(static_cast<int32_t>(m_LayerFramebuffers.size()), m_LayerFramebuffers.data());
+    glDeleteTextures(1, &m_RendererID);
+}
+
+void ShadowMap::BindLayer(uint32_t layer) const
+{
+    glBindFramebuffer(GL_FRAMEBUFFER, m_LayerFramebuffers[layer]);
+    glViewport(0, 0, static_cast<int32_t>(m_Size), static_cast<int32_t>(m_Size));
+}
+
+void ShadowMap::ClearLayer(uint32_t layer, float depth) const
+{
+    glClearNamedFramebufferfv(m_LayerFramebuffers[layer], GL_DEPTH, 0, &depth);
+}
+
+void ShadowMap::Bind(uint32_t slot) const
+{
+    glBindTextureUnit(slot, m_RendererID);
+}
\ No newline at end of file
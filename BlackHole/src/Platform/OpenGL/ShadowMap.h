@@ -0,0 +1,27 @@
+#pragma once
+
+// Depth texture array with one framebuffer per layer, sampled with hardware depth comparison
+class ShadowMap
+{
+public:
+    ShadowMap(uint32_t size, uint32_t layerCount);
+    ~ShadowMap();
+
+    ShadowMap(const ShadowMap&) = delete;
+    ShadowMap& operator=(const ShadowMap&) = delete;
+
+    // Binds the framebuffer of one layer and covers it with the viewport
+    void BindLayer(uint32_t layer) const;
+    void ClearLayer(uint32_t layer, float depth = 1.0f) const;
+
+    void Bind(uint32_t slot) const;
+
+    uint32_t GetSize() const { return m_Size; }
+    uint32_t GetLayerCount() const { return m_LayerCount; }
+private:
+    uint32_t m_RendererID = 0;
+    std::vector<uint32_t> m_LayerFramebuffers;
+
+    uint32_t m_Size;
+    uint32_t m_LayerCount;
+};
\ No newline at end of file
@@ -1,28 +1,31 @@
 #include "bhpch.h"
 #include "Platform/OpenGL/Texture.h"
 
-#include <stb_image.h>
 #include <glad/glad.h>
 #include <glm/common.hpp>
 #include <glm/exponential.hpp>
 
+#include "BlackHole/Core/VirtualFilesystem.h"
+
 // Texture2D
 
 Texture2D::Texture2D(const std::filesystem::path& texturePath)
     : m_RendererID(0)
 {
-    int width, height, channels;
-    stbi_uc* data = stbi_load(texturePath.string().c_str(), &width, &height, &channels, 0);
+    BH_PROFILE_FUNCTION();
+
+    const Image image(VirtualFilesystem::ReadFile(texturePath));
+    const uint8_t* data = image.GetPixels();
     BH_ASSERT(data, "Failed to load image!");
     
     if (data)
     {
-        m_Width = width;
-        m_Height = height;
+        m_Width = image.GetWidth();
+        m_Height = image.GetHeight();
 
         GLenum internalFormat = 0, dataFormat = 0;
 
-        switch (channels)
+        switch (image.GetChannels())
         {
         case 1:
             internalFormat = GL_R8;
@@ -59,8 +62,6 @@ Texture2D::Texture2D(const std::filesystem::path& texturePath)
 
 		glTextureParameteri(m_RendererID, GL_TEXTURE_WRAP_S, GL_REPEAT);
 		glTextureParameteri(m_RendererID, GL_TEXTURE_WRAP_T, GL_REPEAT);
-
-        stbi_image_free(data);
     }
 }
 
@@ -77,23 +78,29 @@ void Texture2D::Bind(uint32_t slot) const
 // Texture2D Array
 
 TextureArray2D::TextureArray2D(const std::filesystem::path& texturePath, uint32_t layers)
+    : TextureArray2D(Image(VirtualFilesystem::ReadFile(texturePath)), texturePath.filename().string(), layers)
+{
+}
+
+TextureArray2D::TextureArray2D(const Image& image, const std::string& key, uint32_t layers)
     : m_RendererID(0)
 {
+    BH_PROFILE_FUNCTION();
+
     m_TextureKeys.reserve(layers);
 
-    int width, height, channels;
-    stbi_uc* data = stbi_load(texturePath.string().c_str(), &width, &height, &channels, 0);
+    const uint8_t* data = image.GetPixels();
     BH_ASSERT(data, "Failed to load image!");
     
     if (data)
     {
-        m_TextureKeys.push_back(texturePath.filename().string());
+        m_TextureKeys.push_back(key);
 
-        m_Width = width;
-        m_Height = height;
+        m_Width = image.GetWidth();
+        m_Height = image.GetHeight();
 
         GLenum internalFormat = 0, dataFormat = 0;
-        switch (channels)
+        switch (image.GetChannels())
         {
         case 1:
             internalFormat = GL_R8;
@@ -130,8 +137,6 @@ TextureArray2D::TextureArray2D(const std::filesystem::path& texturePath, uint32_
 
 		glTextureParameteri(m_RendererID, GL_TEXTURE_WRAP_S, GL_REPEAT);
 		glTextureParameteri(m_RendererID, GL_TEXTURE_WRAP_T, GL_REPEAT);
-
-        stbi_image_free(data);
     }
 }
 
@@ -147,13 +152,19 @@ void TextureArray2D::Bind(uint32_t slot)
 
 void TextureArray2D::PushBack(const std::filesystem::path& texturePath)
 {
-    int width, height, channels;
-    stbi_uc* data = stbi_load(texturePath.string().c_str(), &width, &height, &channels, 0);
+    PushBack(Image(VirtualFilesystem::ReadFile(texturePath)), texturePath.filename().string());
+}
+
+void TextureArray2D::PushBack(const Image& image, const std::string& key)
+{
+    BH_PROFILE_FUNCTION();
+
+    const uint8_t* data = image.GetPixels();
     BH_ASSERT(data, "Failed to load image!");
     
     if (data)
     {
-        m_TextureKeys.push_back(texturePath.filename().string());
+        m_TextureKeys.push_back(key);
 
         glTextureSubImage3D(m_RendererID, 0, 0, 0, static_cast<int32_t>(m_TextureKeys.size() - 1), static_cast<int32_t>(m_Width), static_cast<int32_t>(m_Height), 1, m_DataFormat, GL_UNSIGNED_BYTE, data);
 
@@ -164,7 +175,5 @@ void TextureArray2D::PushBack(const std::filesystem::path& texturePath)
 
 		glTextureParameteri(m_RendererID, GL_TEXTURE_WRAP_S, GL_REPEAT);
 		glTextureParameteri(m_RendererID, GL_TEXTURE_WRAP_T, GL_REPEAT);
-
-        stbi_image_free(data);
     }
 }
\ No newline at end of file
@@ -1,4 +1,5 @@
 #pragma once
+#include "BlackHole/Renderer/Image.h"
 
 enum class TextureType
 {
@@ -25,11 +26,14 @@ class TextureArray2D
 {
 public:
     explicit TextureArray2D(const std::filesystem::path& texturePath, uint32_t layers);
+    // The key names the layer in GetTextureKeys, usually the file name
+    TextureArray2D(const Image& image, const std::string& key, uint32_t layers);
     ~TextureArray2D();
 
     void Bind(uint32_t slot = 0);
 
     void PushBack(const std::filesystem::path& texturePath);
+    void PushBack(const Image& image, const std::string& key);
 
     const std::vector<std::string>& GetTextureKeys() const { return m_TextureKeys; }
 private:
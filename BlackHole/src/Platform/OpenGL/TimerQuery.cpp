@@ -0,0 +1,56 @@
+#include "bhpch.h"
+#include "Platform/OpenGL/TimerQuery.h"
+
+#include <glad/glad.h>
+
+TimerQuery::TimerQuery(uint32_t latency)
+    : m_Slots(latency)
+{
+    for (auto& slot : m_Slots)
+    {
+        glCreateQueries(GL_TIMESTAMP, 1, &slot.BeginQuery);
+        glCreateQueries(GL_TIMESTAMP, 1, &slot.EndQuery);
+    }
+}
+
+TimerQuery::~TimerQuery()
+{
+    for (const auto& slot : m_Slots)
+    {
+        glDeleteQueries(1, &slot.BeginQuery);
+        glDeleteQueries(1, &slot.EndQuery);
+    }
+}
+
+void TimerQuery::Begin(uint64_t tag)
+{
+    QuerySlot& slot = m_Slots[m_SlotIndex];
+    if (slot.IsPending)
+    {
+        GLint isAvailable = GL_FALSE;
+        glGetQueryObjectiv(slot.EndQuery, GL_QUERY_RESULT_AVAILABLE, &isAvailable);
+
+        // If the GPU is still behind, the old result is dropped instead of waited for
+        if (isAvailable)
+        {
+            GLuint64 beginTime = 0, endTime = 0;
+            glGetQueryObjectui64v(slot.BeginQuery, GL_QUERY_RESULT, &beginTime);
+            glGetQueryObjectui64v(slot.EndQuery, GL_QUERY_RESULT, &endTime);
+            m_ElapsedMilliseconds = static_cast<float>(endTime - beginTime) * 1e-6f;
+            m_ElapsedTag = slot.Tag;
+            m_HasResult = true;
+        }
+    }
+
+    slot.Tag = tag;
+    glQueryCounter(slot.BeginQuery, GL_TIMESTAMP);
+}
+
+void TimerQuery::End()
+{
+    QuerySlot& slot = m_Slots[m_SlotIndex];
+    glQueryCounter(slot.EndQuery, GL_TIMESTAMP);
+    slot.IsPending = true;
+
+    m_SlotIndex = (m_SlotIndex + 1) % static_cast<uint32_t>(m_Slots.size());
+}
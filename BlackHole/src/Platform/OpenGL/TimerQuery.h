@@ -0,0 +1,37 @@
+#pragma once
+
+// GPU timestamp pair measuring the commands between Begin and End.
+// Queries rotate through a small ring and are read back when their slot comes up again,
+// a few frames later, so reading a result never waits for the GPU.
+class TimerQuery
+{
+public:
+    explicit TimerQuery(uint32_t latency = 3);
+    ~TimerQuery();
+
+    TimerQuery(const TimerQuery&) = delete;
+    TimerQuery& operator=(const TimerQuery&) = delete;
+
+    // The tag comes back with the result, to tell which frame it was measured in
+    void Begin(uint64_t tag = 0);
+    void End();
+
+    // Latest available result, 0 until the first query has completed
+    float GetElapsedMilliseconds() const { return m_ElapsedMilliseconds; }
+    uint64_t GetElapsedTag() const { return m_ElapsedTag; }
+    bool HasResult() const { return m_HasResult; }
+private:
+    struct QuerySlot
+    {
+        uint32_t BeginQuery = 0;
+        uint32_t EndQuery = 0;
+        uint64_t Tag = 0;
+        bool IsPending = false;
+    };
+private:
+    std::vector<QuerySlot> m_Slots;
+    uint32_t m_SlotIndex = 0;
+    float m_ElapsedMilliseconds = 0.0f;
+    uint64_t m_ElapsedTag = 0;
+    bool m_HasResult = false;
+};
@@ -0,0 +1,87 @@
+#include "bhpch.h"
+#include "Platform/OpenGL/TransientTexturePool.h"
+
+#include <glad/glad.h>
+
+static constexpr uint64_t s_MaxUnusedFrames = 8;
+
+namespace Utils
+{
+    static uint32_t CreateAttachmentTexture(const TransientTextureSpecification& spec)
+    {
+        const uint32_t internalFormat = spec.Format == AttachmentFormat::RGBA8 ? GL_RGBA8 : GL_DEPTH24_STENCIL8;
+
+        uint32_t rendererID = 0;
+        if (spec.Samples > 1)
+        {
+            glCreateTextures(GL_TEXTURE_2D_MULTISAMPLE, 1, &rendererID);
+            glTextureStorage2DMultisample(rendererID, spec.Samples, internalFormat, static_cast<int32_t>(spec.Width), static_cast<int32_t>(spec.Height), GL_TRUE);
+            return rendererID;
+        }
+
+        glCreateTextures(GL_TEXTURE_2D, 1, &rendererID);
+        glTextureStorage2D(rendererID, 1, internalFormat, static_cast<int32_t>(spec.Width), static_cast<int32_t>(spec.Height));
+
+        const int32_t filter = spec.Format == AttachmentFormat::RGBA8 ? GL_LINEAR : GL_NEAREST;
+        glTextureParameteri(rendererID, GL_TEXTURE_MIN_FILTER, filter);
+        glTextureParameteri(rendererID, GL_TEXTURE_MAG_FILTER, filter);
+        glTextureParameteri(rendererID, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+        glTextureParameteri(rendererID, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+        return rendererID;
+    }
+}
+
+TransientTexturePool::~TransientTexturePool()
+{
+    for (const auto& entry : m_Entries)
+        glDeleteTextures(1, &entry.RendererID);
+}
+
+uint32_t TransientTexturePool::Acquire(const TransientTextureSpecification& specification)
+{
+    for (auto& entry : m_Entries)
+    {
+        if (!entry.InUse && entry.Specification == specification)
+        {
+            entry.InUse = true;
+            entry.LastUsedFrame = m_FrameIndex;
+            return entry.RendererID;
+        }
+    }
+
+    m_Entries.push_back({ specification, Utils::CreateAttachmentTexture(specification), m_FrameIndex, true });
+    return m_Entries.back().RendererID;
+}
+
+void TransientTexturePool::Release(uint32_t rendererID)
+{
+    const auto it = std::ranges::find(m_Entries, rendererID, &Entry::RendererID);
+    BH_ASSERT(it != m_Entries.end() && it->InUse, "Releasing a texture the pool didn't hand out!");
+    it->InUse = false;
+}
+
+std::vector<uint32_t> TransientTexturePool::CollectGarbage()
+{
+    BH_PROFILE_FUNCTION();
+
+    std::vector<uint32_t> deleted;
+    std::erase_if(m_Entries, [this, &deleted](const Entry& entry)
+    {
+        if (entry.InUse || m_FrameIndex - entry.LastUsedFrame < s_MaxUnusedFrames)
+            return false;
+
+        glDeleteTextures(1, &entry.RendererID);
+        deleted.push_back(entry.RendererID);
+        return true;
+    });
+
+    ++m_FrameIndex;
+    return deleted;
+}
+
+const TransientTextureSpecification& TransientTexturePool::GetSpecification(uint32_t rendererID) const
+{
+    const auto it = std::ranges::find(m_Entries, rendererID, &Entry::RendererID);
+    BH_ASSERT(it != m_Entries.end(), "Unknown transient texture!");
+    return it->Specification;
+}
\ No newline at end of file
@@ -0,0 +1,48 @@
+#pragma once
+
+enum class AttachmentFormat : uint8_t
+{
+    RGBA8,
+    Depth24Stencil8
+};
+
+struct TransientTextureSpecification
+{
+    uint32_t Width = 0, Height = 0;
+    uint8_t Samples = 1;
+    AttachmentFormat Format = AttachmentFormat::RGBA8;
+
+    bool operator==(const TransientTextureSpecification&) const = default;
+};
+
+// Attachment textures handed out for part of a frame. Released textures go back to the pool
+// and are reused by the next request with the same specification, so resources with disjoint lifetimes share memory
+class TransientTexturePool
+{
+public:
+    TransientTexturePool() = default;
+    ~TransientTexturePool();
+
+    TransientTexturePool(const TransientTexturePool&) = delete;
+    TransientTexturePool& operator=(const TransientTexturePool&) = delete;
+
+    uint32_t Acquire(const TransientTextureSpecification& specification);
+    void Release(uint32_t rendererID);
+
+    // Deletes textures nobody asked for in a while, such as the old sizes after a resize, and returns their IDs
+    std::vector<uint32_t> CollectGarbage();
+
+    const TransientTextureSpecification& GetSpecification(uint32_t rendererID) const;
+    uint32_t GetTextureCount() const { return static_cast<uint32_t>(m_Entries.size()); }
+private:
+    struct Entry
+    {
+        TransientTextureSpecification Specification;
+        uint32_t RendererID;
+        uint64_t LastUsedFrame;
+        bool InUse;
+    };
+
+    std::vector<Entry> m_Entries;
+    uint64_t m_FrameIndex = 0;
+};
\ No newline at end of file
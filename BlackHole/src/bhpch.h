@@ -20,3 +20,4 @@
 
 #include "BlackHole/Core/Base.h"
 #include "BlackHole/Core/Filesystem.h"
+#include "BlackHole/Core/Profiler.h"
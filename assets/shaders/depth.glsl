@@ -0,0 +1,26 @@
+#type vertex
+#version 460 core
+
+out gl_PerVertex
+{
+	vec4 gl_Position;
+};
+invariant gl_Position;
+
+layout (location = 0) in vec3 a_Position;
+
+#include "include/matrices.glsl"
+#include "include/object.glsl"
+
+void main()
+{
+	// Must match model.vs.glsl exactly, the main pass tests against this depth with GL_EQUAL
+	gl_Position = u_Projection * u_View * u_Model * vec4(a_Position, 1.0);
+}
+
+#type fragment
+#version 460 core
+
+void main()
+{
+}
\ No newline at end of file
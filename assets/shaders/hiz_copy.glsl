@@ -0,0 +1,15 @@
+#type compute
+#version 460 core
+layout (local_size_x = 8, local_size_y = 8) in;
+
+layout (binding = 0) uniform sampler2D u_Depth;
+layout (r32f, binding = 1) writeonly uniform image2D u_Destination;
+
+void main()
+{
+	ivec2 coord = ivec2(gl_GlobalInvocationID.xy);
+	if (any(greaterThanEqual(coord, imageSize(u_Destination))))
+		return;
+
+	imageStore(u_Destination, coord, vec4(texelFetch(u_Depth, coord, 0).r));
+}
\ No newline at end of file
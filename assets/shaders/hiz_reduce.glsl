@@ -0,0 +1,39 @@
+#type compute
+#version 460 core
+layout (local_size_x = 8, local_size_y = 8) in;
+
+layout (r32f, binding = 0) readonly uniform image2D u_Source;
+layout (r32f, binding = 1) writeonly uniform image2D u_Destination;
+
+float LoadSource(ivec2 coord, ivec2 sourceSize)
+{
+	return imageLoad(u_Source, min(coord, sourceSize - 1)).r;
+}
+
+void main()
+{
+	ivec2 coord = ivec2(gl_GlobalInvocationID.xy);
+	ivec2 destinationSize = imageSize(u_Destination);
+	if (any(greaterThanEqual(coord, destinationSize)))
+		return;
+
+	ivec2 sourceSize = imageSize(u_Source);
+	ivec2 sourceCoord = coord * 2;
+
+	float depth = max(
+		max(LoadSource(sourceCoord, sourceSize), LoadSource(sourceCoord + ivec2(1, 0), sourceSize)),
+		max(LoadSource(sourceCoord + ivec2(0, 1), sourceSize), LoadSource(sourceCoord + ivec2(1, 1), sourceSize)));
+
+	// With an odd source size the last row and column also cover the texels left over by the halving
+	bool extraColumn = (sourceSize.x & 1) != 0 && coord.x == destinationSize.x - 1;
+	bool extraRow = (sourceSize.y & 1) != 0 && coord.y == destinationSize.y - 1;
+
+	if (extraColumn)
+		depth = max(depth, max(LoadSource(sourceCoord + ivec2(2, 0), sourceSize), LoadSource(sourceCoord + ivec2(2, 1), sourceSize)));
+	if (extraRow)
+		depth = max(depth, max(LoadSource(sourceCoord + ivec2(0, 2), sourceSize), LoadSource(sourceCoord + ivec2(1, 2), sourceSize)));
+	if (extraColumn && extraRow)
+		depth = max(depth, LoadSource(sourceCoord + ivec2(2, 2), sourceSize));
+
+	imageStore(u_Destination, coord, vec4(depth));
+}
\ No newline at end of file
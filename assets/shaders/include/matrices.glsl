@@ -0,0 +1,6 @@
+// Camera, bound once per frame
+layout (std140, binding = 0) uniform Matrices
+{
+	mat4 u_Projection;
+	mat4 u_View;
+};
\ No newline at end of file
@@ -0,0 +1,6 @@
+// Per submitted model
+layout (std140, binding = 1) uniform Object
+{
+	mat4 u_Model;
+	mat4 u_NormalMatrix;
+};
\ No newline at end of file
@@ -6,25 +6,31 @@ layout (location = 0) in VS_OUT
 	vec3 FragmentPosition;
 	vec3 Normal;
 	vec2 TexCoord;
+	flat uint MaterialIndex;
 } fs_in;
 
-layout (std140, binding = 0) uniform Matrices
-{
-	mat4 u_Projection;
-	mat4 u_View;
-};
+// Compiled as variants, GLSL gets the features as defines, SPIR-V as specialization constants.
+// Both are constant, so the compiler drops the branches on them
+#ifdef GL_SPIRV
+layout (constant_id = 0) const bool FEATURE_SHADOWS = true;
+layout (constant_id = 1) const bool FEATURE_LOCAL_LIGHTS = true;
+layout (constant_id = 2) const bool FEATURE_SPECULAR_MAP = true;
+#endif
+
+#include "include/matrices.glsl"
 
 struct Material
 {
-	sampler2DArray Diffuse;
 	uint DiffuseLayer;
-
-	sampler2DArray Specular;
 	uint SpecularLayer;
-
 	float Shininess;
 };
 
+layout (std140, binding = 2) readonly buffer Materials
+{
+	Material u_Materials[];
+};
+
 struct DirectionalLight
 {
 	vec3 Direction;
@@ -33,40 +39,165 @@ struct DirectionalLight
 	vec3 Specular;
 };
 
-uniform Material u_Material;
+// Point and spot lights in view space, point lights have a spot scale of zero
+struct Light
+{
+	vec4 PositionRadius;
+	vec4 ColorSpotOffset;
+	vec4 DirectionSpotScale;
+};
+
+struct ClusterRange
+{
+	uint Offset;
+	uint Count;
+};
+
+layout (std140, binding = 7) uniform LightGrid
+{
+	uvec4 u_ClusterCounts;
+	float u_SliceScale;
+	float u_SliceBias;
+};
+
+layout (std430, binding = 8) readonly buffer Lights
+{
+	Light b_Lights[];
+};
+
+layout (std430, binding = 9) readonly buffer LightClusters
+{
+	ClusterRange b_ClusterRanges[];
+};
+
+layout (std430, binding = 10) readonly buffer LightIndices
+{
+	uint b_LightIndices[];
+};
+
+layout (std140, binding = 11) uniform Shadows
+{
+	mat4 u_CascadeMatrices[4];
+	vec4 u_CascadeSplits;
+	// Cascade count (zero disables shadows), texel size, depth bias
+	vec4 u_ShadowParams;
+};
+
+layout (binding = 0) uniform sampler2DArray u_DiffuseMaps;
+layout (binding = 1) uniform sampler2DArray u_SpecularMaps;
+layout (binding = 3) uniform sampler2DArrayShadow u_ShadowMap;
+
 uniform DirectionalLight u_DirectionalLight;
-uniform samplerCube u_Skybox;
 
-vec4 BlinnPhongModel(in const vec3 normal, in const vec3 viewDir, in const vec3 lightDir)
+struct Surface
+{
+	vec3 Normal;
+	vec3 ViewDir;
+	vec4 Diffuse;
+	vec4 Specular;
+	float Shininess;
+};
+
+vec3 BlinnPhong(in const Surface surface, in const vec3 lightDir, in const vec3 diffuseLight, in const vec3 specularLight)
 {
-	vec4 fragmentColor = texture(u_Material.Diffuse, vec3(fs_in.TexCoord, u_Material.DiffuseLayer));
-	vec4 specularColor = texture(u_Material.Specular, vec3(fs_in.TexCoord, u_Material.SpecularLayer));
+	float diff = max(dot(surface.Normal, lightDir), 0.0);
+	vec3 diffuse = diff * diffuseLight * surface.Diffuse.rgb;
+
+	vec3 halfwayDirection = normalize(surface.ViewDir + lightDir);
+	float spec = pow(max(dot(surface.Normal, halfwayDirection), 0.0), surface.Shininess);
+	vec3 specular = spec * specularLight * surface.Specular.rgb;
 
-	float ambinetStrength = 0.1;
-	vec4 ambient = vec4(ambinetStrength * u_DirectionalLight.Diffuse, 1.0) * fragmentColor;
+	return diffuse + specular;
+}
 
-	float diff = max(dot(normal, lightDir), 0.0);
-	vec4 diffuse = vec4(diff * u_DirectionalLight.Diffuse, 1.0) * fragmentColor;
+vec3 LocalLight(in const Surface surface, in const Light light, in const vec3 fragmentPosition)
+{
+	vec3 toLight = light.PositionRadius.xyz - fragmentPosition;
+	float distanceSquared = dot(toLight, toLight);
+	vec3 lightDir = toLight * inversesqrt(max(distanceSquared, 0.0001));
 
-	vec3 halfwayDirection = normalize(viewDir + lightDir);
-	float spec = pow(max(dot(normal, halfwayDirection), 0.0), u_Material.Shininess);
-	vec4 specular = vec4(spec * u_DirectionalLight.Specular, 1.0) * specularColor;
-	
-	return (ambient + diffuse + specular);
+	// Inverse square falloff windowed to reach zero at the light radius
+	float ratio = distanceSquared / (light.PositionRadius.w * light.PositionRadius.w);
+	float window = clamp(1.0 - ratio * ratio, 0.0, 1.0);
+	float attenuation = window * window / (distanceSquared + 1.0);
+
+	float cone = clamp(dot(-lightDir, light.DirectionSpotScale.xyz) * light.DirectionSpotScale.w + light.ColorSpotOffset.w, 0.0, 1.0);
+	attenuation *= cone * cone;
+
+	vec3 color = light.ColorSpotOffset.rgb * attenuation;
+	return BlinnPhong(surface, lightDir, color, color);
 }
 
-void main()
+float DirectionalShadow(in const vec3 fragmentPosition, in const vec3 normal, in const vec3 lightDir)
 {
-	vec3 normal = normalize(fs_in.Normal);
-	vec3 viewDir = normalize(-fs_in.FragmentPosition);
+	uint cascadeCount = uint(u_ShadowParams.x);
+	float viewDepth = -fragmentPosition.z;
 
-	if (dot(viewDir, normal) < 0)
+	uint cascade = 0u;
+	while (cascade < cascadeCount && viewDepth > u_CascadeSplits[cascade])
+		++cascade;
+	if (cascade >= cascadeCount)
+		return 1.0;
+
+	vec3 shadowPosition = (u_CascadeMatrices[cascade] * vec4(fragmentPosition, 1.0)).xyz;
+
+	// Surfaces at grazing angles to the light need more bias to avoid acne
+	float bias = u_ShadowParams.z * (1.0 + 4.0 * (1.0 - max(dot(normal, lightDir), 0.0)));
+
+	// 3x3 taps, each already a bilinear 2x2 comparison
+	float lit = 0.0;
+	for (int y = -1; y <= 1; ++y)
 	{
-		discard;
+		for (int x = -1; x <= 1; ++x)
+		{
+			vec2 offset = vec2(x, y) * u_ShadowParams.y;
+			lit += texture(u_ShadowMap, vec4(shadowPosition.xy + offset, float(cascade), shadowPosition.z - bias));
+		}
 	}
+	return lit / 9.0;
+}
+
+uint GetClusterIndex(in const vec3 fragmentPosition)
+{
+	vec4 clipPosition = u_Projection * vec4(fragmentPosition, 1.0);
+	vec2 screenPosition = clipPosition.xy / clipPosition.w * 0.5 + 0.5;
+	uvec2 tile = uvec2(clamp(screenPosition * vec2(u_ClusterCounts.xy), vec2(0.0), vec2(u_ClusterCounts.xy - 1u)));
+
+	// Slices grow exponentially with depth, so each one has a similar depth to width ratio
+	float slice = log(max(-fragmentPosition.z, 0.0001)) * u_SliceScale - u_SliceBias;
+	uint sliceIndex = uint(clamp(slice, 0.0, float(u_ClusterCounts.z - 1u)));
 
-	vec3 directionalLightDir = -normalize(u_View * vec4(u_DirectionalLight.Direction, 1.0)).xyz;
-	vec4 outputColor = BlinnPhongModel(normal, viewDir, directionalLightDir);
+	return (sliceIndex * u_ClusterCounts.y + tile.y) * u_ClusterCounts.x + tile.x;
+}
+
+void main()
+{
+	Material material = u_Materials[fs_in.MaterialIndex];
+
+	Surface surface;
+	surface.Normal = normalize(fs_in.Normal);
+	surface.ViewDir = normalize(-fs_in.FragmentPosition);
+	surface.Diffuse = texture(u_DiffuseMaps, vec3(fs_in.TexCoord, material.DiffuseLayer));
+	if (FEATURE_SPECULAR_MAP)
+		surface.Specular = texture(u_SpecularMaps, vec3(fs_in.TexCoord, material.SpecularLayer));
+	else
+		surface.Specular = surface.Diffuse;
+	surface.Shininess = material.Shininess;
+
+	float ambientStrength = 0.1;
+	vec3 color = ambientStrength * u_DirectionalLight.Diffuse * surface.Diffuse.rgb;
+
+	vec3 directionalLightDir = -normalize(mat3(u_View) * u_DirectionalLight.Direction);
+	float shadow = FEATURE_SHADOWS ? DirectionalShadow(fs_in.FragmentPosition, surface.Normal, directionalLightDir) : 1.0;
+	color += shadow * BlinnPhong(surface, directionalLightDir, u_DirectionalLight.Diffuse, u_DirectionalLight.Specular);
+
+	// Only the lights binned into this fragment's cluster are visited
+	if (FEATURE_LOCAL_LIGHTS)
+	{
+		ClusterRange range = b_ClusterRanges[GetClusterIndex(fs_in.FragmentPosition)];
+		for (uint i = 0u; i < range.Count; ++i)
+			color += LocalLight(surface, b_Lights[b_LightIndices[range.Offset + i]], fs_in.FragmentPosition);
+	}
 
-	o_Color = outputColor;
+	o_Color = vec4(color, 1.0);
 }
\ No newline at end of file
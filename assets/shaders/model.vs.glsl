@@ -4,6 +4,7 @@ out gl_PerVertex
 {
 	vec4 gl_Position;
 };
+invariant gl_Position;
 
 layout (location = 0) in vec3 a_Position;
 layout (location = 1) in vec3 a_Normal;
@@ -14,21 +15,19 @@ layout (location = 0) out VS_OUT
 	vec3 FragmentPosition;
 	vec3 Normal;
 	vec2 TexCoord;
+	flat uint MaterialIndex;
 } vs_out;
 
-layout (std140, binding = 0) uniform Matrices
-{
-	mat4 u_Projection;
-	mat4 u_View;
-};
-
-uniform mat4 u_Model;
+#include "include/matrices.glsl"
+#include "include/object.glsl"
 
 void main()
 {
 	vs_out.FragmentPosition = vec3(u_View * u_Model * vec4(a_Position, 1.0));
-	vs_out.Normal = normalize(mat3(transpose(inverse(u_View * u_Model))) * a_Normal);
+	// The view matrix has no scale, so it can transform the precomputed world space normal matrix directly
+	vs_out.Normal = normalize(mat3(u_View) * mat3(u_NormalMatrix) * a_Normal);
 	vs_out.TexCoord = a_TexCoord;
+	vs_out.MaterialIndex = gl_BaseInstance;
 	
 	gl_Position = u_Projection * u_View * u_Model * vec4(a_Position, 1.0);
 }
\ No newline at end of file
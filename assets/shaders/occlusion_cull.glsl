@@ -0,0 +1,151 @@
+#type compute
+#version 460 core
+layout (local_size_x = 64) in;
+
+layout (std140, binding = 0) uniform Matrices
+{
+	mat4 u_Projection;
+	mat4 u_View;
+};
+
+struct DrawBounds
+{
+	vec4 Min;
+	vec4 Max;
+};
+
+struct DrawElementsIndirectCommand
+{
+	uint Count;
+	uint InstanceCount;
+	uint FirstIndex;
+	int BaseVertex;
+	uint BaseInstance;
+};
+
+layout (std430, binding = 3) readonly buffer Bounds
+{
+	DrawBounds b_Bounds[];
+};
+
+layout (std430, binding = 4) buffer Visibility
+{
+	uint b_Visibility[];
+};
+
+layout (std430, binding = 5) buffer Commands
+{
+	DrawElementsIndirectCommand b_Commands[];
+};
+
+layout (std430, binding = 6) buffer Counters
+{
+	uint b_OccludedCount;
+	uint b_FrustumCulledCount;
+	uint b_VisibleTriangleCount;
+};
+
+layout (binding = 2) uniform sampler2D u_DepthPyramid;
+
+uniform uint u_DrawCount;
+uniform uint u_Phase;
+
+bool IsInFrustum(vec4 corners[8])
+{
+	// Culled only when every corner lies outside the same clip plane
+	for (int axis = 0; axis < 3; ++axis)
+	{
+		bool allBelow = true;
+		bool allAbove = true;
+		for (int i = 0; i < 8; ++i)
+		{
+			allBelow = allBelow && corners[i][axis] < -corners[i].w;
+			allAbove = allAbove && corners[i][axis] > corners[i].w;
+		}
+		if (allBelow || allAbove)
+			return false;
+	}
+	return true;
+}
+
+bool IsOccluded(vec4 corners[8])
+{
+	vec3 ndcMin = vec3(1.0);
+	vec3 ndcMax = vec3(-1.0);
+	for (int i = 0; i < 8; ++i)
+	{
+		// Boxes crossing the near plane have no usable screen rectangle
+		if (corners[i].w <= 0.0)
+			return false;
+
+		vec3 ndc = corners[i].xyz / corners[i].w;
+		ndcMin = min(ndcMin, ndc);
+		ndcMax = max(ndcMax, ndc);
+	}
+
+	vec2 uvMin = clamp(ndcMin.xy * 0.5 + 0.5, 0.0, 1.0);
+	vec2 uvMax = clamp(ndcMax.xy * 0.5 + 0.5, 0.0, 1.0);
+	float nearestDepth = ndcMin.z * 0.5 + 0.5;
+
+	// Pick the level where the rectangle spans at most two texels per axis, four fetches then cover it
+	vec2 baseSize = vec2(textureSize(u_DepthPyramid, 0));
+	vec2 rectSize = (uvMax - uvMin) * baseSize;
+	int levelCount = textureQueryLevels(u_DepthPyramid);
+	int level = clamp(int(ceil(log2(max(max(rectSize.x, rectSize.y), 1.0)))), 0, levelCount - 1);
+
+	ivec2 levelSize = textureSize(u_DepthPyramid, level);
+	ivec2 texelMin = min(ivec2(uvMin * vec2(levelSize)), levelSize - 1);
+	ivec2 texelMax = min(ivec2(uvMax * vec2(levelSize)), levelSize - 1);
+
+	float farthestDepth = max(
+		max(texelFetch(u_DepthPyramid, texelMin, level).r, texelFetch(u_DepthPyramid, ivec2(texelMax.x, texelMin.y), level).r),
+		max(texelFetch(u_DepthPyramid, ivec2(texelMin.x, texelMax.y), level).r, texelFetch(u_DepthPyramid, texelMax, level).r));
+
+	return nearestDepth > farthestDepth;
+}
+
+void main()
+{
+	uint drawIndex = gl_GlobalInvocationID.x;
+	if (drawIndex >= u_DrawCount)
+		return;
+
+	DrawBounds bounds = b_Bounds[drawIndex];
+	mat4 viewProjection = u_Projection * u_View;
+
+	vec4 corners[8];
+	for (int i = 0; i < 8; ++i)
+	{
+		vec3 corner = vec3(
+			(i & 1) != 0 ? bounds.Max.x : bounds.Min.x,
+			(i & 2) != 0 ? bounds.Max.y : bounds.Min.y,
+			(i & 4) != 0 ? bounds.Max.z : bounds.Min.z);
+		corners[i] = viewProjection * vec4(corner, 1.0);
+	}
+
+	bool inFrustum = IsInFrustum(corners);
+	bool drawnInFirstPhase = inFrustum && b_Visibility[drawIndex] != 0u;
+
+	uint instanceCount = 0u;
+	if (u_Phase == 0u)
+	{
+		// Phase one redraws what was visible last frame, its depth seeds the pyramid
+		instanceCount = drawnInFirstPhase ? 1u : 0u;
+	}
+	else
+	{
+		// Phase two tests everything against the pyramid and only draws what phase one missed
+		bool isVisible = inFrustum && !IsOccluded(corners);
+		instanceCount = (isVisible && !drawnInFirstPhase) ? 1u : 0u;
+		b_Visibility[drawIndex] = isVisible ? 1u : 0u;
+
+		if (!inFrustum)
+			atomicAdd(b_FrustumCulledCount, 1u);
+		else if (!isVisible)
+			atomicAdd(b_OccludedCount, 1u);
+	}
+
+	b_Commands[drawIndex].InstanceCount = instanceCount;
+	if (instanceCount != 0u)
+		atomicAdd(b_VisibleTriangleCount, b_Commands[drawIndex].Count / 3u);
+}
\ No newline at end of file
@@ -0,0 +1,49 @@
+#type vertex
+#version 460 core
+out vec2 v_TexCoords;
+
+void main()
+{
+	// One triangle covering the screen, so no vertex buffer is needed
+	vec2 position = vec2((gl_VertexID << 1) & 2, gl_VertexID & 2);
+	v_TexCoords = position;
+	gl_Position = vec4(position * 2.0 - 1.0, 0.0, 1.0);
+}
+
+#type fragment
+#version 460 core
+out vec4 FragColor;
+
+in vec2 v_TexCoords;
+
+layout (binding = 0) uniform sampler2D u_Source;
+
+// Part of the source covered by its render area
+uniform vec2 u_UVScale;
+uniform float u_Sharpness;
+
+void main()
+{
+	vec2 texelSize = 1.0 / vec2(textureSize(u_Source, 0));
+
+	// Bilinear taps must stay inside the render area, the texels beyond it are left over from earlier frames
+	vec2 uvMin = 0.5 * texelSize;
+	vec2 uvMax = u_UVScale - 0.5 * texelSize;
+	vec2 uv = clamp(v_TexCoords * u_UVScale, uvMin, uvMax);
+
+	vec3 center = texture(u_Source, uv).rgb;
+	vec3 north = texture(u_Source, clamp(uv + vec2(0.0, texelSize.y), uvMin, uvMax)).rgb;
+	vec3 south = texture(u_Source, clamp(uv - vec2(0.0, texelSize.y), uvMin, uvMax)).rgb;
+	vec3 east = texture(u_Source, clamp(uv + vec2(texelSize.x, 0.0), uvMin, uvMax)).rgb;
+	vec3 west = texture(u_Source, clamp(uv - vec2(texelSize.x, 0.0), uvMin, uvMax)).rgb;
+
+	// Contrast adaptive sharpening: the closer the neighbourhood already is to black or white, the less it is sharpened,
+	// which keeps the negative lobe from ringing around edges
+	vec3 minimum = min(center, min(min(north, south), min(east, west)));
+	vec3 maximum = max(center, max(max(north, south), max(east, west)));
+	vec3 amplitude = sqrt(clamp(min(minimum, 1.0 - maximum) / max(maximum, vec3(1e-4)), 0.0, 1.0));
+	vec3 weight = -amplitude * mix(0.125, 0.2, u_Sharpness);
+
+	vec3 color = (center + (north + south + east + west) * weight) / (1.0 + 4.0 * weight);
+	FragColor = vec4(clamp(color, 0.0, 1.0), 1.0);
+}
\ No newline at end of file
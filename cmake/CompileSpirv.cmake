@@ -0,0 +1,102 @@
+# Compiles one shader of assets/shaders to optimized SPIR-V, a module per stage named <shader file>.<stage>.spv.
+# Runs in script mode, see BH_COMPILE_SPIRV in the root CMakeLists.txt:
+#   cmake -DGLSLANG=<glslangValidator> -DSPIRV_OPT=<spirv-opt> -DSOURCE=<shader> -DOUTPUT_DIR=<dir> -DWORK_DIR=<dir> -P CompileSpirv.cmake
+# Files with #type sections are split into their stages, the others get the stage from their name (.vs, .fs, .gs).
+# A stage that fails to compile only warns, the engine compiles that shader from GLSL then
+
+get_filename_component(SOURCE_NAME ${SOURCE} NAME)
+get_filename_component(SOURCE_DIR ${SOURCE} DIRECTORY)
+file(READ ${SOURCE} SOURCE_TEXT)
+file(MAKE_DIRECTORY ${OUTPUT_DIR} ${WORK_DIR})
+
+set(STAGES "")
+string(FIND "${SOURCE_TEXT}" "#type " TYPE_POS)
+if (TYPE_POS EQUAL -1)
+    if (SOURCE_NAME MATCHES "\\.vs\\.glsl$")
+        set(STAGE vert)
+    elseif (SOURCE_NAME MATCHES "\\.fs\\.glsl$")
+        set(STAGE frag)
+    elseif (SOURCE_NAME MATCHES "\\.gs\\.glsl$")
+        set(STAGE geom)
+    else()
+        message(STATUS "Skipping ${SOURCE_NAME}, its stage can't be told from the name")
+        return()
+    endif()
+    list(APPEND STAGES ${STAGE})
+    set(STAGE_SOURCE_${STAGE} "${SOURCE_TEXT}")
+else()
+    string(SUBSTRING "${SOURCE_TEXT}" ${TYPE_POS} -1 REMAINING)
+    while (NOT REMAINING STREQUAL "")
+        string(REGEX MATCH "^#type[ \t]+([a-z]+)[^\n]*\n" TYPE_LINE "${REMAINING}")
+        if (TYPE_LINE STREQUAL "")
+            message(WARNING "${SOURCE_NAME}: malformed #type line")
+            return()
+        endif()
+
+        if (CMAKE_MATCH_1 STREQUAL "vertex")
+            set(STAGE vert)
+        elseif (CMAKE_MATCH_1 STREQUAL "fragment")
+            set(STAGE frag)
+        elseif (CMAKE_MATCH_1 STREQUAL "geometry")
+            set(STAGE geom)
+        elseif (CMAKE_MATCH_1 STREQUAL "compute")
+            set(STAGE comp)
+        else()
+            message(WARNING "${SOURCE_NAME}: unknown shader type '${CMAKE_MATCH_1}'")
+            return()
+        endif()
+
+        string(LENGTH "${TYPE_LINE}" TYPE_LINE_LENGTH)
+        string(SUBSTRING "${REMAINING}" ${TYPE_LINE_LENGTH} -1 REMAINING)
+        string(FIND "${REMAINING}" "#type " NEXT_TYPE_POS)
+        if (NEXT_TYPE_POS EQUAL -1)
+            set(STAGE_SOURCE_${STAGE} "${REMAINING}")
+            set(REMAINING "")
+        else()
+            string(SUBSTRING "${REMAINING}" 0 ${NEXT_TYPE_POS} STAGE_SOURCE_${STAGE})
+            string(SUBSTRING "${REMAINING}" ${NEXT_TYPE_POS} -1 REMAINING)
+        endif()
+        list(APPEND STAGES ${STAGE})
+    endwhile()
+endif()
+
+foreach (STAGE ${STAGES})
+    set(STAGE_SOURCE "${STAGE_SOURCE_${STAGE}}")
+    set(STAGE_FILE ${WORK_DIR}/${SOURCE_NAME}.${STAGE}.glsl)
+    set(UNOPTIMIZED_FILE ${WORK_DIR}/${SOURCE_NAME}.${STAGE}.spv)
+    set(OUTPUT_FILE ${OUTPUT_DIR}/${SOURCE_NAME}.${STAGE}.spv)
+
+    # glslang only takes #include with the extension enabled, the engine's own preprocessor doesn't need it
+    if (STAGE_SOURCE MATCHES "#include")
+        string(REGEX REPLACE "(#version[^\n]*\n)" "\\1#extension GL_GOOGLE_include_directive : require\n#line 2\n" STAGE_SOURCE "${STAGE_SOURCE}")
+    endif()
+    file(WRITE ${STAGE_FILE} "${STAGE_SOURCE}")
+
+    execute_process(
+        COMMAND ${GLSLANG} -G --auto-map-locations -S ${STAGE} -I${SOURCE_DIR} -o ${UNOPTIMIZED_FILE} ${STAGE_FILE}
+        RESULT_VARIABLE RESULT
+        OUTPUT_VARIABLE LOG
+        ERROR_VARIABLE LOG
+    )
+    if (NOT RESULT EQUAL 0)
+        message(WARNING "${SOURCE_NAME} (${STAGE}) failed to compile to SPIR-V:\n${LOG}")
+        file(REMOVE ${OUTPUT_FILE})
+        continue()
+    endif()
+
+    # Names stay in, the engine finds uniforms by name
+    if (SPIRV_OPT)
+        execute_process(
+            COMMAND ${SPIRV_OPT} -O ${UNOPTIMIZED_FILE} -o ${OUTPUT_FILE}
+            RESULT_VARIABLE RESULT
+            OUTPUT_VARIABLE LOG
+            ERROR_VARIABLE LOG
+        )
+        if (NOT RESULT EQUAL 0)
+            message(WARNING "${SOURCE_NAME} (${STAGE}) failed to optimize, keeping it unoptimized:\n${LOG}")
+            configure_file(${UNOPTIMIZED_FILE} ${OUTPUT_FILE} COPYONLY)
+        endif()
+    else()
+        configure_file(${UNOPTIMIZED_FILE} ${OUTPUT_FILE} COPYONLY)
+    endif()
+endforeach()
\ No newline at end of file